@@ -0,0 +1,128 @@
+// Command irgen writes a deterministic CLP IR stream of generated log events
+// (see the corpus package) for performance testing. For example, to write ten
+// million log events from 1000 logtypes compressed with zstd:
+//
+//	go run ./cmd/irgen -o corpus.clp.zst -n 10000000 -logtypes 1000 -zstd 3
+package main
+
+import (
+	"bufio"
+	"flag"
+	"fmt"
+	"os"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+	"github.com/y-scope/clp-ffi-go/internal/corpus"
+	"github.com/y-scope/clp-ffi-go/ir"
+)
+
+// Number of log events serialized per Writer.WriteBatch call.
+const batchSize int = 4096
+
+func main() {
+	config := corpus.DefaultConfig()
+	output := flag.String("o", "corpus.clp", "path of the IR stream to write")
+	numEvents := flag.Int("n", 1000000, "number of log events")
+	encoding := flag.String("encoding", "four", "IR encoding: four or eight (bytes)")
+	zstdLevel := flag.Int("zstd", 0, "zstd compression level (0 for no compression)")
+	timeZoneId := flag.String("tz", "UTC", "time zone ID stored in the preamble")
+	flag.Int64Var(&config.Seed, "seed", config.Seed, "random seed")
+	flag.IntVar(&config.NumLogtypes, "logtypes", config.NumLogtypes, "number of logtypes")
+	flag.Float64Var(&config.LogtypeSkew, "skew", config.LogtypeSkew,
+		"Zipf exponent (> 1) of logtype frequencies (0 for uniform)")
+	flag.Float64Var(&config.VarDensity, "var-density", config.VarDensity,
+		"fraction of logtype tokens that are variables")
+	flag.IntVar(&config.IntWeight, "int-weight", config.IntWeight, "relative weight of ints")
+	flag.IntVar(&config.FloatWeight, "float-weight", config.FloatWeight,
+		"relative weight of floats")
+	flag.IntVar(&config.DictWeight, "dict-weight", config.DictWeight,
+		"relative weight of dictionary variables")
+	flag.IntVar(&config.DictCardinality, "dict-cardinality", config.DictCardinality,
+		"number of distinct dictionary variables (0 for no bound)")
+	flag.IntVar(&config.MedianLength, "median-length", config.MedianLength,
+		"median message length")
+	flag.Float64Var(&config.LengthSigma, "length-sigma", config.LengthSigma,
+		"shape of the log-normal message length distribution")
+	flag.IntVar(&config.MinLength, "min-length", config.MinLength, "minimum message length")
+	flag.IntVar(&config.MaxLength, "max-length", config.MaxLength, "maximum message length")
+	start := flag.Int64("start", int64(config.Start), "timestamp of the first log event (ms)")
+	interval := flag.Int64("interval", int64(config.Interval), "ms between log events")
+	jitter := flag.Int64("jitter", int64(config.Jitter), "maximum timestamp jitter (ms)")
+	flag.Parse()
+	config.Start = ffi.EpochTimeMs(*start)
+	config.Interval = ffi.EpochTimeMs(*interval)
+	config.Jitter = ffi.EpochTimeMs(*jitter)
+
+	if err := run(config, *output, *numEvents, *encoding, *zstdLevel, *timeZoneId); nil != err {
+		fmt.Fprintf(os.Stderr, "irgen: %v\n", err)
+		os.Exit(1)
+	}
+}
+
+func run(
+	config corpus.Config,
+	output string,
+	numEvents int,
+	encoding string,
+	zstdLevel int,
+	timeZoneId string,
+) error {
+	gen, err := corpus.NewGenerator(config)
+	if nil != err {
+		return err
+	}
+	// The first log event's timestamp is the reference timestamp, rather than
+	// the current time, so the stream only depends on the arguments.
+	var writer *ir.Writer
+	switch encoding {
+	case "four":
+		writer, err = ir.NewWriterSizeTimestamp[ir.FourByteEncoding](
+			1024*1024,
+			timeZoneId,
+			config.Start,
+		)
+	case "eight":
+		writer, err = ir.NewWriterSizeTimestamp[ir.EightByteEncoding](
+			1024*1024,
+			timeZoneId,
+			config.Start,
+		)
+	default:
+		err = fmt.Errorf("invalid encoding: %v", encoding)
+	}
+	if nil != err {
+		return err
+	}
+	if 0 != zstdLevel {
+		if err = writer.EnableZstd(zstdLevel, 0); nil != err {
+			writer.Close()
+			return err
+		}
+	}
+
+	file, err := os.Create(output)
+	if nil != err {
+		writer.Close()
+		return err
+	}
+	defer file.Close()
+	out := bufio.NewWriter(file)
+	for written := 0; written < numEvents; written += batchSize {
+		events := gen.Generate(min(batchSize, numEvents-written))
+		if _, err = writer.WriteBatch(events); nil != err {
+			writer.Close()
+			return err
+		}
+		if _, err = writer.WriteTo(out); nil != err {
+			writer.Close()
+			return err
+		}
+	}
+	if _, err = writer.CloseTo(out); nil != err {
+		return err
+	}
+	if err = out.Flush(); nil != err {
+		return err
+	}
+	return file.Close()
+}
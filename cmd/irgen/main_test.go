@@ -0,0 +1,53 @@
+package main
+
+import (
+	"bytes"
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/y-scope/clp-ffi-go/internal/corpus"
+)
+
+func TestRunDeterministic(t *testing.T) {
+	config := corpus.DefaultConfig()
+	for _, encoding := range []string{"four", "eight"} {
+		encoding := encoding // capture range variable for func literal
+		for _, zstdLevel := range []int{0, 3} {
+			zstdLevel := zstdLevel // capture range variable for func literal
+			name := fmt.Sprintf("%v-zstd%v", encoding, zstdLevel)
+			t.Run(name, func(t *testing.T) {
+				t.Parallel()
+				first := runToBytes(t, config, encoding, zstdLevel, "first")
+				second := runToBytes(t, config, encoding, zstdLevel, "second")
+				if !bytes.Equal(first, second) {
+					t.Fatalf("run with the same config wrote different IR")
+				}
+				other := config
+				other.Seed++
+				if bytes.Equal(first, runToBytes(t, other, encoding, zstdLevel, "other")) {
+					t.Fatalf("run with different seeds wrote the same IR")
+				}
+			})
+		}
+	}
+}
+
+func runToBytes(
+	t *testing.T,
+	config corpus.Config,
+	encoding string,
+	zstdLevel int,
+	name string,
+) []byte {
+	path := filepath.Join(t.TempDir(), name+".clp")
+	if err := run(config, path, 10000, encoding, zstdLevel, "UTC"); nil != err {
+		t.Fatalf("run failed: %v", err)
+	}
+	buf, err := os.ReadFile(path)
+	if nil != err {
+		t.Fatalf("os.ReadFile failed: %v", err)
+	}
+	return buf
+}
@@ -0,0 +1,1488 @@
+// Benchmarks of every ir_* entry point of the C API that encodes, serializes,
+// deserializes, searches, or (de)compresses log events, and of the search
+// engine, run over a synthetic and a realistic corpus of log events. Besides
+// the timing, each benchmark reports events/s, bytes/s, and the number of heap
+// allocations made per iteration (counted by replacing the global operator
+// new).
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "ffi_go/defs.h"
+#include "ffi_go/ir/decoder.h"
+#include "ffi_go/ir/deserializer.h"
+#include "ffi_go/ir/encoder.h"
+#include "ffi_go/ir/serializer.h"
+#include "ffi_go/ir/zstd_compressor.h"
+#include "ffi_go/ir/zstd_decompressor.h"
+#include "ffi_go/search/numeric_query.h"
+#include "ffi_go/search/search_engine.h"
+#include "ffi_go/search/wildcard_query.h"
+
+namespace {
+std::atomic<int64_t> g_num_allocs{0};
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc,misc-new-delete-overloads)
+auto operator new(size_t size) -> void* {
+    g_num_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr{std::malloc(0 == size ? 1 : size)}; nullptr != ptr) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, size_t /*size*/) noexcept -> void {
+    std::free(ptr);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc,misc-new-delete-overloads)
+
+namespace {
+constexpr size_t cCorpusSize{4096};
+constexpr size_t cMaxQueries{64};
+constexpr size_t cBatchSize{256};
+constexpr epoch_time_ms_t cReferenceTimestamp{1'704'067'200'000};
+constexpr int8_t cFourByteEncoding{1};
+constexpr size_t cZstdFrameSize{64 * 1024};
+
+/**
+ * A set of log events that every benchmark runs over. m_messages holds the log
+ * messages back to back, with m_end_offsets marking the end of each.
+ */
+struct Corpus {
+    std::string m_name;
+    std::string m_messages;
+    std::vector<size_t> m_end_offsets;
+    std::vector<epoch_time_ms_t> m_timestamps;
+    std::vector<epoch_time_ms_t> m_timestamp_deltas;
+
+    auto add(std::string_view msg, epoch_time_ms_t timestamp) -> void;
+
+    [[nodiscard]] auto size() const -> size_t { return m_end_offsets.size(); }
+
+    [[nodiscard]] auto message(size_t i) const -> StringView {
+        size_t const begin{0 == i ? 0 : m_end_offsets[i - 1]};
+        return {m_messages.data() + begin, m_end_offsets[i] - begin};
+    }
+};
+
+/**
+ * An encoded log message copied out of an ir::Encoder.
+ */
+template <typename encoded_var_t>
+struct EncodedMessage {
+    std::string m_logtype;
+    std::vector<encoded_var_t> m_vars;
+    std::string m_dict_vars;
+    std::vector<int32_t> m_dict_var_end_offsets;
+};
+
+/**
+ * Wildcard queries cleaned by wildcard_query_new and merged into a
+ * MergedWildcardQueryView.
+ */
+class Queries {
+public:
+    explicit Queries(size_t num_queries);
+    Queries(Queries const&) = delete;
+    Queries(Queries&&) = delete;
+    auto operator=(Queries const&) -> Queries& = delete;
+    auto operator=(Queries&&) -> Queries& = delete;
+    ~Queries();
+
+    [[nodiscard]] auto view() -> MergedWildcardQueryView {
+        return {{m_queries.data(), m_queries.size()},
+                {m_end_offsets.data(), m_end_offsets.size()},
+                {m_case_sensitivity.data(), m_end_offsets.size()}};
+    }
+
+private:
+    std::string m_queries;
+    std::vector<size_t> m_end_offsets;
+    std::array<bool, cMaxQueries> m_case_sensitivity{};
+    std::vector<void*> m_cleaned;
+};
+
+/**
+ * @param seed
+ * @return A corpus of log messages with a uniform mix of static text, integer,
+ *     float, and dictionary variables
+ */
+[[nodiscard]] auto make_synthetic_corpus(uint64_t seed) -> Corpus;
+
+/**
+ * @param seed
+ * @return A corpus of log messages resembling those of common distributed
+ *     systems
+ */
+[[nodiscard]] auto make_realistic_corpus(uint64_t seed) -> Corpus;
+
+/**
+ * @param preamble Returns a view of the IR stream's preamble
+ * @return Address of a new ir::Serializer, or nullptr on failure
+ */
+template <typename encoded_var_t>
+[[nodiscard]] auto new_serializer(ByteSpan& preamble) -> void*;
+
+/**
+ * Serialize the corpus into a complete IR stream (preamble, log events, and
+ * end of stream tag).
+ * @param corpus
+ * @return The IR stream
+ */
+template <typename encoded_var_t>
+[[nodiscard]] auto serialize_corpus(Corpus const& corpus) -> std::vector<int8_t>;
+
+/**
+ * @param ir_buf
+ * @param ir_pos Returns the position after the preamble
+ * @return Address of a new ir::Deserializer for ir_buf, or nullptr on failure
+ */
+[[nodiscard]] auto new_deserializer(std::vector<int8_t>& ir_buf, size_t& ir_pos) -> void*;
+
+/**
+ * Compress an IR stream with an ir::ZstdCompressor.
+ * @param ir_buf
+ * @param compression_level
+ * @return The zstd compressed IR stream, or an empty vector on failure
+ */
+[[nodiscard]] auto compress_ir(std::vector<int8_t> const& ir_buf, int compression_level)
+        -> std::vector<char>;
+
+/**
+ * Set the counters common to every benchmark once its iterations are done.
+ * @param state
+ * @param corpus
+ * @param num_allocs Number of allocations at the start of the iterations
+ */
+auto set_corpus_counters(benchmark::State& state, Corpus const& corpus, int64_t num_allocs)
+        -> void;
+
+template <typename encoded_var_t>
+auto bench_encode(benchmark::State& state, Corpus const& corpus) -> void;
+
+template <typename encoded_var_t>
+auto bench_decode(benchmark::State& state, Corpus const& corpus) -> void;
+
+template <typename encoded_var_t>
+auto bench_serialize(benchmark::State& state, Corpus const& corpus) -> void;
+
+template <typename encoded_var_t>
+auto bench_serialize_batch(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark appending each log event to the buffered IR of a serializer using
+ * ir_serializer_append_*_log_event.
+ */
+template <typename encoded_var_t>
+auto bench_serialize_append(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark appending the corpus to the buffered IR of a serializer using
+ * ir_serializer_append_*_log_events_batch.
+ */
+template <typename encoded_var_t>
+auto bench_serialize_append_batch(benchmark::State& state, Corpus const& corpus) -> void;
+
+template <typename encoded_var_t>
+auto bench_deserialize(benchmark::State& state, Corpus const& corpus) -> void;
+
+template <typename encoded_var_t>
+auto bench_deserialize_batch(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark deserializing the IR stream split into state.range(0) chunks using
+ * ir_deserializer_deserialize_*_log_events_parallel.
+ */
+template <typename encoded_var_t>
+auto bench_deserialize_parallel(benchmark::State& state, Corpus const& corpus) -> void;
+
+template <typename encoded_var_t>
+auto bench_deserialize_columns(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark compressing the IR stream at zstd level state.range(0) using
+ * ir_zstd_compressor_*.
+ */
+template <typename encoded_var_t>
+auto bench_zstd_compress(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark decompressing the IR stream using ir_zstd_decompressor_*.
+ */
+template <typename encoded_var_t>
+auto bench_zstd_decompress(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark searching the IR stream with state.range(0) queries using
+ * ir_deserializer_deserialize_*_wildcard_match.
+ */
+template <typename encoded_var_t>
+auto bench_wildcard_match(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark searching the IR stream with state.range(0) queries using
+ * ir_deserializer_deserialize_*_compiled_query_match.
+ */
+template <typename encoded_var_t>
+auto bench_compiled_query_match(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark searching the IR stream for the log events whose memory usage
+ * (realistic corpus) exceeds a threshold using
+ * ir_deserializer_deserialize_*_numeric_query_match.
+ */
+template <typename encoded_var_t>
+auto bench_numeric_query_match(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark counting the log events matching each of state.range(0) queries
+ * per minute using ir_deserializer_*_count_matches.
+ */
+template <typename encoded_var_t>
+auto bench_count_matches(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Benchmark searching state.range(1) copies of the IR stream with
+ * state.range(0) queries using a search::SearchEngine with state.range(1)
+ * threads.
+ */
+template <typename encoded_var_t>
+auto bench_search_engine(benchmark::State& state, Corpus const& corpus) -> void;
+
+/**
+ * Register every benchmark for the encoding over the corpus.
+ */
+template <typename encoded_var_t>
+auto register_benchmarks(Corpus const& corpus) -> void;
+
+auto Corpus::add(std::string_view msg, epoch_time_ms_t timestamp) -> void {
+    m_messages.append(msg);
+    m_end_offsets.push_back(m_messages.size());
+    m_timestamp_deltas.push_back(
+            timestamp - (m_timestamps.empty() ? cReferenceTimestamp : m_timestamps.back())
+    );
+    m_timestamps.push_back(timestamp);
+}
+
+Queries::Queries(size_t num_queries) {
+    constexpr std::array<std::string_view, 8> cPatterns{
+            "*Receiving block blk_*",
+            "*Exit code is 1?,*",
+            "*took 9*ms*",
+            "*BlockManager*failed*",
+            "*attempt_*_m_*_0 9?%*",
+            "*not in the corpus*",
+            "*TID 4*",
+            "*status=5*",
+    };
+    for (size_t i{0}; i < num_queries && i < cMaxQueries; ++i) {
+        auto const pattern{cPatterns.at(i % cPatterns.size())};
+        void* cleaned{nullptr};
+        auto const query{wildcard_query_new({pattern.data(), pattern.size()}, &cleaned)};
+        m_cleaned.push_back(cleaned);
+        m_queries.append(query.m_data, query.m_size);
+        m_end_offsets.push_back(m_queries.size());
+        m_case_sensitivity.at(i) = 0 == i % 2;
+    }
+}
+
+Queries::~Queries() {
+    for (auto* cleaned : m_cleaned) {
+        wildcard_query_delete(cleaned);
+    }
+}
+
+auto make_synthetic_corpus(uint64_t seed) -> Corpus {
+    std::mt19937_64 rng{seed};
+    std::uniform_real_distribution<double> real{0.0, 1.0};
+    Corpus corpus;
+    corpus.m_name = "Synthetic";
+    std::string msg;
+    for (size_t i{0}; i < cCorpusSize; ++i) {
+        msg = "static text";
+        for (size_t j{0}; j < 8; ++j) {
+            switch (rng() % 4) {
+                case 0:
+                    msg += " int=" + std::to_string(rng() >> 1);
+                    break;
+                case 1:
+                    msg += " float=" + std::to_string(real(rng));
+                    break;
+                case 2:
+                    msg += " dict=var_" + std::to_string(rng() % UINT32_MAX);
+                    break;
+                default:
+                    msg += " more static text";
+                    break;
+            }
+        }
+        corpus.add(msg, cReferenceTimestamp + static_cast<epoch_time_ms_t>(i));
+    }
+    return corpus;
+}
+
+auto make_realistic_corpus(uint64_t seed) -> Corpus {
+    constexpr std::array<std::string_view, 6> cTemplates{
+            "INFO hdfs.server.datanode.DataNode: Receiving block blk_% src: /%:% dest: /%:%",
+            "INFO mapred.TaskTracker: attempt_%_m_%_0 % reduce > copy (% of % at % MB/s)",
+            "WARN spark.storage.BlockManager: Putting block rdd_%_% failed due to exception %",
+            "ERROR container_%: Container killed on request. Exit code is %, memory used % GB",
+            "DEBUG c.y.s.HttpServer: GET /api/v1/jobs/%/tasks?limit=% took %ms status=% user=%",
+            "INFO Executor: Finished task %.0 in stage %.0 (TID %). % bytes result sent to driver",
+    };
+    std::mt19937_64 rng{seed};
+    std::uniform_real_distribution<double> real{0.0, 1000.0};
+    auto const value{[&]() -> std::string {
+        switch (rng() % 5) {
+            case 0:
+                return std::to_string(rng() % (1ULL << 40));
+            case 1:
+                return "10." + std::to_string(rng() % 256) + "." + std::to_string(rng() % 256)
+                       + "." + std::to_string(rng() % 256);
+            case 2:
+                return std::to_string(real(rng));
+            case 3:
+                return "job_" + std::to_string(rng() % UINT32_MAX);
+            default:
+                return std::to_string(rng() % 100);
+        }
+    }};
+    Corpus corpus;
+    corpus.m_name = "Realistic";
+    std::string msg;
+    for (size_t i{0}; i < cCorpusSize; ++i) {
+        msg.clear();
+        for (auto const c : cTemplates.at(rng() % cTemplates.size())) {
+            if ('%' == c) {
+                msg += value();
+            } else {
+                msg += c;
+            }
+        }
+        corpus.add(msg, cReferenceTimestamp + static_cast<epoch_time_ms_t>(i));
+    }
+    return corpus;
+}
+
+template <typename encoded_var_t>
+auto new_serializer(ByteSpan& preamble) -> void* {
+    void* serializer{nullptr};
+    StringView const empty{"", 0};
+    StringView const time_zone_id{"UTC", 3};
+    int err{0};
+    if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+        err = ir_serializer_new_eight_byte_serializer_with_preamble(
+                empty,
+                empty,
+                time_zone_id,
+                &serializer,
+                &preamble
+        );
+    } else {
+        err = ir_serializer_new_four_byte_serializer_with_preamble(
+                empty,
+                empty,
+                time_zone_id,
+                cReferenceTimestamp,
+                &serializer,
+                &preamble
+        );
+    }
+    return 0 == err ? serializer : nullptr;
+}
+
+template <typename encoded_var_t>
+auto serialize_corpus(Corpus const& corpus) -> std::vector<int8_t> {
+    ByteSpan ir_view{};
+    void* serializer{new_serializer<encoded_var_t>(ir_view)};
+    std::vector<int8_t> ir_buf;
+    if (nullptr == serializer) {
+        return ir_buf;
+    }
+    auto const append{[&]() {
+        auto const* data{static_cast<int8_t const*>(ir_view.m_data)};
+        ir_buf.insert(ir_buf.cend(), data, data + ir_view.m_size);
+    }};
+    append();
+    StringView const messages{corpus.m_messages.data(), corpus.m_messages.size()};
+    // The end offsets and timestamps are only read despite the non-const spans.
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+    SizetSpan const end_offsets{const_cast<size_t*>(corpus.m_end_offsets.data()), corpus.size()};
+    int err{0};
+    if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+        err = ir_serializer_serialize_eight_byte_log_events_batch(
+                messages,
+                end_offsets,
+                {const_cast<int64_t*>(corpus.m_timestamps.data()), corpus.size()},
+                serializer,
+                &ir_view
+        );
+    } else {
+        err = ir_serializer_serialize_four_byte_log_events_batch(
+                messages,
+                end_offsets,
+                {const_cast<int64_t*>(corpus.m_timestamp_deltas.data()), corpus.size()},
+                serializer,
+                &ir_view
+        );
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+    ir_serializer_close(serializer);
+    if (0 != err) {
+        ir_buf.clear();
+        return ir_buf;
+    }
+    append();
+    // End of stream tag
+    ir_buf.push_back(0);
+    return ir_buf;
+}
+
+auto new_deserializer(std::vector<int8_t>& ir_buf, size_t& ir_pos) -> void* {
+    int8_t ir_encoding{0};
+    int8_t metadata_type{0};
+    size_t metadata_pos{0};
+    uint16_t metadata_size{0};
+    void* deserializer{nullptr};
+    void* timestamp{nullptr};
+    if (0
+        != ir_deserializer_new_deserializer_with_preamble(
+                {ir_buf.data(), ir_buf.size()},
+                &ir_pos,
+                &ir_encoding,
+                &metadata_type,
+                &metadata_pos,
+                &metadata_size,
+                &deserializer,
+                &timestamp
+        ))
+    {
+        return nullptr;
+    }
+    // Normally the Go layer sets the reference timestamp from the metadata.
+    if (cFourByteEncoding == ir_encoding) {
+        *static_cast<epoch_time_ms_t*>(timestamp) = cReferenceTimestamp;
+    }
+    return deserializer;
+}
+
+auto compress_ir(std::vector<int8_t> const& ir_buf, int compression_level) -> std::vector<char> {
+    void* compressor{ir_zstd_compressor_new(compression_level, cZstdFrameSize)};
+    std::vector<char> compressed;
+    auto const append{[&](ByteSpan frames) {
+        auto const* data{static_cast<char const*>(frames.m_data)};
+        compressed.insert(compressed.cend(), data, data + frames.m_size);
+    }};
+    ByteSpan frames{};
+    // The IR is only read despite the non-const span.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ByteSpan const ir_view{const_cast<int8_t*>(ir_buf.data()), ir_buf.size()};
+    if (0 != ir_zstd_compressor_write(compressor, ir_view, &frames)) {
+        ir_zstd_compressor_close(compressor);
+        return {};
+    }
+    append(frames);
+    if (0 != ir_zstd_compressor_finish(compressor, &frames)) {
+        ir_zstd_compressor_close(compressor);
+        return {};
+    }
+    append(frames);
+    ir_zstd_compressor_close(compressor);
+    return compressed;
+}
+
+auto set_corpus_counters(benchmark::State& state, Corpus const& corpus, int64_t num_allocs)
+        -> void {
+    auto const iterations{static_cast<double>(state.iterations())};
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(corpus.m_messages.size()));
+    state.counters["events/s"] = benchmark::Counter(
+            iterations * static_cast<double>(corpus.size()),
+            benchmark::Counter::kIsRate
+    );
+    state.counters["allocs/iter"] = benchmark::Counter(
+            static_cast<double>(g_num_allocs.load(std::memory_order_relaxed) - num_allocs),
+            benchmark::Counter::kAvgIterations
+    );
+}
+
+template <typename encoded_var_t>
+auto bench_encode(benchmark::State& state, Corpus const& corpus) -> void {
+    void* encoder{nullptr};
+    if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+        encoder = ir_encoder_eight_byte_new();
+    } else {
+        encoder = ir_encoder_four_byte_new();
+    }
+    StringView logtype{};
+    std::conditional_t<std::is_same_v<int64_t, encoded_var_t>, Int64tSpan, Int32tSpan> vars{};
+    StringView dict_vars{};
+    Int32tSpan dict_var_end_offsets{};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i{0}; i < corpus.size(); ++i) {
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_encoder_encode_eight_byte_log_message(
+                        corpus.message(i),
+                        encoder,
+                        &logtype,
+                        &vars,
+                        &dict_vars,
+                        &dict_var_end_offsets
+                );
+            } else {
+                err = ir_encoder_encode_four_byte_log_message(
+                        corpus.message(i),
+                        encoder,
+                        &logtype,
+                        &vars,
+                        &dict_vars,
+                        &dict_var_end_offsets
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_encoder_encode_*_log_message failed");
+                break;
+            }
+            benchmark::DoNotOptimize(logtype);
+        }
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+        ir_encoder_eight_byte_close(encoder);
+    } else {
+        ir_encoder_four_byte_close(encoder);
+    }
+}
+
+template <typename encoded_var_t>
+auto bench_decode(benchmark::State& state, Corpus const& corpus) -> void {
+    constexpr bool cIsEightByte{std::is_same_v<int64_t, encoded_var_t>};
+    using encoded_var_span_t = std::conditional_t<cIsEightByte, Int64tSpan, Int32tSpan>;
+    void* encoder{nullptr};
+    if constexpr (cIsEightByte) {
+        encoder = ir_encoder_eight_byte_new();
+    } else {
+        encoder = ir_encoder_four_byte_new();
+    }
+    std::vector<EncodedMessage<encoded_var_t>> encoded(corpus.size());
+    for (size_t i{0}; i < corpus.size(); ++i) {
+        StringView logtype{};
+        encoded_var_span_t vars{};
+        StringView dict_vars{};
+        Int32tSpan dict_var_end_offsets{};
+        int err{0};
+        if constexpr (cIsEightByte) {
+            err = ir_encoder_encode_eight_byte_log_message(
+                    corpus.message(i),
+                    encoder,
+                    &logtype,
+                    &vars,
+                    &dict_vars,
+                    &dict_var_end_offsets
+            );
+        } else {
+            err = ir_encoder_encode_four_byte_log_message(
+                    corpus.message(i),
+                    encoder,
+                    &logtype,
+                    &vars,
+                    &dict_vars,
+                    &dict_var_end_offsets
+            );
+        }
+        if (0 != err) {
+            state.SkipWithError("ir_encoder_encode_*_log_message failed");
+            break;
+        }
+        auto& msg{encoded[i]};
+        msg.m_logtype.assign(logtype.m_data, logtype.m_size);
+        msg.m_vars.assign(vars.m_data, vars.m_data + vars.m_size);
+        msg.m_dict_vars.assign(dict_vars.m_data, dict_vars.m_size);
+        msg.m_dict_var_end_offsets.assign(
+                dict_var_end_offsets.m_data,
+                dict_var_end_offsets.m_data + dict_var_end_offsets.m_size
+        );
+    }
+    if constexpr (cIsEightByte) {
+        ir_encoder_eight_byte_close(encoder);
+    } else {
+        ir_encoder_four_byte_close(encoder);
+    }
+
+    void* decoder{ir_decoder_new()};
+    StringView log_message{};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (auto& msg : encoded) {
+            StringView const logtype{msg.m_logtype.data(), msg.m_logtype.size()};
+            encoded_var_span_t const vars{msg.m_vars.data(), msg.m_vars.size()};
+            StringView const dict_vars{msg.m_dict_vars.data(), msg.m_dict_vars.size()};
+            Int32tSpan const dict_var_end_offsets{
+                    msg.m_dict_var_end_offsets.data(),
+                    msg.m_dict_var_end_offsets.size()
+            };
+            int err{0};
+            if constexpr (cIsEightByte) {
+                err = ir_decoder_decode_eight_byte_log_message(
+                        logtype,
+                        vars,
+                        dict_vars,
+                        dict_var_end_offsets,
+                        decoder,
+                        &log_message
+                );
+            } else {
+                err = ir_decoder_decode_four_byte_log_message(
+                        logtype,
+                        vars,
+                        dict_vars,
+                        dict_var_end_offsets,
+                        decoder,
+                        &log_message
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_decoder_decode_*_log_message failed");
+                break;
+            }
+            benchmark::DoNotOptimize(log_message);
+        }
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    ir_decoder_close(decoder);
+}
+
+template <typename encoded_var_t>
+auto bench_serialize(benchmark::State& state, Corpus const& corpus) -> void {
+    ByteSpan ir_view{};
+    void* serializer{new_serializer<encoded_var_t>(ir_view)};
+    if (nullptr == serializer) {
+        state.SkipWithError("ir_serializer_new_*_serializer_with_preamble failed");
+        return;
+    }
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i{0}; i < corpus.size(); ++i) {
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_serializer_serialize_eight_byte_log_event(
+                        corpus.message(i),
+                        corpus.m_timestamps[i],
+                        serializer,
+                        &ir_view
+                );
+            } else {
+                err = ir_serializer_serialize_four_byte_log_event(
+                        corpus.message(i),
+                        corpus.m_timestamp_deltas[i],
+                        serializer,
+                        &ir_view
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_serializer_serialize_*_log_event failed");
+                break;
+            }
+            benchmark::DoNotOptimize(ir_view);
+        }
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    ir_serializer_close(serializer);
+}
+
+template <typename encoded_var_t>
+auto bench_serialize_batch(benchmark::State& state, Corpus const& corpus) -> void {
+    ByteSpan ir_view{};
+    void* serializer{new_serializer<encoded_var_t>(ir_view)};
+    if (nullptr == serializer) {
+        state.SkipWithError("ir_serializer_new_*_serializer_with_preamble failed");
+        return;
+    }
+    StringView const messages{corpus.m_messages.data(), corpus.m_messages.size()};
+    // The end offsets and timestamps are only read despite the non-const spans.
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+    SizetSpan const end_offsets{const_cast<size_t*>(corpus.m_end_offsets.data()), corpus.size()};
+    Int64tSpan const timestamps{const_cast<int64_t*>(corpus.m_timestamps.data()), corpus.size()};
+    Int64tSpan const timestamp_deltas{
+            const_cast<int64_t*>(corpus.m_timestamp_deltas.data()),
+            corpus.size()
+    };
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        int err{0};
+        if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+            err = ir_serializer_serialize_eight_byte_log_events_batch(
+                    messages,
+                    end_offsets,
+                    timestamps,
+                    serializer,
+                    &ir_view
+            );
+        } else {
+            err = ir_serializer_serialize_four_byte_log_events_batch(
+                    messages,
+                    end_offsets,
+                    timestamp_deltas,
+                    serializer,
+                    &ir_view
+            );
+        }
+        if (0 != err) {
+            state.SkipWithError("ir_serializer_serialize_*_log_events_batch failed");
+            break;
+        }
+        benchmark::DoNotOptimize(ir_view);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    ir_serializer_close(serializer);
+}
+
+template <typename encoded_var_t>
+auto bench_serialize_append(benchmark::State& state, Corpus const& corpus) -> void {
+    ByteSpan ir_view{};
+    void* serializer{new_serializer<encoded_var_t>(ir_view)};
+    if (nullptr == serializer) {
+        state.SkipWithError("ir_serializer_new_*_serializer_with_preamble failed");
+        return;
+    }
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i{0}; i < corpus.size(); ++i) {
+            size_t buffered_size{0};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_serializer_append_eight_byte_log_event(
+                        corpus.message(i),
+                        corpus.m_timestamps[i],
+                        serializer,
+                        &buffered_size
+                );
+            } else {
+                err = ir_serializer_append_four_byte_log_event(
+                        corpus.message(i),
+                        corpus.m_timestamp_deltas[i],
+                        serializer,
+                        &buffered_size
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_serializer_append_*_log_event failed");
+                break;
+            }
+        }
+        ir_serializer_get_buffered_ir(serializer, &ir_view);
+        benchmark::DoNotOptimize(ir_view);
+        ir_serializer_clear_buffered_ir(serializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    ir_serializer_close(serializer);
+}
+
+template <typename encoded_var_t>
+auto bench_serialize_append_batch(benchmark::State& state, Corpus const& corpus) -> void {
+    ByteSpan ir_view{};
+    void* serializer{new_serializer<encoded_var_t>(ir_view)};
+    if (nullptr == serializer) {
+        state.SkipWithError("ir_serializer_new_*_serializer_with_preamble failed");
+        return;
+    }
+    StringView const messages{corpus.m_messages.data(), corpus.m_messages.size()};
+    // The end offsets and timestamps are only read despite the non-const spans.
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+    SizetSpan const end_offsets{const_cast<size_t*>(corpus.m_end_offsets.data()), corpus.size()};
+    Int64tSpan const timestamps{const_cast<int64_t*>(corpus.m_timestamps.data()), corpus.size()};
+    Int64tSpan const timestamp_deltas{
+            const_cast<int64_t*>(corpus.m_timestamp_deltas.data()),
+            corpus.size()
+    };
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t buffered_size{0};
+        int err{0};
+        if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+            err = ir_serializer_append_eight_byte_log_events_batch(
+                    messages,
+                    end_offsets,
+                    timestamps,
+                    serializer,
+                    &buffered_size
+            );
+        } else {
+            err = ir_serializer_append_four_byte_log_events_batch(
+                    messages,
+                    end_offsets,
+                    timestamp_deltas,
+                    serializer,
+                    &buffered_size
+            );
+        }
+        if (0 != err) {
+            state.SkipWithError("ir_serializer_append_*_log_events_batch failed");
+            break;
+        }
+        ir_serializer_get_buffered_ir(serializer, &ir_view);
+        benchmark::DoNotOptimize(ir_view);
+        ir_serializer_clear_buffered_ir(serializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    ir_serializer_close(serializer);
+}
+
+template <typename encoded_var_t>
+auto bench_deserialize(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    ByteSpan const ir_view{ir_buf.data(), ir_buf.size()};
+    LogEventView log_event{};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        for (size_t i{0}; i < corpus.size(); ++i) {
+            size_t pos{0};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_deserializer_deserialize_eight_byte_log_event(
+                        {ir_buf.data() + ir_pos, ir_view.m_size - ir_pos},
+                        deserializer,
+                        &pos,
+                        &log_event
+                );
+            } else {
+                err = ir_deserializer_deserialize_four_byte_log_event(
+                        {ir_buf.data() + ir_pos, ir_view.m_size - ir_pos},
+                        deserializer,
+                        &pos,
+                        &log_event
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_deserializer_deserialize_*_log_event failed");
+                break;
+            }
+            ir_pos += pos;
+            benchmark::DoNotOptimize(log_event);
+        }
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+}
+
+template <typename encoded_var_t>
+auto bench_deserialize_batch(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    std::vector<LogEventView> log_events(cBatchSize);
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        for (size_t num_read{0}; num_read < corpus.size();) {
+            size_t pos{0};
+            size_t num_events{0};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_deserializer_deserialize_eight_byte_log_events_batch(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        0,
+                        &pos,
+                        {log_events.data(), log_events.size()},
+                        &num_events
+                );
+            } else {
+                err = ir_deserializer_deserialize_four_byte_log_events_batch(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        0,
+                        &pos,
+                        {log_events.data(), log_events.size()},
+                        &num_events
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_deserializer_deserialize_*_log_events_batch failed");
+                break;
+            }
+            ir_pos += pos;
+            num_read += num_events;
+            benchmark::DoNotOptimize(log_events.data());
+        }
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+}
+
+template <typename encoded_var_t>
+auto bench_deserialize_parallel(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    auto const num_chunks{static_cast<size_t>(state.range(0))};
+
+    // Find the start of every (corpus.size() / num_chunks)th log event, and the
+    // timestamp preceding it, as an ir.Index of the stream would record.
+    size_t preamble_end{0};
+    void* deserializer{new_deserializer(ir_buf, preamble_end)};
+    if (nullptr == deserializer) {
+        state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+        return;
+    }
+    std::vector<size_t> chunk_offsets;
+    std::vector<int64_t> chunk_timestamps;
+    size_t const events_per_chunk{std::max(corpus.size() / num_chunks, size_t{1})};
+    size_t ir_pos{preamble_end};
+    LogEventView log_event{};
+    epoch_time_ms_t prev_timestamp{cReferenceTimestamp};
+    for (size_t i{0}; i < corpus.size(); ++i) {
+        if (0 != i && 0 == i % events_per_chunk) {
+            chunk_offsets.push_back(ir_pos - preamble_end);
+            chunk_timestamps.push_back(prev_timestamp);
+        }
+        size_t pos{0};
+        int err{0};
+        if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+            err = ir_deserializer_deserialize_eight_byte_log_event(
+                    {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                    deserializer,
+                    &pos,
+                    &log_event
+            );
+        } else {
+            err = ir_deserializer_deserialize_four_byte_log_event(
+                    {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                    deserializer,
+                    &pos,
+                    &log_event
+            );
+        }
+        if (0 != err) {
+            state.SkipWithError("ir_deserializer_deserialize_*_log_event failed");
+            ir_deserializer_close(deserializer);
+            return;
+        }
+        ir_pos += pos;
+        prev_timestamp = log_event.m_timestamp;
+    }
+    ir_deserializer_close(deserializer);
+
+    ByteSpan const ir_view{ir_buf.data() + preamble_end, ir_buf.size() - preamble_end};
+    LogEventViewSpan log_events{};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t pos{0};
+        deserializer = new_deserializer(ir_buf, pos);
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        int err{0};
+        if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+            err = ir_deserializer_deserialize_eight_byte_log_events_parallel(
+                    ir_view,
+                    deserializer,
+                    {chunk_offsets.data(), chunk_offsets.size()},
+                    {chunk_timestamps.data(), chunk_timestamps.size()},
+                    &pos,
+                    &log_events
+            );
+        } else {
+            err = ir_deserializer_deserialize_four_byte_log_events_parallel(
+                    ir_view,
+                    deserializer,
+                    {chunk_offsets.data(), chunk_offsets.size()},
+                    {chunk_timestamps.data(), chunk_timestamps.size()},
+                    &pos,
+                    &log_events
+            );
+        }
+        if (0 != err || corpus.size() != log_events.m_size) {
+            state.SkipWithError("ir_deserializer_deserialize_*_log_events_parallel failed");
+            ir_deserializer_close(deserializer);
+            break;
+        }
+        benchmark::DoNotOptimize(log_events);
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+}
+
+template <typename encoded_var_t>
+auto bench_deserialize_columns(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        for (size_t num_read{0}; num_read < corpus.size();) {
+            size_t pos{0};
+            LogEventColumns columns{};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_deserializer_deserialize_eight_byte_log_event_columns(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        cBatchSize,
+                        0,
+                        nullptr,
+                        true,
+                        &pos,
+                        &columns
+                );
+            } else {
+                err = ir_deserializer_deserialize_four_byte_log_event_columns(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        cBatchSize,
+                        0,
+                        nullptr,
+                        true,
+                        &pos,
+                        &columns
+                );
+            }
+            if (0 != err) {
+                state.SkipWithError("ir_deserializer_deserialize_*_log_event_columns failed");
+                break;
+            }
+            ir_pos += pos;
+            num_read += columns.m_timestamps.m_size;
+            benchmark::DoNotOptimize(columns.m_message_data.m_data);
+        }
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+}
+
+template <typename encoded_var_t>
+auto bench_zstd_compress(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    ByteSpan const ir_view{ir_buf.data(), ir_buf.size()};
+    auto const compression_level{static_cast<int>(state.range(0))};
+    int64_t compressed_size{0};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        void* compressor{ir_zstd_compressor_new(compression_level, cZstdFrameSize)};
+        ByteSpan frames{};
+        if (0 != ir_zstd_compressor_write(compressor, ir_view, &frames)) {
+            state.SkipWithError("ir_zstd_compressor_write failed");
+            ir_zstd_compressor_close(compressor);
+            break;
+        }
+        compressed_size = static_cast<int64_t>(frames.m_size);
+        benchmark::DoNotOptimize(frames);
+        if (0 != ir_zstd_compressor_finish(compressor, &frames)) {
+            state.SkipWithError("ir_zstd_compressor_finish failed");
+            ir_zstd_compressor_close(compressor);
+            break;
+        }
+        compressed_size += static_cast<int64_t>(frames.m_size);
+        benchmark::DoNotOptimize(frames);
+        SizetSpan uncompressed_ends{};
+        SizetSpan compressed_ends{};
+        ir_zstd_compressor_get_frames(compressor, &uncompressed_ends, &compressed_ends);
+        benchmark::DoNotOptimize(compressed_ends);
+        ir_zstd_compressor_close(compressor);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    state.counters["ratio"] = static_cast<double>(ir_buf.size())
+                              / static_cast<double>(std::max(compressed_size, int64_t{1}));
+}
+
+template <typename encoded_var_t>
+auto bench_zstd_decompress(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    auto compressed{compress_ir(ir_buf, 3)};
+    if (compressed.empty()) {
+        state.SkipWithError("ir_zstd_compressor_* failed");
+        return;
+    }
+    std::vector<int8_t> decompressed(ir_buf.size());
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        void* decompressor{ir_zstd_decompressor_new()};
+        size_t src_pos{0};
+        size_t dst_pos{0};
+        while (src_pos < compressed.size()) {
+            size_t src_read{0};
+            size_t dst_written{0};
+            bool frame_done{false};
+            if (0
+                != ir_zstd_decompressor_decompress(
+                        decompressor,
+                        {compressed.data() + src_pos, compressed.size() - src_pos},
+                        {decompressed.data() + dst_pos, decompressed.size() - dst_pos},
+                        &src_read,
+                        &dst_written,
+                        &frame_done
+                ))
+            {
+                state.SkipWithError("ir_zstd_decompressor_decompress failed");
+                break;
+            }
+            src_pos += src_read;
+            dst_pos += dst_written;
+        }
+        benchmark::DoNotOptimize(decompressed.data());
+        ir_zstd_decompressor_close(decompressor);
+        if (decompressed.size() != dst_pos) {
+            state.SkipWithError("ir_zstd_decompressor_decompress output is truncated");
+            break;
+        }
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+}
+
+template <typename encoded_var_t>
+auto bench_wildcard_match(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    Queries queries{static_cast<size_t>(state.range(0))};
+    TimestampInterval const time_interval{0, INT64_MAX};
+    LogEventView log_event{};
+    size_t matching_query{0};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        while (true) {
+            size_t pos{0};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_deserializer_deserialize_eight_byte_wildcard_match(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        time_interval,
+                        queries.view(),
+                        &pos,
+                        &log_event,
+                        &matching_query
+                );
+            } else {
+                err = ir_deserializer_deserialize_four_byte_wildcard_match(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        time_interval,
+                        queries.view(),
+                        &pos,
+                        &log_event,
+                        &matching_query
+                );
+            }
+            if (0 != err) {
+                break;
+            }
+            ir_pos += pos;
+            benchmark::DoNotOptimize(log_event);
+        }
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+}
+
+template <typename encoded_var_t>
+auto bench_compiled_query_match(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    Queries queries{static_cast<size_t>(state.range(0))};
+    void* compiled_query{wildcard_query_compile(queries.view())};
+    TimestampInterval const time_interval{0, INT64_MAX};
+    LogEventView log_event{};
+    size_t matching_query{0};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        while (true) {
+            size_t pos{0};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_deserializer_deserialize_eight_byte_compiled_query_match(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        time_interval,
+                        compiled_query,
+                        &pos,
+                        &log_event,
+                        &matching_query
+                );
+            } else {
+                err = ir_deserializer_deserialize_four_byte_compiled_query_match(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        time_interval,
+                        compiled_query,
+                        &pos,
+                        &log_event,
+                        &matching_query
+                );
+            }
+            if (0 != err) {
+                break;
+            }
+            ir_pos += pos;
+            benchmark::DoNotOptimize(log_event);
+        }
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    wildcard_query_compiled_delete(compiled_query);
+}
+
+template <typename encoded_var_t>
+auto bench_numeric_query_match(benchmark::State& state, Corpus const& corpus) -> void {
+    constexpr std::string_view cLogtypeQuery{"*memory used * GB"};
+    // Memory usage (the third variable of its log message) > 500 GB.
+    NumericPredicateView predicate{2, 500.0, 5};
+    void* numeric_query{numeric_query_new(
+            {{cLogtypeQuery.data(), cLogtypeQuery.size()}, true},
+            {&predicate, 1}
+    )};
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    TimestampInterval const time_interval{0, INT64_MAX};
+    LogEventView log_event{};
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        while (true) {
+            size_t pos{0};
+            int err{0};
+            if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+                err = ir_deserializer_deserialize_eight_byte_numeric_query_match(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        time_interval,
+                        numeric_query,
+                        &pos,
+                        &log_event
+                );
+            } else {
+                err = ir_deserializer_deserialize_four_byte_numeric_query_match(
+                        {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                        deserializer,
+                        time_interval,
+                        numeric_query,
+                        &pos,
+                        &log_event
+                );
+            }
+            if (0 != err) {
+                break;
+            }
+            ir_pos += pos;
+            benchmark::DoNotOptimize(log_event);
+        }
+        ir_deserializer_close(deserializer);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    numeric_query_delete(numeric_query);
+}
+
+template <typename encoded_var_t>
+auto bench_count_matches(benchmark::State& state, Corpus const& corpus) -> void {
+    // ffi::ir_stream::IRErrorCode_Eof, returned once the whole stream is counted
+    constexpr int cIrErrorEof{2};
+    constexpr epoch_time_ms_t cBucketWidth{60'000};
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    auto const num_queries{static_cast<size_t>(state.range(0))};
+    Queries queries{num_queries};
+    void* compiled_query{wildcard_query_compile(queries.view())};
+    auto const [min_timestamp, max_timestamp]{
+            std::minmax_element(corpus.m_timestamps.cbegin(), corpus.m_timestamps.cend())
+    };
+    TimestampInterval const time_interval{*min_timestamp, *max_timestamp + 1};
+    auto const num_buckets{static_cast<size_t>(
+            (time_interval.m_upper - time_interval.m_lower - 1) / cBucketWidth + 1
+    )};
+    std::vector<int64_t> counts(num_queries * num_buckets);
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        size_t ir_pos{0};
+        void* deserializer{new_deserializer(ir_buf, ir_pos)};
+        if (nullptr == deserializer) {
+            state.SkipWithError("ir_deserializer_new_deserializer_with_preamble failed");
+            break;
+        }
+        size_t pos{0};
+        int err{0};
+        if constexpr (std::is_same_v<int64_t, encoded_var_t>) {
+            err = ir_deserializer_eight_byte_count_matches(
+                    {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                    deserializer,
+                    time_interval,
+                    cBucketWidth,
+                    compiled_query,
+                    &pos,
+                    {counts.data(), counts.size()}
+            );
+        } else {
+            err = ir_deserializer_four_byte_count_matches(
+                    {ir_buf.data() + ir_pos, ir_buf.size() - ir_pos},
+                    deserializer,
+                    time_interval,
+                    cBucketWidth,
+                    compiled_query,
+                    &pos,
+                    {counts.data(), counts.size()}
+            );
+        }
+        ir_deserializer_close(deserializer);
+        if (cIrErrorEof != err) {
+            state.SkipWithError("ir_deserializer_*_count_matches failed");
+            break;
+        }
+        benchmark::DoNotOptimize(counts.data());
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    wildcard_query_compiled_delete(compiled_query);
+}
+
+template <typename encoded_var_t>
+auto bench_search_engine(benchmark::State& state, Corpus const& corpus) -> void {
+    auto ir_buf{serialize_corpus<encoded_var_t>(corpus)};
+    Queries queries{static_cast<size_t>(state.range(0))};
+    void* compiled_query{wildcard_query_compile(queries.view())};
+    auto const num_threads{static_cast<size_t>(state.range(1))};
+    std::vector<ByteSpan> buffers(num_threads, ByteSpan{ir_buf.data(), ir_buf.size()});
+    std::vector<SearchResult> results(cBatchSize);
+    auto const num_allocs{g_num_allocs.load(std::memory_order_relaxed)};
+    for ([[maybe_unused]] auto _ : state) {
+        void* search_engine{search_engine_search_buffers(
+                {buffers.data(), buffers.size()},
+                compiled_query,
+                {0, INT64_MAX},
+                num_threads,
+                cBatchSize * num_threads
+        )};
+        if (nullptr == search_engine) {
+            state.SkipWithError("search_engine_search_buffers failed");
+            break;
+        }
+        size_t num_results{0};
+        while (0
+               != search_engine_next_results(
+                       search_engine,
+                       {results.data(), results.size()},
+                       &num_results
+               ))
+        {
+            benchmark::DoNotOptimize(results.data());
+        }
+        search_engine_delete(search_engine);
+    }
+    set_corpus_counters(state, corpus, num_allocs);
+    // Every copy of the corpus is searched per iteration.
+    state.SetBytesProcessed(
+            state.iterations() * static_cast<int64_t>(corpus.m_messages.size() * num_threads)
+    );
+    state.counters["events/s"] = benchmark::Counter(
+            static_cast<double>(state.iterations())
+                    * static_cast<double>(corpus.size() * num_threads),
+            benchmark::Counter::kIsRate
+    );
+    wildcard_query_compiled_delete(compiled_query);
+}
+
+template <typename encoded_var_t>
+auto register_benchmarks(Corpus const& corpus) -> void {
+    std::string const suffix{
+            (std::is_same_v<int64_t, encoded_var_t> ? "/EightByte/" : "/FourByte/")
+            + corpus.m_name
+    };
+    auto const add{[&](std::string const& name, auto* bench) {
+        return benchmark::RegisterBenchmark(
+                (name + suffix).c_str(),
+                [bench, &corpus](benchmark::State& state) { bench(state, corpus); }
+        );
+    }};
+    add("encode", &bench_encode<encoded_var_t>);
+    add("decode", &bench_decode<encoded_var_t>);
+    add("serialize", &bench_serialize<encoded_var_t>);
+    add("serialize_batch", &bench_serialize_batch<encoded_var_t>);
+    add("serialize_append", &bench_serialize_append<encoded_var_t>);
+    add("serialize_append_batch", &bench_serialize_append_batch<encoded_var_t>);
+    add("deserialize", &bench_deserialize<encoded_var_t>);
+    add("deserialize_batch", &bench_deserialize_batch<encoded_var_t>);
+    add("deserialize_parallel", &bench_deserialize_parallel<encoded_var_t>)
+            ->ArgName("chunks")
+            ->RangeMultiplier(4)
+            ->Range(1, 16)
+            ->UseRealTime();
+    add("deserialize_columns", &bench_deserialize_columns<encoded_var_t>);
+    add("zstd_compress", &bench_zstd_compress<encoded_var_t>)->ArgName("level")->Arg(1)->Arg(3);
+    add("zstd_decompress", &bench_zstd_decompress<encoded_var_t>);
+    add("wildcard_match", &bench_wildcard_match<encoded_var_t>)
+            ->ArgName("queries")
+            ->RangeMultiplier(4)
+            ->Range(1, static_cast<int64_t>(cMaxQueries));
+    add("compiled_query_match", &bench_compiled_query_match<encoded_var_t>)
+            ->ArgName("queries")
+            ->RangeMultiplier(4)
+            ->Range(1, static_cast<int64_t>(cMaxQueries));
+    add("numeric_query_match", &bench_numeric_query_match<encoded_var_t>);
+    add("count_matches", &bench_count_matches<encoded_var_t>)
+            ->ArgName("queries")
+            ->RangeMultiplier(4)
+            ->Range(1, static_cast<int64_t>(cMaxQueries));
+    add("search_engine", &bench_search_engine<encoded_var_t>)
+            ->ArgNames({"queries", "threads"})
+            ->ArgsProduct({{1, 4, 16, static_cast<int64_t>(cMaxQueries)}, {1, 4}})
+            ->UseRealTime();
+}
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    // The corpora must outlive the registered benchmarks.
+    static Corpus const cSynthetic{make_synthetic_corpus(1)};
+    static Corpus const cRealistic{make_realistic_corpus(1)};
+    for (auto const* corpus : {&cSynthetic, &cRealistic}) {
+        register_benchmarks<int64_t>(*corpus);
+        register_benchmarks<int32_t>(*corpus);
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
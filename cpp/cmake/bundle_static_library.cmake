@@ -0,0 +1,39 @@
+# Adds the object files of the static library BUNDLED_LIBRARY to the static library LIBRARY, so
+# that LIBRARY can be linked without BUNDLED_LIBRARY.
+#
+# Usage:
+#   cmake -DLIBRARY=<path> -DBUNDLED_LIBRARY=<path> -DAR=<ar> [-DLIBTOOL=<libtool>] \
+#     -P bundle_static_library.cmake
+#
+# When LIBTOOL is set (on macOS) the libraries are merged with `libtool -static`, otherwise with an
+# `ar -M` script.
+
+set(merged_library "${LIBRARY}.bundled")
+file(REMOVE "${merged_library}")
+
+if (LIBTOOL)
+    execute_process(
+        COMMAND "${LIBTOOL}" -static -o "${merged_library}" "${LIBRARY}" "${BUNDLED_LIBRARY}"
+        RESULT_VARIABLE result
+    )
+else()
+    set(mri_script "${LIBRARY}.mri")
+    file(WRITE "${mri_script}"
+        "CREATE ${merged_library}\n"
+        "ADDLIB ${LIBRARY}\n"
+        "ADDLIB ${BUNDLED_LIBRARY}\n"
+        "SAVE\n"
+        "END\n"
+    )
+    execute_process(
+        COMMAND "${AR}" -M
+        INPUT_FILE "${mri_script}"
+        RESULT_VARIABLE result
+    )
+    file(REMOVE "${mri_script}")
+endif()
+
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to bundle ${BUNDLED_LIBRARY} into ${LIBRARY}.")
+endif()
+file(RENAME "${merged_library}" "${LIBRARY}")
@@ -0,0 +1,74 @@
+// libFuzzer target checking that search::wildcard_match returns the same
+// results as CLP's wildcard_match_unsafe with every kernel supported by the
+// CPU. Each input is split into a query and a target:
+// - byte 0: bit 0 selects case sensitive matching, and bit 1 maps every
+//   following byte onto a small alphabet (so queries often match targets)
+// - byte 1: size of the query (clamped to the rest of the input)
+// - the query (cleaned as wildcard_query_new does), then the target
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <clp/string_utils/string_utils.hpp>
+
+#include "ffi_go/search/wildcard_match.hpp"
+
+namespace {
+// Characters (in both cases) that queries and targets are built from when
+// mapping onto the alphabet, along with wildcards, an escape, a delimiter, and
+// a non-ASCII byte.
+constexpr std::string_view cAlphabet{"aAbBzZ?*\\ \xc3"};
+
+/**
+ * @param bytes
+ * @param use_alphabet Whether to map each byte onto cAlphabet
+ * @return bytes as a string
+ */
+[[nodiscard]] auto to_string(std::span<uint8_t const> bytes, bool use_alphabet) -> std::string {
+    std::string str;
+    str.reserve(bytes.size());
+    for (auto const byte : bytes) {
+        str.push_back(use_alphabet ? cAlphabet[byte % cAlphabet.size()] : static_cast<char>(byte));
+    }
+    return str;
+}
+}  // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+extern "C" auto LLVMFuzzerTestOneInput(uint8_t const* data, size_t size) -> int {
+    std::span<uint8_t const> const input{data, size};
+    if (input.size() < 2) {
+        return 0;
+    }
+    bool const case_sensitive{0 != (input[0] & 1U)};
+    bool const use_alphabet{0 != (input[0] & 2U)};
+    size_t const query_size{std::min<size_t>(input[1], input.size() - 2)};
+    auto const query{clp::string_utils::clean_up_wildcard_search_string(
+            to_string(input.subspan(2, query_size), use_alphabet)
+    )};
+    auto const target{to_string(input.subspan(2 + query_size), use_alphabet)};
+
+    bool const expected{clp::string_utils::wildcard_match_unsafe(target, query, case_sensitive)};
+    for (auto const kernel : ffi_go::search::get_supported_wildcard_match_kernels()) {
+        if (expected
+            != ffi_go::search::wildcard_match(target, query, case_sensitive, kernel))
+        {
+            std::fprintf(
+                    stderr,
+                    "kernel %d returned %d for query '%s' and target '%s'\n",
+                    static_cast<int>(kernel),
+                    static_cast<int>(false == expected),
+                    query.c_str(),
+                    target.c_str()
+            );
+            std::abort();
+        }
+    }
+    return 0;
+}
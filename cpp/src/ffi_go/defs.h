@@ -30,6 +30,14 @@ typedef struct {
     size_t m_size;
 } ByteSpan;
 
+/**
+ * A span of a ByteSpan array passed down through Cgo.
+ */
+typedef struct {
+    ByteSpan* m_data;
+    size_t m_size;
+} ByteSpanSpan;
+
 /**
  * A span of a Go int32 array passed down through Cgo.
  */
@@ -70,6 +78,14 @@ typedef struct {
     epoch_time_ms_t m_timestamp;
 } LogEventView;
 
+/**
+ * A span of a LogEventView array passed down through Cgo.
+ */
+typedef struct {
+    LogEventView* m_data;
+    size_t m_size;
+} LogEventViewSpan;
+
 // NOLINTEND(modernize-use-using)
 // NOLINTEND(modernize-deprecated-headers)
 #endif  // FFI_GO_DEF_H
@@ -1,15 +1,17 @@
 #include "decoder.h"
 
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string_view>
 #include <type_traits>
 
-#include <clp/ffi/encoding_methods.hpp>
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ir/types.hpp>
 
 #include "ffi_go/api_decoration.h"
 #include "ffi_go/defs.h"
+#include "ffi_go/ir/message_decoding.hpp"
 #include "ffi_go/ir/types.hpp"
 
 namespace ffi_go::ir {
@@ -37,19 +39,35 @@ template <class encoded_var_view_t>
     }
     Decoder* decoder{static_cast<Decoder*>(ir_decoder)};
     auto& log_msg{decoder->m_log_message};
-    log_msg.reserve(logtype.m_size + dict_vars.m_size);
+    auto& buffers{decoder->m_decoding_buffers};
+
+    // Split dict_vars at each end offset, checking that the offsets don't
+    // decrease or go past the end of dict_vars.
+    std::string_view const all_dict_vars{dict_vars.m_data, dict_vars.m_size};
+    std::span<int32_t const> const end_offsets{
+            dict_var_end_offsets.m_data,
+            dict_var_end_offsets.m_size
+    };
+    buffers.m_dict_vars.clear();
+    size_t begin{0};
+    for (auto const end_offset : end_offsets) {
+        auto const end{static_cast<size_t>(end_offset)};
+        if (end_offset < 0 || end < begin || all_dict_vars.size() < end) {
+            return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+        }
+        buffers.m_dict_vars.push_back(all_dict_vars.substr(begin, end - begin));
+        begin = end;
+    }
 
     IRErrorCode err{IRErrorCode::IRErrorCode_Success};
-    try {
-        log_msg = clp::ffi::decode_message<encoded_var_t>(
+    if (false
+        == decode_message(
                 std::string_view(logtype.m_data, logtype.m_size),
-                vars.m_data,
-                vars.m_size,
-                std::string_view(dict_vars.m_data, dict_vars.m_size),
-                dict_var_end_offsets.m_data,
-                dict_var_end_offsets.m_size
-        );
-    } catch (clp::ffi::EncodingException const& e) {
+                std::span<encoded_var_t const>{vars.m_data, vars.m_size},
+                buffers,
+                log_msg
+        ))
+    {
         err = IRErrorCode::IRErrorCode_Decode_Error;
     }
 
@@ -35,8 +35,9 @@ CLP_FFI_GO_METHOD void ir_decoder_close(void* decoder);
  * @param[in] ir_decoder ir::Decoder to be used as storage for the decoded log
  *     message
  * @param[out] log_message Decoded log message
- * @return ffi::ir_stream::IRErrorCode_Decode_Error if ffi::decode_message
- *     throws or errors
+ * @return ffi::ir_stream::IRErrorCode_Decode_Error if the placeholders in
+ *     logtype don't agree with the variables, an encoded float is invalid, or
+ *     dict_var_end_offsets doesn't mark the ends of variables in dict_vars
  * @return ffi::ir_stream::IRErrorCode_Success on success
  */
 CLP_FFI_GO_METHOD int ir_decoder_decode_eight_byte_log_message(
@@ -64,8 +65,9 @@ CLP_FFI_GO_METHOD int ir_decoder_decode_eight_byte_log_message(
  * @param[in] ir_decoder ir::Decoder to be used as storage for the decoded log
  *     message
  * @param[out] log_message Decoded log message
- * @return ffi::ir_stream::IRErrorCode_Decode_Error if ffi::decode_message
- *     throws or errors
+ * @return ffi::ir_stream::IRErrorCode_Decode_Error if the placeholders in
+ *     logtype don't agree with the variables, an encoded float is invalid, or
+ *     dict_var_end_offsets doesn't mark the ends of variables in dict_vars
  * @return ffi::ir_stream::IRErrorCode_Success on success
  */
 CLP_FFI_GO_METHOD int ir_decoder_decode_four_byte_log_message(
@@ -1,39 +1,352 @@
 #include "deserializer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <exception>
+#include <optional>
 #include <span>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
-#include <utility>
 #include <vector>
 
 #include <clp/BufferReader.hpp>
 #include <clp/ErrorCode.hpp>
+#include <clp/ffi/encoding_methods.hpp>
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ffi/ir_stream/protocol_constants.hpp>
 #include <clp/ir/types.hpp>
-#include <clp/string_utils/string_utils.hpp>
 
 #include "ffi_go/api_decoration.h"
 #include "ffi_go/defs.h"
+#include "ffi_go/ir/message_decoding.hpp"
 #include "ffi_go/ir/types.hpp"
+#include "ffi_go/search/compiled_query.hpp"
+#include "ffi_go/search/numeric_query.hpp"
 #include "ffi_go/search/wildcard_query.h"
 #include "ffi_go/types.hpp"
 
 namespace ffi_go::ir {
 using clp::BufferReader;
 using clp::ffi::ir_stream::cProtocol::Eof;
+namespace Payload = clp::ffi::ir_stream::cProtocol::Payload;
 using clp::ffi::ir_stream::deserialize_preamble;
 using clp::ffi::ir_stream::deserialize_tag;
 using clp::ffi::ir_stream::get_encoding_type;
 using clp::ffi::ir_stream::IRErrorCode;
 using clp::ir::eight_byte_encoded_variable_t;
 using clp::ir::four_byte_encoded_variable_t;
+using clp::ir::VariablePlaceholder;
 
 namespace {
+// Upper bound on the number of threads deserialize_log_events_parallel uses,
+// regardless of the number of chunks or the hardware's concurrency.
+constexpr size_t cMaxParallelThreads{64};
+
+/**
+ * Deserialize the next log event in ir_buf into its encoded form, then decode
+ * its message into log_message. On success, timestamp is updated to the log
+ * event's timestamp.
+ * @param[in] ir_buf Reader positioned at the start of the next log event
+ * @param[in,out] timestamp Timestamp of the previous log event in the stream
+ * @param[out] encoded_log_event Storage for the encoded log event
+ * @param[out] log_message Storage for the log event's message
+ * @return ffi::ir_stream::IRErrorCode_Eof if the IR stream's EOF tag is found
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::deserialize_tag, ffi::ir_stream::deserialize_log_event,
+ *     or decode_log_message
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto deserialize_next_log_event(
+        BufferReader& ir_buf,
+        epoch_time_ms_t& timestamp,
+        EncodedLogEventStorage<encoded_variable_t>& encoded_log_event,
+        ffi_go::LogMessage& log_message
+) -> IRErrorCode;
+
+/**
+ * Deserialize the log events of the chunk [begin, end) of ir_view into chunk,
+ * stopping early at the IR stream's EOF tag or an error.
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] begin Position in ir_view of the first log event of the chunk
+ * @param[in] end Position in ir_view after the last log event of the chunk
+ * @param[in] timestamp Timestamp of the log event before the chunk
+ * @param[out] chunk Storage for the chunk's log events
+ */
+template <class encoded_variable_t>
+auto deserialize_log_event_chunk(
+        ByteSpan ir_view,
+        size_t begin,
+        size_t end,
+        epoch_time_ms_t timestamp,
+        LogEventChunk& chunk
+) -> void;
+
+/**
+ * @return The storage inside owner (a Deserializer or LogEventChunk) for log
+ *     events in their encoded form with encoded_variable_t
+ */
+template <class encoded_variable_t, class owner_t>
+[[nodiscard]] auto get_encoded_log_event(owner_t& owner)
+        -> EncodedLogEventStorage<encoded_variable_t>&;
+
+/**
+ * Deserialize the next log event in ir_buf into its encoded form (logtype,
+ * encoded variables, and dictionary variables) without decoding its message,
+ * then split the logtype into its static text. On success, the timestamp of
+ * deserializer is updated to the log event's timestamp.
+ * @param[in] ir_buf Reader positioned at the start of the next log event
+ * @param[in] deserializer ir::Deserializer tracking the stream's timestamp
+ * @param[out] log_event Storage for the encoded log event
+ * @return ffi::ir_stream::IRErrorCode_Eof if the IR stream's EOF tag is found
+ * @return ffi::ir_stream::IRErrorCode_Decode_Error if the logtype does not
+ *     agree with the log event's variables
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::deserialize_tag or ffi::ir_stream::deserialize_log_event
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto deserialize_next_encoded_log_event(
+        BufferReader& ir_buf,
+        Deserializer* deserializer,
+        EncodedLogEventStorage<encoded_variable_t>& log_event
+) -> IRErrorCode;
+
+/**
+ * Skip over the next log event in ir_buf, deserializing only its timestamp. The
+ * log event's variables and logtype are skipped using their encoded lengths,
+ * without being copied or validated. On success, the timestamp of deserializer
+ * is updated to the log event's timestamp.
+ * @param[in] ir_buf Reader positioned at the start of the next log event
+ * @param[in] deserializer ir::Deserializer tracking the stream's timestamp
+ * @return ffi::ir_stream::IRErrorCode_Eof if the IR stream's EOF tag is found
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR if ir_buf ends before the
+ *     end of the log event
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if an unexpected tag is
+ *     found
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto skip_next_log_event(BufferReader& ir_buf, Deserializer* deserializer)
+        -> IRErrorCode;
+
+/**
+ * Read a big-endian integer from ir_buf.
+ * @param[in] ir_buf
+ * @param[out] value
+ * @return Whether ir_buf contained enough bytes to read value
+ */
+template <class integer_t>
+[[nodiscard]] auto read_int(BufferReader& ir_buf, integer_t& value) -> bool;
+
+/**
+ * Advance ir_buf past num_bytes bytes.
+ * @param ir_buf
+ * @param num_bytes
+ * @return Whether ir_buf contained num_bytes more bytes
+ */
+[[nodiscard]] auto skip_bytes(BufferReader& ir_buf, size_t num_bytes) -> bool;
+
+/**
+ * Fill in the static text of log_event by unescaping its logtype and splitting
+ * it at each non-empty variable. Empty dictionary variables do not split the
+ * static text, as text on either side of them is adjacent in the log message.
+ * @param log_event
+ * @return Whether the placeholders in the logtype agree with the variables of
+ *     log_event
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto split_logtype(EncodedLogEventStorage<encoded_variable_t>& log_event) -> bool;
+
+/**
+ * Decode the encoded variables of log_event into strings.
+ * @param log_event
+ */
+template <class encoded_variable_t>
+auto decode_vars(EncodedLogEventStorage<encoded_variable_t>& log_event) -> void;
+
+/**
+ * Decode the log message of an encoded log event with ir::decode_message.
+ * @param[in] log_event
+ * @param[out] log_message
+ * @return ffi::ir_stream::IRErrorCode_Decode_Error if decoding fails
+ * @return ffi::ir_stream::IRErrorCode_Success on success
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto decode_log_message(
+        EncodedLogEventStorage<encoded_variable_t>& log_event,
+        ffi_go::LogMessage& log_message
+) -> IRErrorCode;
+
+/**
+ * A logtype element: either a single (unescaped) static character, or the
+ * placeholder of a variable.
+ */
+struct LogtypeElement {
+    char m_char;
+    bool m_is_var;
+};
+
+/**
+ * Return the LogtypeMatch of logtype for compiled_query from the
+ * ir::Deserializer's LogtypeMatchCache, classifying logtype into the cache on a
+ * miss.
+ * @param deserializer
+ * @param compiled_query
+ * @param logtype Valid logtype
+ * @return The LogtypeMatch of logtype
+ */
+[[nodiscard]] auto get_logtype_match(
+        Deserializer* deserializer,
+        search::CompiledQuery const& compiled_query,
+        std::string const& logtype
+) -> LogtypeMatch const&;
+
+/**
+ * Determine which queries of compiled_query can, and which must, match every
+ * log message with logtype. As CLP only encodes variables found within tokens
+ * (text between delimiters, see `clp::ffi::is_delim`), a dictionary variable
+ * only contains non-delimiter characters, while a decoded integer or float
+ * variable only contains digits, '-', and '.'. A query can only match if each
+ * of its literals can occur in such a log message. If the logtype contains no
+ * variables, the log message is the logtype's static text so the queries are
+ * matched against it directly.
+ * @param compiled_query
+ * @param logtype Valid logtype
+ * @return The LogtypeMatch of logtype
+ */
+[[nodiscard]] auto
+classify_logtype(search::CompiledQuery const& compiled_query, std::string_view logtype)
+        -> LogtypeMatch;
+
+/**
+ * @param literal
+ * @param case_sensitive
+ * @param elements Elements of a logtype
+ * @return Whether literal could occur in any log message with the logtype
+ */
+[[nodiscard]] auto could_occur_in_logtype(
+        std::string_view literal,
+        bool case_sensitive,
+        std::vector<LogtypeElement> const& elements
+) -> bool;
+
+/**
+ * @param placeholder
+ * @param c
+ * @return Whether c can occur in a variable with placeholder
+ */
+[[nodiscard]] auto could_occur_in_var(char placeholder, char c) -> bool;
+
+/**
+ * @param literals
+ * @param case_sensitive
+ * @param static_text Static text of a logtype, split at each variable
+ * @return Whether literals occur in order, without overlap, within the pieces
+ *     of static_text (i.e. in every log message with the logtype)
+ */
+[[nodiscard]] auto contains_ordered_literals(
+        std::vector<std::string> const& literals,
+        bool case_sensitive,
+        std::vector<std::string> const& static_text
+) -> bool;
+
+/**
+ * @param candidates
+ * @return Whether no query is set in candidates
+ */
+[[nodiscard]] auto is_empty(search::CompiledQuery::Candidates const& candidates) -> bool;
+
+/**
+ * Check whether any query in possible could match the log message of an encoded
+ * log event, without decoding it. A query can only match if each of its
+ * literals occurs in the log message, and an occurrence of a literal must either
+ * lie within a single piece of the logtype's static text or overlap a variable.
+ * Therefore, the check never rejects a log event that a query matches, but may
+ * accept log events that no query matches.
+ * @param compiled_query
+ * @param possible Bitset of the queries in compiled_query to check
+ * @param log_event
+ * @return Whether any query could match the log message of log_event
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto could_match(
+        search::CompiledQuery const& compiled_query,
+        search::CompiledQuery::Candidates const& possible,
+        EncodedLogEventStorage<encoded_variable_t>& log_event
+) -> bool;
+
+/**
+ * @param literal
+ * @param case_sensitive
+ * @param log_event
+ * @return Whether literal could occur in the log message of log_event
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto could_occur(
+        std::string_view literal,
+        bool case_sensitive,
+        EncodedLogEventStorage<encoded_variable_t>& log_event
+) -> bool;
+
+/**
+ * @param var
+ * @param literal
+ * @param case_sensitive
+ * @return Whether an occurrence of literal could overlap var (i.e. either
+ *     contains the other or a prefix of one is a suffix of the other)
+ */
+[[nodiscard]] auto
+could_overlap(std::string_view var, std::string_view literal, bool case_sensitive) -> bool;
+
+/**
+ * @param str
+ * @param substr
+ * @param case_sensitive
+ * @param pos Position in str to start searching from
+ * @return Position of the first occurrence of substr in str at or after pos
+ * @return std::string_view::npos if there is no such occurrence
+ */
+[[nodiscard]] auto
+find(std::string_view str, std::string_view substr, bool case_sensitive, size_t pos = 0)
+        -> size_t;
+
+/**
+ * @param str
+ * @param substr
+ * @param case_sensitive
+ * @return Whether str contains substr
+ */
+[[nodiscard]] auto contains(std::string_view str, std::string_view substr, bool case_sensitive)
+        -> bool;
+
+/**
+ * @param lhs
+ * @param rhs
+ * @param case_sensitive
+ * @return Whether lhs and rhs are equal
+ */
+[[nodiscard]] auto equals(std::string_view lhs, std::string_view rhs, bool case_sensitive) -> bool;
+
+/**
+ * @param c
+ * @return Whether c can occur in a decoded integer or float variable
+ */
+[[nodiscard]] constexpr auto is_encoded_var_char(char c) -> bool {
+    return ('0' <= c && c <= '9') || '-' == c || '.' == c;
+}
+
+/**
+ * @param c
+ * @return c converted to lower case if it is an ASCII upper case letter
+ */
+[[nodiscard]] constexpr auto fold_case(char c) -> char {
+    return ('A' <= c && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
 /**
  * Generic helper for ir_deserializer_deserialize_*_log_event
  */
@@ -46,194 +359,1567 @@ template <class encoded_variable_t>
 ) -> int;
 
 /**
- * Generic helper for ir_deserializer_deserialize_*_wildcard_match
+ * Return the ir::Deserializer's cached search::CompiledQuery, compiling
+ * merged_query into the cache if it differs from the cached queries.
+ */
+[[nodiscard]] auto get_compiled_query(
+        Deserializer* deserializer,
+        MergedWildcardQueryView merged_query
+) -> search::CompiledQuery const&;
+
+/**
+ * Check whether any query of a non-empty compiled_query could match a log event
+ * deserialized by deserialize_next_encoded_log_event, without decoding its log
+ * message. Most log events are usually rejected based on their logtype
+ * (cached) or the rest of their encoded form.
+ * @param deserializer
+ * @param compiled_query
+ * @param encoded_log_event
+ * @return The LogtypeMatch of the log event's logtype if a query could match
+ *     the log event
+ * @return nullptr if no query can match the log event
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto find_possible_matches(
+        Deserializer* deserializer,
+        search::CompiledQuery const& compiled_query,
+        EncodedLogEventStorage<encoded_variable_t>& encoded_log_event
+) -> LogtypeMatch const*;
+
+/**
+ * Find the first query of compiled_query that matches a log event deserialized
+ * by deserialize_next_encoded_log_event. The log message is only decoded (into
+ * the ir::Deserializer's log event storage) if find_possible_matches finds a
+ * query could match it. If compiled_query is empty, every log event matches.
+ * @param[in] deserializer
+ * @param[in] compiled_query
+ * @param[in] encoded_log_event
+ * @param[out] matching_query Index of the first matching query, or
+ *     std::nullopt if no query matches
+ * @return ffi::ir_stream::IRErrorCode forwarded from decode_log_message
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto match_log_event(
+        Deserializer* deserializer,
+        search::CompiledQuery const& compiled_query,
+        EncodedLogEventStorage<encoded_variable_t>& encoded_log_event,
+        std::optional<size_t>& matching_query
+) -> IRErrorCode;
+
+/**
+ * @param deserializer
+ * @param logtype
+ * @return The id of logtype in the ir::Deserializer, assigning logtype the next
+ *     id if it hasn't been seen before
+ */
+[[nodiscard]] auto get_logtype_id(Deserializer* deserializer, std::string const& logtype)
+        -> int64_t;
+
+/**
+ * Deserialize the log events of ir_buf within time_interval, calling
+ * on_log_event for each once it is deserialized into its encoded form (see
+ * deserialize_next_encoded_log_event), until on_log_event returns a value.
+ * While the previous log event is before the time interval, only the timestamp
+ * of each log event is deserialized.
+ * @param[in] ir_buf
+ * @param[in] deserializer
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[out] ir_pos On ffi::ir_stream::IRErrorCode_Eof,
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR, or cEndOfTimeInterval, the
+ *     end of the log events consumed (leaving the first log event at or after
+ *     time_interval.m_upper unconsumed)
+ * @param[in] on_log_event Callable returning std::optional<int>
+ * @return The value returned by on_log_event
+ * @return cEndOfTimeInterval if a log event at or after time_interval.m_upper
+ *     is found
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     deserialize_next_encoded_log_event or skip_next_log_event
+ */
+template <class encoded_variable_t, class log_event_handler_t>
+[[nodiscard]] auto scan_time_interval(
+        BufferReader& ir_buf,
+        Deserializer* deserializer,
+        TimestampInterval time_interval,
+        size_t* ir_pos,
+        log_event_handler_t on_log_event
+) -> int;
+
+/**
+ * Generic helper for ir_deserializer_deserialize_*_wildcard_match and
+ * ir_deserializer_deserialize_*_compiled_query_match
  */
 template <class encoded_variable_t>
 [[nodiscard]] auto deserialize_wildcard_match(
         ByteSpan ir_view,
         void* ir_deserializer,
         TimestampInterval time_interval,
-        WildcardQueryView queries,
+        search::CompiledQuery const& compiled_query,
         size_t* ir_pos,
         LogEventView* log_event,
         size_t* matching_query
 ) -> int;
 
+/**
+ * Return the variables compared by numeric_query in log events with logtype
+ * from the ir::Deserializer's NumericQueryCache, resolving logtype into the
+ * cache on a miss (see search::NumericQuery::resolve_logtype).
+ * @param deserializer
+ * @param numeric_query
+ * @param logtype
+ * @return The variable of each of numeric_query's predicates
+ * @return std::nullopt if numeric_query can't match log events with logtype
+ */
+[[nodiscard]] auto get_numeric_query_variables(
+        Deserializer* deserializer,
+        search::NumericQuery const& numeric_query,
+        std::string const& logtype
+) -> std::optional<search::NumericQuery::VariableRefs> const&;
+
+/**
+ * Generic helper for ir_deserializer_deserialize_*_numeric_query_match
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto deserialize_numeric_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        search::NumericQuery const& numeric_query,
+        size_t* ir_pos,
+        LogEventView* log_event
+) -> int;
+
+/**
+ * Generic helper for ir_deserializer_*_count_matches
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto count_matches(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        epoch_time_ms_t bucket_width,
+        void* compiled_query,
+        size_t* ir_pos,
+        Int64tSpan counts
+) -> int;
+
+/**
+ * Generic helper for ir_deserializer_deserialize_*_log_events_batch
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto deserialize_log_events_batch(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_bytes,
+        size_t* ir_pos,
+        LogEventViewSpan log_events,
+        size_t* num_events
+) -> int;
+
+/**
+ * @return The maximum number of threads (including the calling thread) that
+ *     deserialize_log_events_parallel uses: the hardware's concurrency, capped
+ *     at cMaxParallelThreads
+ */
+[[nodiscard]] auto get_max_parallel_threads() -> size_t;
+
+/**
+ * Generic helper for ir_deserializer_deserialize_*_log_events_parallel
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto deserialize_log_events_parallel(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        SizetSpan chunk_offsets,
+        Int64tSpan chunk_timestamps,
+        size_t* ir_pos,
+        LogEventViewSpan* log_events
+) -> int;
+
+/**
+ * Generic helper for ir_deserializer_deserialize_*_log_event_columns
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto deserialize_log_event_columns(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_events,
+        size_t max_bytes,
+        void* compiled_query,
+        bool logtype_ids,
+        size_t* ir_pos,
+        LogEventColumns* log_event_columns
+) -> int;
+
+template <class encoded_variable_t>
+auto deserialize_next_log_event(
+        BufferReader& ir_buf,
+        epoch_time_ms_t& timestamp,
+        EncodedLogEventStorage<encoded_variable_t>& encoded_log_event,
+        ffi_go::LogMessage& log_message
+) -> IRErrorCode {
+    clp::ffi::ir_stream::encoded_tag_t tag{};
+    if (auto const err{deserialize_tag(ir_buf, tag)}; IRErrorCode::IRErrorCode_Success != err) {
+        return err;
+    }
+    if (Eof == tag) {
+        return IRErrorCode::IRErrorCode_Eof;
+    }
+
+    auto& encoded_log_message{encoded_log_event.m_log_message};
+    encoded_log_message.m_logtype.clear();
+    encoded_log_message.m_vars.clear();
+    encoded_log_event.m_dict_vars.clear();
+    encoded_log_event.m_vars_decoded = false;
+    epoch_time_ms_t timestamp_or_timestamp_delta{};
+    if (auto const err{clp::ffi::ir_stream::deserialize_log_event<encoded_variable_t>(
+                ir_buf,
+                tag,
+                encoded_log_message.m_logtype,
+                encoded_log_message.m_vars,
+                encoded_log_event.m_dict_vars,
+                timestamp_or_timestamp_delta
+        )};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return err;
+    }
+    if (auto const err{decode_log_message(encoded_log_event, log_message)};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return err;
+    }
+
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        timestamp = timestamp_or_timestamp_delta;
+    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        timestamp += timestamp_or_timestamp_delta;
+    } else {
+        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+    }
+    return IRErrorCode::IRErrorCode_Success;
+}
+
+template <class encoded_variable_t>
+auto deserialize_log_event_chunk(
+        ByteSpan ir_view,
+        size_t begin,
+        size_t end,
+        epoch_time_ms_t timestamp,
+        LogEventChunk& chunk
+) -> void {
+    chunk.m_batch.clear();
+    chunk.m_timestamps.clear();
+    chunk.m_end_pos = begin;
+    chunk.m_error = IRErrorCode::IRErrorCode_Success;
+    auto& encoded_log_event{get_encoded_log_event<encoded_variable_t>(chunk)};
+    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), end};
+    if (clp::ErrorCode_Success != ir_buf.try_seek_from_begin(begin)) {
+        chunk.m_error = IRErrorCode::IRErrorCode_Corrupted_IR;
+        return;
+    }
+    while (chunk.m_end_pos < end) {
+        chunk.m_error = deserialize_next_log_event<encoded_variable_t>(
+                ir_buf,
+                timestamp,
+                encoded_log_event,
+                chunk.m_log_message
+        );
+        if (IRErrorCode::IRErrorCode_Success != chunk.m_error) {
+            return;
+        }
+        if (clp::ErrorCode_Success != ir_buf.try_get_pos(chunk.m_end_pos)) {
+            chunk.m_error = IRErrorCode::IRErrorCode_Decode_Error;
+            return;
+        }
+        chunk.m_batch.add_log_message(chunk.m_log_message);
+        chunk.m_timestamps.push_back(timestamp);
+    }
+}
+
+template <class encoded_variable_t, class owner_t>
+auto get_encoded_log_event(owner_t& owner) -> EncodedLogEventStorage<encoded_variable_t>& {
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        return owner.m_eight_byte_encoded_log_event;
+    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        return owner.m_four_byte_encoded_log_event;
+    } else {
+        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+    }
+}
+
+template <class encoded_variable_t>
+auto deserialize_next_encoded_log_event(
+        BufferReader& ir_buf,
+        Deserializer* deserializer,
+        EncodedLogEventStorage<encoded_variable_t>& log_event
+) -> IRErrorCode {
+    clp::ffi::ir_stream::encoded_tag_t tag{};
+    if (auto const err{deserialize_tag(ir_buf, tag)}; IRErrorCode::IRErrorCode_Success != err) {
+        return err;
+    }
+    if (Eof == tag) {
+        return IRErrorCode::IRErrorCode_Eof;
+    }
+
+    auto& log_message{log_event.m_log_message};
+    log_message.m_logtype.clear();
+    log_message.m_vars.clear();
+    log_event.m_dict_vars.clear();
+    epoch_time_ms_t timestamp_or_timestamp_delta{};
+    if (auto const err{clp::ffi::ir_stream::deserialize_log_event<encoded_variable_t>(
+                ir_buf,
+                tag,
+                log_message.m_logtype,
+                log_message.m_vars,
+                log_event.m_dict_vars,
+                timestamp_or_timestamp_delta
+        )};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return err;
+    }
+    if (false == split_logtype(log_event)) {
+        return IRErrorCode::IRErrorCode_Decode_Error;
+    }
+    log_event.m_vars_decoded = false;
+
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        deserializer->m_timestamp = timestamp_or_timestamp_delta;
+    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        deserializer->m_timestamp += timestamp_or_timestamp_delta;
+    } else {
+        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+    }
+    return IRErrorCode::IRErrorCode_Success;
+}
+
+template <class encoded_variable_t>
+auto skip_next_log_event(BufferReader& ir_buf, Deserializer* deserializer) -> IRErrorCode {
+    constexpr auto cEncodedVarTag{
+            std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>
+                    ? Payload::VarEightByteEncoding
+                    : Payload::VarFourByteEncoding
+    };
+
+    clp::ffi::ir_stream::encoded_tag_t tag{};
+    if (auto const err{deserialize_tag(ir_buf, tag)}; IRErrorCode::IRErrorCode_Success != err) {
+        return err;
+    }
+    if (Eof == tag) {
+        return IRErrorCode::IRErrorCode_Eof;
+    }
+
+    // Skip the variables, which are each either an encoded variable or a
+    // length prefixed dictionary variable, followed by the length prefixed
+    // logtype.
+    bool is_logtype{false};
+    while (false == is_logtype) {
+        is_logtype = Payload::LogtypeStrLenUByte == tag || Payload::LogtypeStrLenUShort == tag
+                     || Payload::LogtypeStrLenInt == tag;
+        size_t num_bytes{0};
+        bool read_length{true};
+        if (cEncodedVarTag == tag) {
+            num_bytes = sizeof(encoded_variable_t);
+        } else if (Payload::VarStrLenUByte == tag || Payload::LogtypeStrLenUByte == tag) {
+            uint8_t length{};
+            read_length = read_int(ir_buf, length);
+            num_bytes = length;
+        } else if (Payload::VarStrLenUShort == tag || Payload::LogtypeStrLenUShort == tag) {
+            uint16_t length{};
+            read_length = read_int(ir_buf, length);
+            num_bytes = length;
+        } else if (Payload::VarStrLenInt == tag || Payload::LogtypeStrLenInt == tag) {
+            int32_t length{};
+            read_length = read_int(ir_buf, length);
+            if (length < 0) {
+                return IRErrorCode::IRErrorCode_Corrupted_IR;
+            }
+            num_bytes = static_cast<size_t>(length);
+        } else {
+            return IRErrorCode::IRErrorCode_Corrupted_IR;
+        }
+        if (false == read_length || false == skip_bytes(ir_buf, num_bytes)
+            || IRErrorCode::IRErrorCode_Success != deserialize_tag(ir_buf, tag))
+        {
+            return IRErrorCode::IRErrorCode_Incomplete_IR;
+        }
+    }
+
+    epoch_time_ms_t timestamp_or_timestamp_delta{};
+    bool read_timestamp{false};
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        if (Payload::TimestampVal != tag) {
+            return IRErrorCode::IRErrorCode_Corrupted_IR;
+        }
+        read_timestamp = read_int(ir_buf, timestamp_or_timestamp_delta);
+    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        if (Payload::TimestampDeltaByte == tag) {
+            int8_t delta{};
+            read_timestamp = read_int(ir_buf, delta);
+            timestamp_or_timestamp_delta = delta;
+        } else if (Payload::TimestampDeltaShort == tag) {
+            int16_t delta{};
+            read_timestamp = read_int(ir_buf, delta);
+            timestamp_or_timestamp_delta = delta;
+        } else if (Payload::TimestampDeltaInt == tag) {
+            int32_t delta{};
+            read_timestamp = read_int(ir_buf, delta);
+            timestamp_or_timestamp_delta = delta;
+        } else {
+            return IRErrorCode::IRErrorCode_Corrupted_IR;
+        }
+    } else {
+        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+    }
+    if (false == read_timestamp) {
+        return IRErrorCode::IRErrorCode_Incomplete_IR;
+    }
+
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        deserializer->m_timestamp = timestamp_or_timestamp_delta;
+    } else {
+        deserializer->m_timestamp += timestamp_or_timestamp_delta;
+    }
+    return IRErrorCode::IRErrorCode_Success;
+}
+
+template <class integer_t>
+auto read_int(BufferReader& ir_buf, integer_t& value) -> bool {
+    std::array<uint8_t, sizeof(integer_t)> bytes{};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (clp::ErrorCode_Success
+        != ir_buf.try_read_exact_length(reinterpret_cast<char*>(bytes.data()), bytes.size()))
+    {
+        return false;
+    }
+    std::make_unsigned_t<integer_t> unsigned_value{0};
+    for (auto const byte : bytes) {
+        unsigned_value = static_cast<std::make_unsigned_t<integer_t>>(
+                (static_cast<uint64_t>(unsigned_value) << 8) | byte
+        );
+    }
+    value = static_cast<integer_t>(unsigned_value);
+    return true;
+}
+
+auto skip_bytes(BufferReader& ir_buf, size_t num_bytes) -> bool {
+    size_t pos{0};
+    if (clp::ErrorCode_Success != ir_buf.try_get_pos(pos)) {
+        return false;
+    }
+    return clp::ErrorCode_Success == ir_buf.try_seek_from_begin(pos + num_bytes);
+}
+
+template <class encoded_variable_t>
+auto split_logtype(EncodedLogEventStorage<encoded_variable_t>& log_event) -> bool {
+    auto const& logtype{log_event.m_log_message.m_logtype};
+    auto& static_text{log_event.m_static_text};
+    auto& end_offsets{log_event.m_static_text_end_offsets};
+    static_text.clear();
+    end_offsets.clear();
+    size_t num_vars{0};
+    size_t num_dict_vars{0};
+    for (size_t i{0}; i < logtype.size(); ++i) {
+        switch (static_cast<VariablePlaceholder>(logtype[i])) {
+            case VariablePlaceholder::Integer:
+            case VariablePlaceholder::Float:
+                ++num_vars;
+                end_offsets.push_back(static_text.size());
+                break;
+            case VariablePlaceholder::Dictionary:
+                if (log_event.m_dict_vars.size() <= num_dict_vars) {
+                    return false;
+                }
+                if (false == log_event.m_dict_vars[num_dict_vars].empty()) {
+                    end_offsets.push_back(static_text.size());
+                }
+                ++num_dict_vars;
+                break;
+            case VariablePlaceholder::Escape:
+                ++i;
+                if (logtype.size() <= i) {
+                    return false;
+                }
+                static_text.push_back(logtype[i]);
+                break;
+            default:
+                static_text.push_back(logtype[i]);
+                break;
+        }
+    }
+    end_offsets.push_back(static_text.size());
+    return num_vars == log_event.m_log_message.m_vars.size()
+           && num_dict_vars == log_event.m_dict_vars.size();
+}
+
+template <class encoded_variable_t>
+auto decode_vars(EncodedLogEventStorage<encoded_variable_t>& log_event) -> void {
+    auto const& logtype{log_event.m_log_message.m_logtype};
+    auto const& vars{log_event.m_log_message.m_vars};
+    auto& decoded_vars{log_event.m_decoded_vars};
+    // Reuse the strings (and their capacity) of the previous log event's
+    // variables.
+    size_t num_decoded_vars{0};
+    for (size_t i{0}; i < logtype.size() && num_decoded_vars < vars.size(); ++i) {
+        auto const placeholder{static_cast<VariablePlaceholder>(logtype[i])};
+        if (VariablePlaceholder::Escape == placeholder) {
+            ++i;
+            continue;
+        }
+        if (VariablePlaceholder::Integer != placeholder
+            && VariablePlaceholder::Float != placeholder)
+        {
+            continue;
+        }
+        if (decoded_vars.size() == num_decoded_vars) {
+            decoded_vars.emplace_back();
+        }
+        auto& decoded_var{decoded_vars[num_decoded_vars]};
+        decoded_var.clear();
+        if (VariablePlaceholder::Integer == placeholder) {
+            append_integer_var(vars[num_decoded_vars], decoded_var);
+        } else {
+            // An invalid float is left empty, as decoding the log message
+            // fails anyway.
+            std::ignore = append_float_var(vars[num_decoded_vars], decoded_var);
+        }
+        ++num_decoded_vars;
+    }
+    decoded_vars.resize(num_decoded_vars);
+    log_event.m_vars_decoded = true;
+}
+
+template <class encoded_variable_t>
+auto decode_log_message(
+        EncodedLogEventStorage<encoded_variable_t>& log_event,
+        ffi_go::LogMessage& log_message
+) -> IRErrorCode {
+    auto const& encoded_log_message{log_event.m_log_message};
+    auto& buffers{log_event.m_decoding_buffers};
+    buffers.m_dict_vars.assign(log_event.m_dict_vars.cbegin(), log_event.m_dict_vars.cend());
+    if (false
+        == decode_message(
+                std::string_view{encoded_log_message.m_logtype},
+                std::span<encoded_variable_t const>{encoded_log_message.m_vars},
+                buffers,
+                log_message
+        ))
+    {
+        return IRErrorCode::IRErrorCode_Decode_Error;
+    }
+    return IRErrorCode::IRErrorCode_Success;
+}
+
+auto get_logtype_match(
+        Deserializer* deserializer,
+        search::CompiledQuery const& compiled_query,
+        std::string const& logtype
+) -> LogtypeMatch const& {
+    auto& cache{deserializer->m_logtype_match_cache};
+    if (cache.m_compiled_query_id != compiled_query.get_id()) {
+        cache.m_matches.clear();
+        cache.m_compiled_query_id = compiled_query.get_id();
+    }
+    if (auto const it{cache.m_matches.find(logtype)}; cache.m_matches.end() != it) {
+        return it->second;
+    }
+    if (LogtypeMatchCache::cMaxSize <= cache.m_matches.size()) {
+        cache.m_matches.clear();
+    }
+    return cache.m_matches.emplace(logtype, classify_logtype(compiled_query, logtype))
+            .first->second;
+}
+
+auto classify_logtype(search::CompiledQuery const& compiled_query, std::string_view logtype)
+        -> LogtypeMatch {
+    std::vector<LogtypeElement> elements;
+    std::vector<std::string> static_text(1);
+    for (size_t i{0}; i < logtype.size(); ++i) {
+        switch (static_cast<VariablePlaceholder>(logtype[i])) {
+            case VariablePlaceholder::Integer:
+            case VariablePlaceholder::Float:
+            case VariablePlaceholder::Dictionary:
+                elements.push_back({logtype[i], true});
+                static_text.emplace_back();
+                break;
+            case VariablePlaceholder::Escape:
+                ++i;
+                if (i < logtype.size()) {
+                    elements.push_back({logtype[i], false});
+                    static_text.back().push_back(logtype[i]);
+                }
+                break;
+            default:
+                elements.push_back({logtype[i], false});
+                static_text.back().push_back(logtype[i]);
+                break;
+        }
+    }
+
+    LogtypeMatch logtype_match{compiled_query.make_candidates(), compiled_query.make_candidates()};
+    for (size_t query_idx{0}; query_idx < compiled_query.size(); ++query_idx) {
+        if (1 == static_text.size()) {
+            if (compiled_query.matches(query_idx, static_text.front())) {
+                search::CompiledQuery::add_candidate(logtype_match.m_possible, query_idx);
+                search::CompiledQuery::add_candidate(logtype_match.m_definite, query_idx);
+            }
+            continue;
+        }
+        auto const& literals{compiled_query.get_literals(query_idx)};
+        bool const case_sensitive{compiled_query.is_case_sensitive(query_idx)};
+        if (std::any_of(literals.cbegin(), literals.cend(), [&](std::string const& literal) {
+                return false == could_occur_in_logtype(literal, case_sensitive, elements);
+            }))
+        {
+            continue;
+        }
+        search::CompiledQuery::add_candidate(logtype_match.m_possible, query_idx);
+        if (compiled_query.matches_ordered_literals(query_idx)
+            && contains_ordered_literals(literals, case_sensitive, static_text))
+        {
+            search::CompiledQuery::add_candidate(logtype_match.m_definite, query_idx);
+        }
+    }
+    return logtype_match;
+}
+
+auto could_occur_in_logtype(
+        std::string_view literal,
+        bool case_sensitive,
+        std::vector<LogtypeElement> const& elements
+) -> bool {
+    // Simulate an NFA over the logtype's elements. before[i] is set if the
+    // literal read so far can end just before elements[i], and inside[i] is
+    // set if it can end inside the variable elements[i]. As the literal may
+    // occur anywhere in a log message, every state is initially reachable.
+    size_t const num_elements{elements.size()};
+    std::vector<bool> before(num_elements + 1, true);
+    std::vector<bool> inside(num_elements);
+    for (size_t i{0}; i < num_elements; ++i) {
+        inside[i] = elements[i].m_is_var;
+    }
+    std::vector<bool> next_before(num_elements + 1);
+    std::vector<bool> next_inside(num_elements);
+    for (char const c : literal) {
+        std::fill(next_before.begin(), next_before.end(), false);
+        std::fill(next_inside.begin(), next_inside.end(), false);
+        bool reachable{false};
+        for (size_t i{0}; i < num_elements; ++i) {
+            auto const& element{elements[i]};
+            if (false == element.m_is_var) {
+                if (before[i] && equals({&element.m_char, 1}, {&c, 1}, case_sensitive)) {
+                    next_before[i + 1] = true;
+                    reachable = true;
+                }
+            } else if ((before[i] || inside[i]) && could_occur_in_var(element.m_char, c)) {
+                next_inside[i] = true;
+                reachable = true;
+            }
+            // A variable may end after any of its characters, and a (possibly
+            // empty) dictionary variable may be skipped entirely.
+            if (element.m_is_var
+                && (next_inside[i]
+                    || (next_before[i]
+                        && VariablePlaceholder::Dictionary
+                                   == static_cast<VariablePlaceholder>(element.m_char))))
+            {
+                next_before[i + 1] = true;
+            }
+        }
+        if (false == reachable) {
+            return false;
+        }
+        before.swap(next_before);
+        inside.swap(next_inside);
+    }
+    return true;
+}
+
+auto could_occur_in_var(char placeholder, char c) -> bool {
+    if (VariablePlaceholder::Dictionary == static_cast<VariablePlaceholder>(placeholder)) {
+        return false == clp::ffi::is_delim(static_cast<signed char>(c));
+    }
+    return is_encoded_var_char(c);
+}
+
+auto contains_ordered_literals(
+        std::vector<std::string> const& literals,
+        bool case_sensitive,
+        std::vector<std::string> const& static_text
+) -> bool {
+    size_t piece_idx{0};
+    size_t pos{0};
+    for (auto const& literal : literals) {
+        while (true) {
+            if (static_text.size() <= piece_idx) {
+                return false;
+            }
+            auto const found_pos{find(static_text[piece_idx], literal, case_sensitive, pos)};
+            if (std::string_view::npos != found_pos) {
+                pos = found_pos + literal.size();
+                break;
+            }
+            ++piece_idx;
+            pos = 0;
+        }
+    }
+    return true;
+}
+
+auto is_empty(search::CompiledQuery::Candidates const& candidates) -> bool {
+    return std::all_of(candidates.cbegin(), candidates.cend(), [](uint64_t word) {
+        return 0 == word;
+    });
+}
+
+template <class encoded_variable_t>
+auto could_match(
+        search::CompiledQuery const& compiled_query,
+        search::CompiledQuery::Candidates const& possible,
+        EncodedLogEventStorage<encoded_variable_t>& log_event
+) -> bool {
+    for (size_t query_idx{0}; query_idx < compiled_query.size(); ++query_idx) {
+        if (false == search::CompiledQuery::is_candidate(possible, query_idx)) {
+            continue;
+        }
+        auto const& literals{compiled_query.get_literals(query_idx)};
+        bool const case_sensitive{compiled_query.is_case_sensitive(query_idx)};
+        if (std::all_of(literals.cbegin(), literals.cend(), [&](std::string const& literal) {
+                return could_occur(literal, case_sensitive, log_event);
+            }))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class encoded_variable_t>
+auto could_occur(
+        std::string_view literal,
+        bool case_sensitive,
+        EncodedLogEventStorage<encoded_variable_t>& log_event
+) -> bool {
+    std::string_view const static_text{log_event.m_static_text};
+    size_t begin{0};
+    for (auto const end : log_event.m_static_text_end_offsets) {
+        if (contains(static_text.substr(begin, end - begin), literal, case_sensitive)) {
+            return true;
+        }
+        begin = end;
+    }
+    for (auto const& dict_var : log_event.m_dict_vars) {
+        if (false == dict_var.empty() && could_overlap(dict_var, literal, case_sensitive)) {
+            return true;
+        }
+    }
+
+    // Decoded encoded variables only contain digits, '-', and '.', so they can
+    // only overlap a literal containing one of them.
+    if (log_event.m_log_message.m_vars.empty()
+        || std::none_of(literal.cbegin(), literal.cend(), is_encoded_var_char))
+    {
+        return false;
+    }
+    if (false == log_event.m_vars_decoded) {
+        decode_vars(log_event);
+    }
+    return std::any_of(
+            log_event.m_decoded_vars.cbegin(),
+            log_event.m_decoded_vars.cend(),
+            [&](std::string const& var) { return could_overlap(var, literal, case_sensitive); }
+    );
+}
+
+auto could_overlap(std::string_view var, std::string_view literal, bool case_sensitive) -> bool {
+    if (contains(var, literal, case_sensitive) || contains(literal, var, case_sensitive)) {
+        return true;
+    }
+    for (size_t size{1}; size < std::min(var.size(), literal.size()); ++size) {
+        if (equals(var.substr(var.size() - size), literal.substr(0, size), case_sensitive)
+            || equals(var.substr(0, size), literal.substr(literal.size() - size), case_sensitive))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto find(std::string_view str, std::string_view substr, bool case_sensitive, size_t pos)
+        -> size_t {
+    if (case_sensitive || str.size() < pos) {
+        return str.find(substr, pos);
+    }
+    auto const it{std::search(
+            str.cbegin() + static_cast<std::ptrdiff_t>(pos),
+            str.cend(),
+            substr.cbegin(),
+            substr.cend(),
+            [](char a, char b) { return fold_case(a) == fold_case(b); }
+    )};
+    if (str.cend() == it) {
+        return std::string_view::npos;
+    }
+    return static_cast<size_t>(it - str.cbegin());
+}
+
+auto contains(std::string_view str, std::string_view substr, bool case_sensitive) -> bool {
+    return std::string_view::npos != find(str, substr, case_sensitive);
+}
+
+auto equals(std::string_view lhs, std::string_view rhs, bool case_sensitive) -> bool {
+    if (case_sensitive) {
+        return lhs == rhs;
+    }
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), [](char a, char b) {
+        return fold_case(a) == fold_case(b);
+    });
+}
+
+template <class encoded_variable_t>
+auto deserialize_log_event(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t* ir_pos,
+        LogEventView* log_event
+) -> int {
+    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_event) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
+    Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const log_message_growth{
+            counters.m_buffer_growths,
+            deserializer->m_log_event.m_log_message
+    };
+
+    if (auto const err{deserialize_next_log_event<encoded_variable_t>(
+                ir_buf,
+                deserializer->m_timestamp,
+                get_encoded_log_event<encoded_variable_t>(*deserializer),
+                deserializer->m_log_event.m_log_message
+        )};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return static_cast<int>(err);
+    }
+
+    size_t pos{0};
+    if (clp::ErrorCode_Success != ir_buf.try_get_pos(pos)) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+    }
+    *ir_pos = pos;
+    log_event->m_log_message.m_data = deserializer->m_log_event.m_log_message.data();
+    log_event->m_log_message.m_size = deserializer->m_log_event.m_log_message.size();
+    log_event->m_timestamp = deserializer->m_timestamp;
+    add_to_counter(counters.m_events_deserialized);
+    add_to_counter(counters.m_messages_decoded);
+    add_to_counter(counters.m_bytes_consumed, pos);
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+auto get_compiled_query(Deserializer* deserializer, MergedWildcardQueryView merged_query)
+        -> search::CompiledQuery const& {
+    if (false == deserializer->m_compiled_query.has_value()
+        || false == deserializer->m_compiled_query->is_compiled_from(merged_query))
+    {
+        deserializer->m_compiled_query.emplace(merged_query);
+    }
+    return deserializer->m_compiled_query.value();
+}
+
+template <class encoded_variable_t>
+auto find_possible_matches(
+        Deserializer* deserializer,
+        search::CompiledQuery const& compiled_query,
+        EncodedLogEventStorage<encoded_variable_t>& encoded_log_event
+) -> LogtypeMatch const* {
+    auto const& logtype_match{get_logtype_match(
+            deserializer,
+            compiled_query,
+            encoded_log_event.m_log_message.m_logtype
+    )};
+    auto const& possible{logtype_match.m_possible};
+    if (is_empty(possible)
+        || (is_empty(logtype_match.m_definite)
+            && false == could_match(compiled_query, possible, encoded_log_event)))
+    {
+        add_to_counter(deserializer->m_counters.m_events_rejected_by_logtype);
+        return nullptr;
+    }
+    return &logtype_match;
+}
+
+template <class encoded_variable_t>
+auto match_log_event(
+        Deserializer* deserializer,
+        search::CompiledQuery const& compiled_query,
+        EncodedLogEventStorage<encoded_variable_t>& encoded_log_event,
+        std::optional<size_t>& matching_query
+) -> IRErrorCode {
+    auto& counters{deserializer->m_counters};
+    matching_query.reset();
+    LogtypeMatch const* logtype_match{nullptr};
+    if (false == compiled_query.empty()) {
+        logtype_match = find_possible_matches(deserializer, compiled_query, encoded_log_event);
+        if (nullptr == logtype_match) {
+            return IRErrorCode::IRErrorCode_Success;
+        }
+    }
+    if (auto const err{
+                decode_log_message(encoded_log_event, deserializer->m_log_event.m_log_message)
+        };
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return err;
+    }
+    add_to_counter(counters.m_messages_decoded);
+    if (nullptr == logtype_match) {
+        matching_query = 0;
+        return IRErrorCode::IRErrorCode_Success;
+    }
+    add_to_counter(counters.m_matcher_invocations);
+    matching_query = compiled_query.find_first_match(
+            deserializer->m_log_event.m_log_message,
+            logtype_match->m_possible,
+            logtype_match->m_definite,
+            deserializer->m_match_candidates
+    );
+    return IRErrorCode::IRErrorCode_Success;
+}
+
+auto get_logtype_id(Deserializer* deserializer, std::string const& logtype) -> int64_t {
+    auto& logtype_ids{deserializer->m_logtype_ids};
+    if (auto const it{logtype_ids.find(logtype)}; logtype_ids.end() != it) {
+        return it->second;
+    }
+    auto const id{static_cast<int64_t>(logtype_ids.size())};
+    logtype_ids.emplace(logtype, id);
+    return id;
+}
+
+template <class encoded_variable_t, class log_event_handler_t>
+auto scan_time_interval(
+        BufferReader& ir_buf,
+        Deserializer* deserializer,
+        TimestampInterval time_interval,
+        size_t* ir_pos,
+        log_event_handler_t on_log_event
+) -> int {
+    auto& encoded_log_event{get_encoded_log_event<encoded_variable_t>(*deserializer)};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const logtype_growth{
+            counters.m_buffer_growths,
+            encoded_log_event.m_log_message.m_logtype
+    };
+
+    while (true) {
+        size_t event_pos{0};
+        if (clp::ErrorCode_Success != ir_buf.try_get_pos(event_pos)) {
+            return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+        }
+        // Report the log events consumed so far if the stream or buffer ends
+        // (part way through a log event), or the time interval ends, so they
+        // are not deserialized again.
+        auto const return_err{[&](int err) -> int {
+            if (static_cast<int>(IRErrorCode::IRErrorCode_Eof) == err
+                || static_cast<int>(IRErrorCode::IRErrorCode_Incomplete_IR) == err
+                || cEndOfTimeInterval == err)
+            {
+                *ir_pos = event_pos;
+                add_to_counter(counters.m_bytes_consumed, event_pos);
+            }
+            return err;
+        }};
+
+        // While the previous log event is before the time interval (e.g. when
+        // seeking forward in a time ordered stream), only deserialize the
+        // timestamp of each log event. If a log event turns out not to be
+        // before the time interval, rewind to deserialize it fully.
+        if (time_interval.m_lower > deserializer->m_timestamp) {
+            auto const prev_timestamp{deserializer->m_timestamp};
+            if (auto const err{skip_next_log_event<encoded_variable_t>(ir_buf, deserializer)};
+                IRErrorCode::IRErrorCode_Success != err)
+            {
+                return return_err(err);
+            }
+            if (time_interval.m_lower > deserializer->m_timestamp) {
+                add_to_counter(counters.m_events_deserialized);
+                add_to_counter(counters.m_events_skipped_by_time);
+                continue;
+            }
+            deserializer->m_timestamp = prev_timestamp;
+            if (clp::ErrorCode_Success != ir_buf.try_seek_from_begin(event_pos)) {
+                return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+            }
+        }
+
+        auto const prev_timestamp{deserializer->m_timestamp};
+        if (auto const err{deserialize_next_encoded_log_event<encoded_variable_t>(
+                    ir_buf,
+                    deserializer,
+                    encoded_log_event
+            )};
+            IRErrorCode::IRErrorCode_Success != err)
+        {
+            return return_err(err);
+        }
+        if (time_interval.m_upper <= deserializer->m_timestamp) {
+            // Leave the log event unconsumed, so that a search with a later
+            // time interval resumes from it.
+            deserializer->m_timestamp = prev_timestamp;
+            return return_err(cEndOfTimeInterval);
+        }
+        add_to_counter(counters.m_events_deserialized);
+
+        if (time_interval.m_lower > deserializer->m_timestamp) {
+            add_to_counter(counters.m_events_skipped_by_time);
+            continue;
+        }
+        if (std::optional<int> const ret{on_log_event()}; ret.has_value()) {
+            return ret.value();
+        }
+    }
+}
+
+template <class encoded_variable_t>
+auto deserialize_wildcard_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        search::CompiledQuery const& compiled_query,
+        size_t* ir_pos,
+        LogEventView* log_event,
+        size_t* matching_query
+) -> int {
+    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_event
+        || nullptr == matching_query)
+    {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
+    Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
+    auto& encoded_log_event{get_encoded_log_event<encoded_variable_t>(*deserializer)};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const log_message_growth{
+            counters.m_buffer_growths,
+            deserializer->m_log_event.m_log_message
+    };
+
+    return scan_time_interval<encoded_variable_t>(
+            ir_buf,
+            deserializer,
+            time_interval,
+            ir_pos,
+            [&]() -> std::optional<int> {
+                std::optional<size_t> matching_query_idx;
+                if (auto const err{match_log_event(
+                            deserializer,
+                            compiled_query,
+                            encoded_log_event,
+                            matching_query_idx
+                    )};
+                    IRErrorCode::IRErrorCode_Success != err)
+                {
+                    return static_cast<int>(err);
+                }
+                if (false == matching_query_idx.has_value()) {
+                    return std::nullopt;
+                }
+                size_t curr_ir_pos{0};
+                if (clp::ErrorCode_Success != ir_buf.try_get_pos(curr_ir_pos)) {
+                    return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+                }
+                *ir_pos = curr_ir_pos;
+                add_to_counter(counters.m_bytes_consumed, curr_ir_pos);
+                auto const& log_message{deserializer->m_log_event.m_log_message};
+                log_event->m_log_message.m_data = log_message.data();
+                log_event->m_log_message.m_size = log_message.size();
+                log_event->m_timestamp = deserializer->m_timestamp;
+                *matching_query = matching_query_idx.value();
+                return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+            }
+    );
+}
+
+auto get_numeric_query_variables(
+        Deserializer* deserializer,
+        search::NumericQuery const& numeric_query,
+        std::string const& logtype
+) -> std::optional<search::NumericQuery::VariableRefs> const& {
+    auto& cache{deserializer->m_numeric_query_cache};
+    if (cache.m_numeric_query_id != numeric_query.get_id()) {
+        cache.m_variables.clear();
+        cache.m_numeric_query_id = numeric_query.get_id();
+    }
+    if (auto const it{cache.m_variables.find(logtype)}; cache.m_variables.end() != it) {
+        return it->second;
+    }
+    if (NumericQueryCache::cMaxSize <= cache.m_variables.size()) {
+        cache.m_variables.clear();
+    }
+    return cache.m_variables.emplace(logtype, numeric_query.resolve_logtype(logtype))
+            .first->second;
+}
+
+template <class encoded_variable_t>
+auto deserialize_numeric_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        search::NumericQuery const& numeric_query,
+        size_t* ir_pos,
+        LogEventView* log_event
+) -> int {
+    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_event) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
+    Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
+    auto& encoded_log_event{get_encoded_log_event<encoded_variable_t>(*deserializer)};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const log_message_growth{
+            counters.m_buffer_growths,
+            deserializer->m_log_event.m_log_message
+    };
+
+    return scan_time_interval<encoded_variable_t>(
+            ir_buf,
+            deserializer,
+            time_interval,
+            ir_pos,
+            [&]() -> std::optional<int> {
+                auto const& log_message{encoded_log_event.m_log_message};
+                auto const& variables{get_numeric_query_variables(
+                        deserializer,
+                        numeric_query,
+                        log_message.m_logtype
+                )};
+                if (false == variables.has_value()) {
+                    add_to_counter(counters.m_events_rejected_by_logtype);
+                    return std::nullopt;
+                }
+                // The predicates are evaluated on the encoded variables, so
+                // only matching log messages are decoded.
+                add_to_counter(counters.m_matcher_invocations);
+                if (false
+                    == numeric_query.matches(
+                            variables.value(),
+                            std::span<encoded_variable_t const>{log_message.m_vars},
+                            std::span<std::string const>{encoded_log_event.m_dict_vars}
+                    ))
+                {
+                    return std::nullopt;
+                }
+                if (auto const err{decode_log_message(
+                            encoded_log_event,
+                            deserializer->m_log_event.m_log_message
+                    )};
+                    IRErrorCode::IRErrorCode_Success != err)
+                {
+                    return static_cast<int>(err);
+                }
+                add_to_counter(counters.m_messages_decoded);
+
+                size_t curr_ir_pos{0};
+                if (clp::ErrorCode_Success != ir_buf.try_get_pos(curr_ir_pos)) {
+                    return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+                }
+                *ir_pos = curr_ir_pos;
+                add_to_counter(counters.m_bytes_consumed, curr_ir_pos);
+                auto const& decoded_message{deserializer->m_log_event.m_log_message};
+                log_event->m_log_message.m_data = decoded_message.data();
+                log_event->m_log_message.m_size = decoded_message.size();
+                log_event->m_timestamp = deserializer->m_timestamp;
+                return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+            }
+    );
+}
+
+template <class encoded_variable_t>
+auto count_matches(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        epoch_time_ms_t bucket_width,
+        void* compiled_query,
+        size_t* ir_pos,
+        Int64tSpan counts
+) -> int {
+    if (nullptr == ir_deserializer || nullptr == compiled_query || nullptr == ir_pos
+        || time_interval.m_lower >= time_interval.m_upper || 0 >= bucket_width)
+    {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    auto const& query{*static_cast<search::CompiledQuery const*>(compiled_query)};
+    // Computed as unsigned, as the interval may be wider than INT64_MAX.
+    auto const interval_width{
+            static_cast<uint64_t>(time_interval.m_upper)
+            - static_cast<uint64_t>(time_interval.m_lower)
+    };
+    auto const unsigned_bucket_width{static_cast<uint64_t>(bucket_width)};
+    auto const num_buckets{(interval_width - 1) / unsigned_bucket_width + 1};
+    if (query.empty() || counts.m_size / query.size() != num_buckets
+        || 0 != counts.m_size % query.size())
+    {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
+    Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
+    auto& encoded_log_event{get_encoded_log_event<encoded_variable_t>(*deserializer)};
+    auto& matching_queries{deserializer->m_match_candidates};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const log_message_growth{
+            counters.m_buffer_growths,
+            deserializer->m_log_event.m_log_message
+    };
+    std::span<int64_t> const count_matrix{counts.m_data, counts.m_size};
+
+    return scan_time_interval<encoded_variable_t>(
+            ir_buf,
+            deserializer,
+            time_interval,
+            ir_pos,
+            [&]() -> std::optional<int> {
+                auto const* logtype_match{
+                        find_possible_matches(deserializer, query, encoded_log_event)
+                };
+                if (nullptr == logtype_match) {
+                    return std::nullopt;
+                }
+                // The log message only needs to be decoded if the logtype
+                // leaves any possible match undecided.
+                auto const& possible{logtype_match->m_possible};
+                auto const& definite{logtype_match->m_definite};
+                if (std::equal(possible.cbegin(), possible.cend(), definite.cbegin())) {
+                    matching_queries = definite;
+                } else {
+                    if (auto const err{decode_log_message(
+                                encoded_log_event,
+                                deserializer->m_log_event.m_log_message
+                        )};
+                        IRErrorCode::IRErrorCode_Success != err)
+                    {
+                        return static_cast<int>(err);
+                    }
+                    add_to_counter(counters.m_messages_decoded);
+                    add_to_counter(counters.m_matcher_invocations);
+                    query.find_all_matches(
+                            deserializer->m_log_event.m_log_message,
+                            possible,
+                            definite,
+                            matching_queries
+                    );
+                }
+                auto const bucket{
+                        (static_cast<uint64_t>(deserializer->m_timestamp)
+                         - static_cast<uint64_t>(time_interval.m_lower))
+                        / unsigned_bucket_width
+                };
+                for (size_t query_idx{0}; query_idx < query.size(); ++query_idx) {
+                    if (search::CompiledQuery::is_candidate(matching_queries, query_idx)) {
+                        ++count_matrix[query_idx * num_buckets + bucket];
+                    }
+                }
+                return std::nullopt;
+            }
+    );
+}
+
 template <class encoded_variable_t>
-auto deserialize_log_event(
+auto deserialize_log_events_batch(
         ByteSpan ir_view,
         void* ir_deserializer,
+        size_t max_bytes,
         size_t* ir_pos,
-        LogEventView* log_event
+        LogEventViewSpan log_events,
+        size_t* num_events
 ) -> int {
-    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_event) {
+    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == num_events
+        || nullptr == log_events.m_data)
+    {
         return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
     }
     BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
     Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
+    auto& batch{deserializer->m_log_event_batch};
+    batch.clear();
+    std::span<LogEventView> const events{log_events.m_data, log_events.m_size};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const log_message_growth{
+            counters.m_buffer_growths,
+            deserializer->m_log_event.m_log_message
+    };
+    GrowthCounter const arena_growth{counters.m_buffer_growths, batch.m_log_messages};
+    GrowthCounter const end_offsets_growth{counters.m_buffer_growths, batch.m_end_offsets};
 
-    clp::ffi::ir_stream::encoded_tag_t tag{};
-    if (auto const err{deserialize_tag(ir_buf, tag)}; IRErrorCode::IRErrorCode_Success != err) {
-        return static_cast<int>(err);
-    }
-    if (Eof == tag) {
-        return static_cast<int>(IRErrorCode::IRErrorCode_Eof);
-    }
-
-    IRErrorCode err{};
-    epoch_time_ms_t timestamp{};
-    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
-        err = clp::ffi::ir_stream::eight_byte_encoding::deserialize_log_event(
-                ir_buf,
-                tag,
-                deserializer->m_log_event.m_log_message,
-                timestamp
-        );
-    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
-        epoch_time_ms_t timestamp_delta{};
-        err = clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event(
+    // The position and error of the last complete (or failed) log event. Any
+    // error after the first log event is deferred to the next call so that
+    // the log events already deserialized are returned.
+    size_t pos{0};
+    IRErrorCode err{IRErrorCode::IRErrorCode_Success};
+    size_t num_deserialized{0};
+    for (; num_deserialized < events.size(); ++num_deserialized) {
+        err = deserialize_next_log_event<encoded_variable_t>(
                 ir_buf,
-                tag,
-                deserializer->m_log_event.m_log_message,
-                timestamp_delta
+                deserializer->m_timestamp,
+                get_encoded_log_event<encoded_variable_t>(*deserializer),
+                deserializer->m_log_event.m_log_message
         );
-        timestamp = deserializer->m_timestamp + timestamp_delta;
-    } else {
-        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+        if (IRErrorCode::IRErrorCode_Success != err) {
+            break;
+        }
+        if (clp::ErrorCode_Success != ir_buf.try_get_pos(pos)) {
+            return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+        }
+        batch.add_log_message(deserializer->m_log_event.m_log_message);
+        events[num_deserialized].m_timestamp = deserializer->m_timestamp;
+        if (0 != max_bytes && pos >= max_bytes) {
+            ++num_deserialized;
+            break;
+        }
     }
-    if (IRErrorCode::IRErrorCode_Success != err) {
+    if (0 == num_deserialized) {
         return static_cast<int>(err);
     }
-    deserializer->m_timestamp = timestamp;
 
-    size_t pos{0};
-    if (clp::ErrorCode_Success != ir_buf.try_get_pos(pos)) {
-        return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+    // The arena may reallocate while growing, so the views can only be set once
+    // every log message has been added.
+    size_t begin_offset{0};
+    for (size_t i{0}; i < num_deserialized; ++i) {
+        size_t const end_offset{batch.m_end_offsets[i]};
+        events[i].m_log_message.m_data = batch.m_log_messages.data() + begin_offset;
+        events[i].m_log_message.m_size = end_offset - begin_offset;
+        begin_offset = end_offset;
     }
     *ir_pos = pos;
-    log_event->m_log_message.m_data = deserializer->m_log_event.m_log_message.data();
-    log_event->m_log_message.m_size = deserializer->m_log_event.m_log_message.size();
-    log_event->m_timestamp = deserializer->m_timestamp;
+    *num_events = num_deserialized;
+    add_to_counter(counters.m_events_deserialized, num_deserialized);
+    add_to_counter(counters.m_messages_decoded, num_deserialized);
+    add_to_counter(counters.m_bytes_consumed, pos);
     return static_cast<int>(IRErrorCode::IRErrorCode_Success);
 }
 
+auto get_max_parallel_threads() -> size_t {
+    static size_t const max_threads{std::clamp(
+            static_cast<size_t>(std::thread::hardware_concurrency()),
+            size_t{1},
+            cMaxParallelThreads
+    )};
+    return max_threads;
+}
+
 template <class encoded_variable_t>
-auto deserialize_wildcard_match(
+auto deserialize_log_events_parallel(
         ByteSpan ir_view,
         void* ir_deserializer,
-        TimestampInterval time_interval,
-        MergedWildcardQueryView merged_query,
+        SizetSpan chunk_offsets,
+        Int64tSpan chunk_timestamps,
         size_t* ir_pos,
-        LogEventView* log_event,
-        size_t* matching_query
+        LogEventViewSpan* log_events
 ) -> int {
-    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_event
-        || nullptr == matching_query)
+    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_events
+        || chunk_offsets.m_size != chunk_timestamps.m_size)
     {
         return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
     }
-    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
+    if (0 == ir_view.m_size) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Incomplete_IR);
+    }
     Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
-    std::string_view const query_view{merged_query.m_queries.m_data, merged_query.m_queries.m_size};
-    std::span<size_t> const end_offsets{
-            merged_query.m_end_offsets.m_data,
-            merged_query.m_end_offsets.m_size
-    };
-    std::span<bool> const case_sensitivity{
-            merged_query.m_case_sensitivity.m_data,
-            merged_query.m_case_sensitivity.m_size
+    std::span<size_t const> const offsets{chunk_offsets.m_data, chunk_offsets.m_size};
+    std::span<epoch_time_ms_t const> const timestamps{
+            chunk_timestamps.m_data,
+            chunk_timestamps.m_size
     };
+    size_t prev_offset{0};
+    for (auto const offset : offsets) {
+        if (offset <= prev_offset || ir_view.m_size < offset) {
+            return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+        }
+        prev_offset = offset;
+    }
 
-    std::vector<std::pair<std::string_view, bool>> queries(merged_query.m_end_offsets.m_size);
-    size_t pos{0};
-    for (size_t i{0}; i < merged_query.m_end_offsets.m_size; i++) {
-        auto& [query_str_view, is_case_sensitive]{queries[i]};
-        query_str_view = query_view.substr(pos, end_offsets[i]);
-        is_case_sensitive = case_sensitivity[i];
-        pos += end_offsets[i];
-    }
-
-    std::function<std::pair<bool, size_t>(ffi_go::LogMessage const&)> query_fn;
-    if (false == queries.empty()) {
-        query_fn = [&](ffi_go::LogMessage const& log_message) -> std::pair<bool, size_t> {
-            auto const found_query = std::find_if(
-                    queries.cbegin(),
-                    queries.cend(),
-                    [&](std::pair<std::string_view, bool> const& query) -> bool {
-                        return clp::string_utils::wildcard_match_unsafe(
-                                log_message,
-                                query.first,
-                                query.second
-                        );
-                    }
+    // Chunk i spans [offsets[i - 1], offsets[i]), with the first chunk
+    // beginning at the start of ir_view and the last ending at its end. The
+    // calling thread and up to get_max_parallel_threads() - 1 other threads claim
+    // the chunks in order until none are left, so the number of threads
+    // doesn't grow with the number of chunks.
+    auto& chunks{deserializer->m_log_event_chunks};
+    auto& views{deserializer->m_log_event_chunk_views};
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const chunks_growth{counters.m_buffer_growths, chunks};
+    GrowthCounter const views_growth{counters.m_buffer_growths, views};
+    size_t const num_chunks{offsets.size() + 1};
+    chunks.resize(num_chunks);
+    epoch_time_ms_t const first_timestamp{deserializer->m_timestamp};
+    std::atomic<size_t> next_chunk{0};
+    auto const deserialize_chunks{[&] {
+        for (size_t i{next_chunk++}; i < num_chunks; i = next_chunk++) {
+            deserialize_log_event_chunk<encoded_variable_t>(
+                    ir_view,
+                    0 == i ? 0 : offsets[i - 1],
+                    num_chunks - 1 == i ? ir_view.m_size : offsets[i],
+                    0 == i ? first_timestamp : timestamps[i - 1],
+                    chunks[i]
             );
-            return {queries.cend() != found_query, found_query - queries.cbegin()};
-        };
-    } else {
-        query_fn = [](ffi_go::LogMessage const&) -> std::pair<bool, size_t> { return {true, 0}; };
+        }
+    }};
+    std::vector<std::thread> threads;
+    try {
+        size_t const num_threads{std::min(num_chunks, get_max_parallel_threads()) - 1};
+        threads.reserve(num_threads);
+        for (size_t i{0}; i < num_threads; ++i) {
+            threads.emplace_back(deserialize_chunks);
+        }
+    } catch (std::exception const&) {
+        // The threads already started (if any) and the calling thread
+        // deserialize every chunk regardless.
+    }
+    deserialize_chunks();
+    for (auto& thread : threads) {
+        thread.join();
     }
 
-    IRErrorCode err{};
-    while (true) {
-        clp::ffi::ir_stream::encoded_tag_t tag{};
-        if (err = deserialize_tag(ir_buf, tag); IRErrorCode::IRErrorCode_Success != err) {
-            return static_cast<int>(err);
+    // Return the log events in stream order, up to the first chunk ending
+    // early. As in ir_deserializer_deserialize_*_log_events_batch, an error is
+    // deferred to the next call if any log events were deserialized.
+    views.clear();
+    size_t pos{0};
+    IRErrorCode err{IRErrorCode::IRErrorCode_Success};
+    for (auto const& chunk : chunks) {
+        auto const& batch{chunk.m_batch};
+        size_t begin_offset{0};
+        for (size_t i{0}; i < chunk.m_timestamps.size(); ++i) {
+            size_t const end_offset{batch.m_end_offsets[i]};
+            views.push_back(
+                    {{batch.m_log_messages.data() + begin_offset, end_offset - begin_offset},
+                     chunk.m_timestamps[i]}
+            );
+            begin_offset = end_offset;
         }
-        if (Eof == tag) {
-            return static_cast<int>(IRErrorCode::IRErrorCode_Eof);
+        if (false == chunk.m_timestamps.empty()) {
+            pos = chunk.m_end_pos;
+            deserializer->m_timestamp = chunk.m_timestamps.back();
         }
+        if (IRErrorCode::IRErrorCode_Success != chunk.m_error) {
+            err = chunk.m_error;
+            break;
+        }
+    }
+    if (views.empty()) {
+        return static_cast<int>(
+                IRErrorCode::IRErrorCode_Success == err ? IRErrorCode::IRErrorCode_Corrupted_IR
+                                                        : err
+        );
+    }
+    *ir_pos = pos;
+    *log_events = {views.data(), views.size()};
+    add_to_counter(counters.m_events_deserialized, views.size());
+    add_to_counter(counters.m_messages_decoded, views.size());
+    add_to_counter(counters.m_bytes_consumed, pos);
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+template <class encoded_variable_t>
+auto deserialize_log_event_columns(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_events,
+        size_t max_bytes,
+        void* compiled_query,
+        bool logtype_ids,
+        size_t* ir_pos,
+        LogEventColumns* log_event_columns
+) -> int {
+    if (nullptr == ir_deserializer || nullptr == ir_pos || nullptr == log_event_columns) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    BufferReader ir_buf{static_cast<char const*>(ir_view.m_data), ir_view.m_size};
+    Deserializer* deserializer{static_cast<Deserializer*>(ir_deserializer)};
+    auto const* query{static_cast<search::CompiledQuery const*>(compiled_query)};
+    auto& encoded_log_event{get_encoded_log_event<encoded_variable_t>(*deserializer)};
+    auto& log_message{deserializer->m_log_event.m_log_message};
+    auto& columns{deserializer->m_log_event_columns};
+    columns.clear();
+    auto& counters{deserializer->m_counters};
+    GrowthCounter const log_message_growth{counters.m_buffer_growths, log_message};
+    GrowthCounter const message_data_growth{counters.m_buffer_growths, columns.m_message_data};
+    GrowthCounter const message_offsets_growth{
+            counters.m_buffer_growths,
+            columns.m_message_offsets
+    };
 
-        epoch_time_ms_t timestamp{};
-        if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
-            err = clp::ffi::ir_stream::eight_byte_encoding::deserialize_log_event(
+    // Each log message is decoded into the log event storage and appended to
+    // the data column, so that once the columns have grown to fit a typical
+    // batch no further allocations are made. As in
+    // ir_deserializer_deserialize_*_log_events_batch, any error after the first
+    // log event is deferred to the next call.
+    size_t pos{0};
+    size_t num_deserialized{0};
+    IRErrorCode err{IRErrorCode::IRErrorCode_Success};
+    while (columns.size() < max_events) {
+        std::optional<size_t> matching_query{0};
+        if (nullptr == query) {
+            err = deserialize_next_log_event<encoded_variable_t>(
                     ir_buf,
-                    tag,
-                    deserializer->m_log_event.m_log_message,
-                    timestamp
+                    deserializer->m_timestamp,
+                    encoded_log_event,
+                    log_message
             );
-        } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
-            epoch_time_ms_t timestamp_delta{};
-            err = clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event(
+        } else {
+            err = deserialize_next_encoded_log_event<encoded_variable_t>(
                     ir_buf,
-                    tag,
-                    deserializer->m_log_event.m_log_message,
-                    timestamp_delta
+                    deserializer,
+                    encoded_log_event
             );
-            timestamp = deserializer->m_timestamp + timestamp_delta;
-        } else {
-            static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+            if (IRErrorCode::IRErrorCode_Success == err) {
+                err = match_log_event(deserializer, *query, encoded_log_event, matching_query);
+            }
         }
         if (IRErrorCode::IRErrorCode_Success != err) {
-            return static_cast<int>(err);
-        }
-        deserializer->m_timestamp = timestamp;
-
-        if (time_interval.m_upper <= deserializer->m_timestamp) {
-            // TODO this is an extremely fragile hack until the CLP ffi ir
-            // code is refactored and IRErrorCode includes things beyond
-            // decoding.
-            return static_cast<int>(IRErrorCode::IRErrorCode_Incomplete_IR + 1);
+            break;
         }
-        if (time_interval.m_lower > deserializer->m_timestamp) {
-            continue;
+        if (clp::ErrorCode_Success != ir_buf.try_get_pos(pos)) {
+            return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
         }
-        auto const [has_matching_query, matching_query_idx]{
-                query_fn(deserializer->m_log_event.m_log_message)
-        };
-        if (false == has_matching_query) {
-            continue;
+        ++num_deserialized;
+        if (matching_query.has_value()) {
+            columns.m_timestamps.push_back(deserializer->m_timestamp);
+            columns.m_message_data.append(log_message);
+            auto const message_end{static_cast<int64_t>(columns.m_message_data.size())};
+            columns.m_message_offsets.push_back(message_end);
+            if (logtype_ids) {
+                columns.m_logtype_ids.push_back(
+                        get_logtype_id(deserializer, encoded_log_event.m_log_message.m_logtype)
+                );
+            }
+            if (nullptr != query) {
+                columns.m_matching_queries.push_back(static_cast<int64_t>(matching_query.value()));
+            }
         }
-        size_t curr_ir_pos{0};
-        if (clp::ErrorCode_Success != ir_buf.try_get_pos(curr_ir_pos)) {
-            return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+        if (0 != max_bytes && pos >= max_bytes) {
+            break;
         }
-        *ir_pos = curr_ir_pos;
-        log_event->m_log_message.m_data = deserializer->m_log_event.m_log_message.data();
-        log_event->m_log_message.m_size = deserializer->m_log_event.m_log_message.size();
-        log_event->m_timestamp = deserializer->m_timestamp;
-        *matching_query = matching_query_idx;
-        return static_cast<int>(IRErrorCode::IRErrorCode_Success);
     }
+    if (0 == num_deserialized && IRErrorCode::IRErrorCode_Success != err) {
+        return static_cast<int>(err);
+    }
+
+    *ir_pos = pos;
+    *log_event_columns
+            = {{columns.m_timestamps.data(), columns.m_timestamps.size()},
+               {columns.m_message_offsets.data(), columns.m_message_offsets.size()},
+               {columns.m_message_data.data(), columns.m_message_data.size()},
+               {columns.m_logtype_ids.data(), columns.m_logtype_ids.size()},
+               {columns.m_matching_queries.data(), columns.m_matching_queries.size()}};
+    add_to_counter(counters.m_events_deserialized, num_deserialized);
+    if (nullptr == query) {
+        add_to_counter(counters.m_messages_decoded, num_deserialized);
+    }
+    add_to_counter(counters.m_bytes_consumed, pos);
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
 }
 }  // namespace
 
@@ -315,6 +2001,122 @@ CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_log_event(
     );
 }
 
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_log_events_batch(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_bytes,
+        size_t* ir_pos,
+        LogEventViewSpan log_events,
+        size_t* num_events
+) -> int {
+    return deserialize_log_events_batch<eight_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            max_bytes,
+            ir_pos,
+            log_events,
+            num_events
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_log_events_batch(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_bytes,
+        size_t* ir_pos,
+        LogEventViewSpan log_events,
+        size_t* num_events
+) -> int {
+    return deserialize_log_events_batch<four_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            max_bytes,
+            ir_pos,
+            log_events,
+            num_events
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_log_events_parallel(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        SizetSpan chunk_offsets,
+        Int64tSpan chunk_timestamps,
+        size_t* ir_pos,
+        LogEventViewSpan* log_events
+) -> int {
+    return deserialize_log_events_parallel<eight_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            chunk_offsets,
+            chunk_timestamps,
+            ir_pos,
+            log_events
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_log_events_parallel(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        SizetSpan chunk_offsets,
+        Int64tSpan chunk_timestamps,
+        size_t* ir_pos,
+        LogEventViewSpan* log_events
+) -> int {
+    return deserialize_log_events_parallel<four_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            chunk_offsets,
+            chunk_timestamps,
+            ir_pos,
+            log_events
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_log_event_columns(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_events,
+        size_t max_bytes,
+        void* compiled_query,
+        bool logtype_ids,
+        size_t* ir_pos,
+        LogEventColumns* columns
+) -> int {
+    return deserialize_log_event_columns<eight_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            max_events,
+            max_bytes,
+            compiled_query,
+            logtype_ids,
+            ir_pos,
+            columns
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_log_event_columns(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_events,
+        size_t max_bytes,
+        void* compiled_query,
+        bool logtype_ids,
+        size_t* ir_pos,
+        LogEventColumns* columns
+) -> int {
+    return deserialize_log_event_columns<four_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            max_events,
+            max_bytes,
+            compiled_query,
+            logtype_ids,
+            ir_pos,
+            columns
+    );
+}
+
 CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_wildcard_match(
         ByteSpan ir_view,
         void* ir_deserializer,
@@ -324,11 +2126,14 @@ CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_wildcard_match(
         LogEventView* log_event,
         size_t* matching_query
 ) -> int {
+    if (nullptr == ir_deserializer) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
     return deserialize_wildcard_match<eight_byte_encoded_variable_t>(
             ir_view,
             ir_deserializer,
             time_interval,
-            merged_query,
+            get_compiled_query(static_cast<Deserializer*>(ir_deserializer), merged_query),
             ir_pos,
             log_event,
             matching_query
@@ -344,14 +2149,158 @@ CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_wildcard_match(
         LogEventView* log_event,
         size_t* matching_query
 ) -> int {
+    if (nullptr == ir_deserializer) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    return deserialize_wildcard_match<four_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            time_interval,
+            get_compiled_query(static_cast<Deserializer*>(ir_deserializer), merged_query),
+            ir_pos,
+            log_event,
+            matching_query
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_compiled_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* compiled_query,
+        size_t* ir_pos,
+        LogEventView* log_event,
+        size_t* matching_query
+) -> int {
+    if (nullptr == compiled_query) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    return deserialize_wildcard_match<eight_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            time_interval,
+            *static_cast<search::CompiledQuery const*>(compiled_query),
+            ir_pos,
+            log_event,
+            matching_query
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_compiled_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* compiled_query,
+        size_t* ir_pos,
+        LogEventView* log_event,
+        size_t* matching_query
+) -> int {
+    if (nullptr == compiled_query) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
     return deserialize_wildcard_match<four_byte_encoded_variable_t>(
             ir_view,
             ir_deserializer,
             time_interval,
-            merged_query,
+            *static_cast<search::CompiledQuery const*>(compiled_query),
             ir_pos,
             log_event,
             matching_query
     );
 }
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_eight_byte_numeric_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* numeric_query,
+        size_t* ir_pos,
+        LogEventView* log_event
+) -> int {
+    if (nullptr == numeric_query) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    return deserialize_numeric_query_match<eight_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            time_interval,
+            *static_cast<search::NumericQuery const*>(numeric_query),
+            ir_pos,
+            log_event
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_deserialize_four_byte_numeric_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* numeric_query,
+        size_t* ir_pos,
+        LogEventView* log_event
+) -> int {
+    if (nullptr == numeric_query) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    return deserialize_numeric_query_match<four_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            time_interval,
+            *static_cast<search::NumericQuery const*>(numeric_query),
+            ir_pos,
+            log_event
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_eight_byte_count_matches(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        epoch_time_ms_t bucket_width,
+        void* compiled_query,
+        size_t* ir_pos,
+        Int64tSpan counts
+) -> int {
+    return count_matches<eight_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            time_interval,
+            bucket_width,
+            compiled_query,
+            ir_pos,
+            counts
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_deserializer_four_byte_count_matches(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        epoch_time_ms_t bucket_width,
+        void* compiled_query,
+        size_t* ir_pos,
+        Int64tSpan counts
+) -> int {
+    return count_matches<four_byte_encoded_variable_t>(
+            ir_view,
+            ir_deserializer,
+            time_interval,
+            bucket_width,
+            compiled_query,
+            ir_pos,
+            counts
+    );
+}
+
+CLP_FFI_GO_METHOD auto
+ir_deserializer_get_counters(void* ir_deserializer, DeserializerCounters* counters) -> int {
+    if (nullptr == counters) {
+        return 0;
+    }
+    if (nullptr == ir_deserializer) {
+        *counters = {};
+        return 0;
+    }
+    *counters = static_cast<Deserializer*>(ir_deserializer)->m_counters;
+    return cCountersEnabled ? 1 : 0;
+}
 }  // namespace ffi_go::ir
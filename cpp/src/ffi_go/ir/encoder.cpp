@@ -44,33 +44,34 @@ auto encode_log_message(
     Encoder<encoded_var_t>* encoder{static_cast<Encoder<encoded_var_t>*>(ir_encoder)};
     auto& ir_log_msg{encoder->m_log_message};
     ir_log_msg.reserve(log_message.m_size);
+    ir_log_msg.m_dict_vars.clear();
+    ir_log_msg.m_dict_var_end_offsets.clear();
+    auto& dict_var_bounds{encoder->m_dict_var_bounds};
+    dict_var_bounds.clear();
 
     std::string_view const log_msg_view{log_message.m_data, log_message.m_size};
-    std::vector<int32_t> dict_var_offsets;
     if (false
         == clp::ffi::encode_message<encoded_var_t>(
                 log_msg_view,
                 ir_log_msg.m_logtype,
                 ir_log_msg.m_vars,
-                dict_var_offsets
+                dict_var_bounds
         ))
     {
         return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
     }
 
-    // dict_var_offsets contains begin_pos followed by end_pos of each
+    // dict_var_bounds contains begin_pos followed by end_pos of each
     // dictionary variable in the message
-    int32_t prev_end_off{0};
-    for (size_t i = 0; i < dict_var_offsets.size(); i += 2) {
-        int32_t const begin_pos{dict_var_offsets[i]};
-        int32_t const end_pos{dict_var_offsets[i + 1]};
+    for (size_t i = 0; i < dict_var_bounds.size(); i += 2) {
         ir_log_msg.m_dict_vars.insert(
-                ir_log_msg.m_dict_vars.cbegin() + prev_end_off,
-                log_msg_view.cbegin() + begin_pos,
-                log_msg_view.cbegin() + end_pos
+                ir_log_msg.m_dict_vars.cend(),
+                log_msg_view.cbegin() + dict_var_bounds[i],
+                log_msg_view.cbegin() + dict_var_bounds[i + 1]
+        );
+        ir_log_msg.m_dict_var_end_offsets.push_back(
+                static_cast<int32_t>(ir_log_msg.m_dict_vars.size())
         );
-        prev_end_off = prev_end_off + (end_pos - begin_pos);
-        ir_log_msg.m_dict_var_end_offsets.push_back(prev_end_off);
     }
 
     logtype->m_data = ir_log_msg.m_logtype.data();
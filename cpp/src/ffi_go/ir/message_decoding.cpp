@@ -0,0 +1,247 @@
+#include "message_decoding.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <clp/ffi/encoding_methods.hpp>
+#include <clp/ir/types.hpp>
+
+namespace ffi_go::ir {
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::four_byte_encoded_variable_t;
+using clp::ir::VariablePlaceholder;
+
+namespace {
+// The two digits of every number in [0, 100), back to back.
+constexpr auto cDigitPairs{[] {
+    std::array<char, 200> pairs{};
+    for (size_t i{0}; i < 100; ++i) {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}()};
+
+// 10^i for every power that fits in a uint64_t.
+constexpr auto cPowersOf10{[] {
+    std::array<uint64_t, 20> powers{};
+    uint64_t power{1};
+    for (auto& p : powers) {
+        p = power;
+        power *= 10;
+    }
+    return powers;
+}()};
+
+// The size of the longest integer (a sign and 19 digits) and float (a sign, 16
+// digits, and a decimal point).
+constexpr size_t cMaxIntegerSize{20};
+constexpr size_t cMaxFloatSize{18};
+
+/**
+ * @param value
+ * @return The number of decimal digits in value (1 for 0)
+ */
+[[nodiscard]] auto count_digits(uint64_t value) -> size_t;
+
+/**
+ * Write the last num_digits decimal digits of value (padded with zeros) so that
+ * they end right before end.
+ * @param end
+ * @param value
+ * @param num_digits
+ */
+auto write_digits(char* end, uint64_t value, size_t num_digits) -> void;
+
+auto count_digits(uint64_t value) -> size_t {
+    // log10(value) estimated from log2(value), as 1233 / 4096 ~= log10(2).
+    // Setting the lowest bit gives 0 one digit without changing any other
+    // value's number of digits (as no power of 10 is odd, apart from 1).
+    value |= 1U;
+    auto const estimate{static_cast<size_t>((std::bit_width(value) * 1233) >> 12)};
+    return estimate + 1 - static_cast<size_t>(value < cPowersOf10[estimate]);
+}
+
+auto write_digits(char* end, uint64_t value, size_t num_digits) -> void {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (; num_digits >= 2; num_digits -= 2) {
+        end -= 2;
+        std::memcpy(end, &cDigitPairs[static_cast<size_t>(value % 100) * 2], 2);
+        value /= 100;
+    }
+    if (1 == num_digits) {
+        *(end - 1) = static_cast<char>('0' + value % 10);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+}  // namespace
+
+template <typename encoded_variable_t>
+auto append_integer_var(encoded_variable_t var, std::string& str) -> void {
+    auto const value{static_cast<int64_t>(var)};
+    bool const is_negative{value < 0};
+    uint64_t const magnitude{
+            is_negative ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value)
+    };
+    size_t const size{static_cast<size_t>(is_negative) + count_digits(magnitude)};
+    std::array<char, cMaxIntegerSize> text{'-'};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write_digits(text.data() + size, magnitude, size - static_cast<size_t>(is_negative));
+    str.append(text.data(), size);
+}
+
+template <typename encoded_variable_t>
+auto append_float_var(encoded_variable_t var, std::string& str) -> bool {
+    bool is_negative{false};
+    std::conditional_t<
+            std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>,
+            uint64_t,
+            uint32_t>
+            digits{0};
+    size_t num_digits{0};
+    size_t decimal_point_pos{0};
+    clp::ffi::decode_float_properties(var, is_negative, digits, num_digits, decimal_point_pos);
+    // CLP rejects the former, and doesn't check the latter (which would write
+    // past the float's text).
+    if (num_digits < decimal_point_pos || digits >= cPowersOf10[num_digits]) {
+        return false;
+    }
+
+    // The digits after the decimal point, the decimal point, then the digits
+    // before it (if any), from right to left.
+    size_t const size{static_cast<size_t>(is_negative) + num_digits + 1};
+    std::array<char, cMaxFloatSize> text{'-'};
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    char* const end{text.data() + size};
+    char* const decimal_point{end - decimal_point_pos - 1};
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write_digits(end, digits, decimal_point_pos);
+    *decimal_point = '.';
+    write_digits(
+            decimal_point,
+            digits / cPowersOf10[decimal_point_pos],
+            num_digits - decimal_point_pos
+    );
+    str.append(text.data(), size);
+    return true;
+}
+
+template <typename encoded_variable_t>
+auto decode_message(
+        std::string_view logtype,
+        std::span<encoded_variable_t const> vars,
+        MessageDecodingBuffers& buffers,
+        std::string& message
+) -> bool {
+    auto const& dict_vars{buffers.m_dict_vars};
+    auto& var_text{buffers.m_var_text};
+    auto& var_text_end_offsets{buffers.m_var_text_end_offsets};
+    auto& placeholder_positions{buffers.m_placeholder_positions};
+    var_text.clear();
+    var_text_end_offsets.clear();
+    placeholder_positions.clear();
+
+    // Decode every encoded variable and measure the message.
+    size_t var_idx{0};
+    size_t dict_var_idx{0};
+    size_t dict_vars_size{0};
+    for (size_t pos{0}; pos < logtype.size(); ++pos) {
+        switch (static_cast<VariablePlaceholder>(logtype[pos])) {
+            case VariablePlaceholder::Integer:
+                if (vars.size() <= var_idx) {
+                    return false;
+                }
+                append_integer_var(vars[var_idx++], var_text);
+                var_text_end_offsets.push_back(var_text.size());
+                placeholder_positions.push_back(pos);
+                break;
+            case VariablePlaceholder::Float:
+                if (vars.size() <= var_idx || false == append_float_var(vars[var_idx++], var_text))
+                {
+                    return false;
+                }
+                var_text_end_offsets.push_back(var_text.size());
+                placeholder_positions.push_back(pos);
+                break;
+            case VariablePlaceholder::Dictionary:
+                if (dict_vars.size() <= dict_var_idx) {
+                    return false;
+                }
+                dict_vars_size += dict_vars[dict_var_idx++].size();
+                placeholder_positions.push_back(pos);
+                break;
+            case VariablePlaceholder::Escape:
+                if (logtype.size() - 1 == pos) {
+                    return false;
+                }
+                // The escaped character is static text.
+                placeholder_positions.push_back(pos++);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Splice the static text and variables into the message.
+    message.resize(
+            logtype.size() - placeholder_positions.size() + var_text.size() + dict_vars_size
+    );
+    char* dst{message.data()};
+    auto const copy{[&](std::string_view str) {
+        if (false == str.empty()) {
+            std::memcpy(dst, str.data(), str.size());
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            dst += str.size();
+        }
+    }};
+    std::string_view const var_text_view{var_text};
+    size_t static_text_begin{0};
+    size_t var_text_begin{0};
+    var_idx = 0;
+    dict_var_idx = 0;
+    for (auto const pos : placeholder_positions) {
+        copy(logtype.substr(static_text_begin, pos - static_text_begin));
+        static_text_begin = pos + 1;
+        switch (static_cast<VariablePlaceholder>(logtype[pos])) {
+            case VariablePlaceholder::Integer:
+            case VariablePlaceholder::Float: {
+                size_t const var_text_end{var_text_end_offsets[var_idx++]};
+                copy(var_text_view.substr(var_text_begin, var_text_end - var_text_begin));
+                var_text_begin = var_text_end;
+                break;
+            }
+            case VariablePlaceholder::Dictionary:
+                copy(dict_vars[dict_var_idx++]);
+                break;
+            default:
+                break;
+        }
+    }
+    copy(logtype.substr(static_text_begin));
+    return true;
+}
+
+template auto append_integer_var(eight_byte_encoded_variable_t var, std::string& str) -> void;
+template auto append_integer_var(four_byte_encoded_variable_t var, std::string& str) -> void;
+template auto append_float_var(eight_byte_encoded_variable_t var, std::string& str) -> bool;
+template auto append_float_var(four_byte_encoded_variable_t var, std::string& str) -> bool;
+template auto decode_message(
+        std::string_view logtype,
+        std::span<eight_byte_encoded_variable_t const> vars,
+        MessageDecodingBuffers& buffers,
+        std::string& message
+) -> bool;
+template auto decode_message(
+        std::string_view logtype,
+        std::span<four_byte_encoded_variable_t const> vars,
+        MessageDecodingBuffers& buffers,
+        std::string& message
+) -> bool;
+}  // namespace ffi_go::ir
@@ -0,0 +1,73 @@
+#ifndef FFI_GO_IR_MESSAGE_DECODING_HPP
+#define FFI_GO_IR_MESSAGE_DECODING_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ffi_go::ir {
+/**
+ * Scratch space for decode_message, kept so that its capacity is reused across
+ * messages. m_dict_vars holds views of the dictionary variables of the message
+ * to decode and is filled in by the caller. m_var_text holds the text of every
+ * encoded variable of the message, with m_var_text_end_offsets marking the end
+ * of each, and m_placeholder_positions holds the position in the logtype of
+ * every placeholder and escape character.
+ */
+struct MessageDecodingBuffers {
+    std::vector<std::string_view> m_dict_vars;
+    std::string m_var_text;
+    std::vector<size_t> m_var_text_end_offsets;
+    std::vector<size_t> m_placeholder_positions;
+};
+
+/**
+ * Append an encoded integer variable to str as text, with the same result as
+ * clp::ffi::decode_integer_var. Digits are written two at a time from a lookup
+ * table, without going through an intermediate std::string.
+ * @param var
+ * @param str
+ */
+template <typename encoded_variable_t>
+auto append_integer_var(encoded_variable_t var, std::string& str) -> void;
+
+/**
+ * Append an encoded float variable to str as text, with the same result as
+ * clp::ffi::decode_float_var. As the encoding stores the float's digits and the
+ * position of its decimal point, the text is formatted from the digits using
+ * the same lookup table as append_integer_var, without any floating point
+ * conversion.
+ * @param var
+ * @param str
+ * @return Whether var is a valid encoded float (str is unchanged if not)
+ */
+template <typename encoded_variable_t>
+[[nodiscard]] auto append_float_var(encoded_variable_t var, std::string& str) -> bool;
+
+/**
+ * Decode a log message from its logtype and variables, with the same result as
+ * clp::ffi::decode_message. The first pass over the logtype decodes all of the
+ * message's encoded variables into buffers.m_var_text and records the position
+ * of each placeholder, which gives the exact size of the message. The second
+ * pass sizes message once and copies the static text and variables into it.
+ * @param[in] logtype
+ * @param[in] vars Encoded variables
+ * @param[in] buffers Scratch space, with m_dict_vars holding the dictionary
+ *     variables
+ * @param[out] message
+ * @return Whether the message was decoded, i.e. every placeholder has a
+ *     variable, every encoded float is valid, and the logtype doesn't end with
+ *     an escape character
+ */
+template <typename encoded_variable_t>
+[[nodiscard]] auto decode_message(
+        std::string_view logtype,
+        std::span<encoded_variable_t const> vars,
+        MessageDecodingBuffers& buffers,
+        std::string& message
+) -> bool;
+}  // namespace ffi_go::ir
+
+#endif  // FFI_GO_IR_MESSAGE_DECODING_HPP
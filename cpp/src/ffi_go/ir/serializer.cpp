@@ -1,5 +1,7 @@
 #include "serializer.h"
 
+#include <cstddef>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -41,6 +43,103 @@ template <class encoded_variable_t>
         ByteSpan* ir_view
 ) -> int;
 
+/**
+ * Generic helper for ir_serializer_serialize_*_log_events_batch functions.
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto serialize_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps_or_deltas,
+        void* ir_serializer,
+        ByteSpan* ir_view
+) -> int;
+
+/**
+ * Generic helper for ir_serializer_append_*_log_event functions.
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto append_log_event_to_buffer(
+        StringView log_message,
+        epoch_time_ms_t timestamp_or_delta,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int;
+
+/**
+ * Generic helper for ir_serializer_append_*_log_events_batch functions.
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto append_log_events_batch_to_buffer(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps_or_deltas,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int;
+
+/**
+ * Serialize a batch of log events, appending them to the serializer's IR
+ * buffer. If any log event fails to serialize, the IR buffer is restored to
+ * its size before the call.
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the sizes of end_offsets
+ *     and timestamps_or_deltas differ, an end offset is out of bounds, or a log
+ *     event fails to serialize
+ * @return ffi::ir_stream::IRErrorCode_Success on success
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto append_log_events(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps_or_deltas,
+        Serializer* serializer
+) -> int;
+
+/**
+ * Serialize a single log event, appending it to the serializer's IR buffer.
+ * @return Forwards the result of ffi::ir_stream::*_encoding::serialize_log_event
+ */
+template <class encoded_variable_t>
+[[nodiscard]] auto append_log_event(
+        std::string_view log_message,
+        epoch_time_ms_t timestamp_or_delta,
+        Serializer* serializer
+) -> bool;
+
+template <class encoded_variable_t>
+auto append_log_event(
+        std::string_view log_message,
+        epoch_time_ms_t timestamp_or_delta,
+        Serializer* serializer
+) -> bool {
+    auto& counters{serializer->m_counters};
+    GrowthCounter const ir_buf_growth{counters.m_buffer_growths, serializer->m_ir_buf};
+    [[maybe_unused]] size_t const prev_size{serializer->m_ir_buf.size()};
+    bool success{false};
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        success = clp::ffi::ir_stream::eight_byte_encoding::serialize_log_event(
+                timestamp_or_delta,
+                log_message,
+                serializer->m_logtype,
+                serializer->m_ir_buf
+        );
+    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        success = clp::ffi::ir_stream::four_byte_encoding::serialize_log_event(
+                timestamp_or_delta,
+                log_message,
+                serializer->m_logtype,
+                serializer->m_ir_buf
+        );
+    } else {
+        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+    }
+    if (success) {
+        add_to_counter(counters.m_events_serialized);
+        add_to_counter(counters.m_bytes_serialized, serializer->m_ir_buf.size() - prev_size);
+    }
+    return success;
+}
+
 template <class encoded_variable_t>
 auto new_serializer_with_preamble(
         StringView ts_pattern,
@@ -101,32 +200,140 @@ auto serialize_log_event(
     serializer->m_ir_buf.clear();
     serializer->reserve(log_message.m_size);
 
-    bool success{false};
-    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
-        success = clp::ffi::ir_stream::eight_byte_encoding::serialize_log_event(
-                timestamp_or_delta,
+    if (false
+        == append_log_event<encoded_variable_t>(
                 std::string_view{log_message.m_data, log_message.m_size},
-                serializer->m_logtype,
-                serializer->m_ir_buf
-        );
-    } else if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
-        success = clp::ffi::ir_stream::four_byte_encoding::serialize_log_event(
                 timestamp_or_delta,
-                std::string_view{log_message.m_data, log_message.m_size},
-                serializer->m_logtype,
-                serializer->m_ir_buf
-        );
-    } else {
-        static_assert(cAlwaysFalse<encoded_variable_t>, "Invalid/unhandled encoding type");
+                serializer
+        ))
+    {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
     }
-    if (false == success) {
+
+    ir_view->m_data = serializer->m_ir_buf.data();
+    ir_view->m_size = serializer->m_ir_buf.size();
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+template <class encoded_variable_t>
+auto serialize_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps_or_deltas,
+        void* ir_serializer,
+        ByteSpan* ir_view
+) -> int {
+    if (nullptr == ir_serializer || nullptr == ir_view) {
         return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
     }
+    Serializer* serializer{static_cast<Serializer*>(ir_serializer)};
+
+    // Reserve for the entire batch up front so that appending each log event
+    // does not repeatedly grow the IR buffer.
+    serializer->m_ir_buf.clear();
+    serializer->reserve(log_messages.m_size);
+    auto const err{append_log_events<encoded_variable_t>(
+            log_messages,
+            end_offsets,
+            timestamps_or_deltas,
+            serializer
+    )};
+    if (static_cast<int>(IRErrorCode::IRErrorCode_Success) != err) {
+        return err;
+    }
 
     ir_view->m_data = serializer->m_ir_buf.data();
     ir_view->m_size = serializer->m_ir_buf.size();
     return static_cast<int>(IRErrorCode::IRErrorCode_Success);
 }
+
+template <class encoded_variable_t>
+auto append_log_event_to_buffer(
+        StringView log_message,
+        epoch_time_ms_t timestamp_or_delta,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int {
+    if (nullptr == ir_serializer || nullptr == buffered_size) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    Serializer* serializer{static_cast<Serializer*>(ir_serializer)};
+    size_t const prev_size{serializer->m_ir_buf.size()};
+    if (false
+        == append_log_event<encoded_variable_t>(
+                std::string_view{log_message.m_data, log_message.m_size},
+                timestamp_or_delta,
+                serializer
+        ))
+    {
+        serializer->m_ir_buf.resize(prev_size);
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    *buffered_size = serializer->m_ir_buf.size();
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+template <class encoded_variable_t>
+auto append_log_events_batch_to_buffer(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps_or_deltas,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int {
+    if (nullptr == ir_serializer || nullptr == buffered_size) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    Serializer* serializer{static_cast<Serializer*>(ir_serializer)};
+    auto const err{append_log_events<encoded_variable_t>(
+            log_messages,
+            end_offsets,
+            timestamps_or_deltas,
+            serializer
+    )};
+    *buffered_size = serializer->m_ir_buf.size();
+    return err;
+}
+
+template <class encoded_variable_t>
+auto append_log_events(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps_or_deltas,
+        Serializer* serializer
+) -> int {
+    if (end_offsets.m_size != timestamps_or_deltas.m_size) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    std::string_view const log_messages_view{log_messages.m_data, log_messages.m_size};
+    std::span<size_t const> const end_offsets_view{end_offsets.m_data, end_offsets.m_size};
+    std::span<int64_t const> const timestamps_view{
+            timestamps_or_deltas.m_data,
+            timestamps_or_deltas.m_size
+    };
+
+    size_t const prev_size{serializer->m_ir_buf.size()};
+    size_t begin_offset{0};
+    for (size_t i{0}; i < end_offsets_view.size(); ++i) {
+        size_t const end_offset{end_offsets_view[i]};
+        if (end_offset < begin_offset || end_offset > log_messages_view.size()) {
+            serializer->m_ir_buf.resize(prev_size);
+            return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+        }
+        if (false
+            == append_log_event<encoded_variable_t>(
+                    log_messages_view.substr(begin_offset, end_offset - begin_offset),
+                    timestamps_view[i],
+                    serializer
+            ))
+        {
+            serializer->m_ir_buf.resize(prev_size);
+            return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+        }
+        begin_offset = end_offset;
+    }
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
 }  // namespace
 
 CLP_FFI_GO_METHOD auto ir_serializer_close(void* ir_serializer) -> void {
@@ -196,4 +403,130 @@ CLP_FFI_GO_METHOD auto ir_serializer_serialize_four_byte_log_event(
             ir_view
     );
 }
+
+CLP_FFI_GO_METHOD auto ir_serializer_serialize_eight_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps,
+        void* ir_serializer,
+        ByteSpan* ir_view
+) -> int {
+    return serialize_log_events_batch<eight_byte_encoded_variable_t>(
+            log_messages,
+            end_offsets,
+            timestamps,
+            ir_serializer,
+            ir_view
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_serialize_four_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamp_deltas,
+        void* ir_serializer,
+        ByteSpan* ir_view
+) -> int {
+    return serialize_log_events_batch<four_byte_encoded_variable_t>(
+            log_messages,
+            end_offsets,
+            timestamp_deltas,
+            ir_serializer,
+            ir_view
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_append_eight_byte_log_event(
+        StringView log_message,
+        epoch_time_ms_t timestamp,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int {
+    return append_log_event_to_buffer<eight_byte_encoded_variable_t>(
+            log_message,
+            timestamp,
+            ir_serializer,
+            buffered_size
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_append_four_byte_log_event(
+        StringView log_message,
+        epoch_time_ms_t timestamp_delta,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int {
+    return append_log_event_to_buffer<four_byte_encoded_variable_t>(
+            log_message,
+            timestamp_delta,
+            ir_serializer,
+            buffered_size
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_append_eight_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int {
+    return append_log_events_batch_to_buffer<eight_byte_encoded_variable_t>(
+            log_messages,
+            end_offsets,
+            timestamps,
+            ir_serializer,
+            buffered_size
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_append_four_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamp_deltas,
+        void* ir_serializer,
+        size_t* buffered_size
+) -> int {
+    return append_log_events_batch_to_buffer<four_byte_encoded_variable_t>(
+            log_messages,
+            end_offsets,
+            timestamp_deltas,
+            ir_serializer,
+            buffered_size
+    );
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_get_buffered_ir(void* ir_serializer, ByteSpan* ir_view)
+        -> void {
+    if (nullptr == ir_view) {
+        return;
+    }
+    if (nullptr == ir_serializer) {
+        *ir_view = {nullptr, 0};
+        return;
+    }
+    Serializer* serializer{static_cast<Serializer*>(ir_serializer)};
+    ir_view->m_data = serializer->m_ir_buf.data();
+    ir_view->m_size = serializer->m_ir_buf.size();
+}
+
+CLP_FFI_GO_METHOD auto ir_serializer_clear_buffered_ir(void* ir_serializer) -> void {
+    if (nullptr == ir_serializer) {
+        return;
+    }
+    static_cast<Serializer*>(ir_serializer)->m_ir_buf.clear();
+}
+
+CLP_FFI_GO_METHOD auto
+ir_serializer_get_counters(void* ir_serializer, SerializerCounters* counters) -> int {
+    if (nullptr == counters) {
+        return 0;
+    }
+    if (nullptr == ir_serializer) {
+        *counters = {};
+        return 0;
+    }
+    *counters = static_cast<Serializer*>(ir_serializer)->m_counters;
+    return cCountersEnabled ? 1 : 0;
+}
 }  // namespace ffi_go::ir
@@ -2,10 +2,23 @@
 #define FFI_GO_IR_SERIALIZER_H
 // header must support C, making modernize checks inapplicable
 // NOLINTBEGIN(modernize-use-trailing-return-type)
+// NOLINTBEGIN(modernize-use-using)
 
 #include "ffi_go/api_decoration.h"
 #include "ffi_go/defs.h"
 
+/**
+ * A snapshot of the work done by an ir::Serializer (see
+ * ir_serializer_get_counters). m_bytes_serialized counts the IR written for
+ * log events (excluding the preamble), and m_buffer_growths the reallocations
+ * of the ir::Serializer's IR buffer.
+ */
+typedef struct {
+    uint64_t m_events_serialized;
+    uint64_t m_bytes_serialized;
+    uint64_t m_buffer_growths;
+} SerializerCounters;
+
 /**
  * Clean up the underlying ir::Serializer of a Go ir.Serializer.
  * @param[in] ir_serializer Address of a ir::Serializer created and returned by
@@ -101,5 +114,192 @@ CLP_FFI_GO_METHOD int ir_serializer_serialize_four_byte_log_event(
         ByteSpan* ir_view
 );
 
+/**
+ * Given the fields of a batch of log events, serialize them into a single IR
+ * byte stream with eight byte encoding. The log messages are packed back to
+ * back in log_messages, with end_offsets marking the end of each message. An
+ * ir::Serializer must be provided to use as the backing storage for the
+ * corresponding Go ir.Serializer. All pointer parameters must be non-null
+ * (non-nil Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] log_messages Concatenation of the log messages to serialize
+ * @param[in] end_offsets Array of offsets into log_messages marking the end of
+ *     each log message
+ * @param[in] timestamps Array of the timestamps of each log event
+ * @param[in] ir_serializer ir::Serializer object to be used as storage
+ * @param[out] ir_view View of a IR buffer containing the serialized log events
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the sizes of end_offsets
+ *     and timestamps differ or an end offset is out of bounds
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *   ffi::ir_stream::eight_byte_encoding::encode_message
+ */
+CLP_FFI_GO_METHOD int ir_serializer_serialize_eight_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps,
+        void* ir_serializer,
+        ByteSpan* ir_view
+);
+
+/**
+ * Given the fields of a batch of log events, serialize them into a single IR
+ * byte stream with four byte encoding. The log messages are packed back to
+ * back in log_messages, with end_offsets marking the end of each message. An
+ * ir::Serializer must be provided to use as the backing storage for the
+ * corresponding Go ir.Serializer. All pointer parameters must be non-null
+ * (non-nil Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] log_messages Concatenation of the log messages to serialize
+ * @param[in] end_offsets Array of offsets into log_messages marking the end of
+ *     each log message
+ * @param[in] timestamp_deltas Array of the timestamp delta of each log event to
+ *     the previous log event in the IR stream
+ * @param[in] ir_serializer ir::Serializer object to be used as storage
+ * @param[out] ir_view View of a IR buffer containing the serialized log events
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the sizes of end_offsets
+ *     and timestamp_deltas differ or an end offset is out of bounds
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::encode_message
+ */
+CLP_FFI_GO_METHOD int ir_serializer_serialize_four_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamp_deltas,
+        void* ir_serializer,
+        ByteSpan* ir_view
+);
+
+/**
+ * Given the fields of a log event, serialize them with eight byte encoding and
+ * append the IR to the buffered IR of an ir::Serializer, without clearing it or
+ * returning a view. The buffer grows as needed and keeps its capacity once
+ * cleared, so a high rate of log events can be serialized without per event
+ * allocations. Use ir_serializer_get_buffered_ir to retrieve the buffered IR
+ * and ir_serializer_clear_buffered_ir once it has been consumed.
+ * ir_serializer_serialize_* functions clear the buffered IR. All pointer
+ * parameters must be non-null (non-nil Cgo C.<type> pointer or unsafe.Pointer
+ * from Go).
+ * @param[in] log_message Log message of the log event to serialize
+ * @param[in] timestamp Timestamp of the log event to serialize
+ * @param[in] ir_serializer ir::Serializer object to be used as storage
+ * @param[out] buffered_size Size of the buffered IR after appending
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::encode_message
+ */
+CLP_FFI_GO_METHOD int ir_serializer_append_eight_byte_log_event(
+        StringView log_message,
+        epoch_time_ms_t timestamp,
+        void* ir_serializer,
+        size_t* buffered_size
+);
+
+/**
+ * Given the fields of a log event, serialize them with four byte encoding and
+ * append the IR to the buffered IR of an ir::Serializer, without clearing it or
+ * returning a view. The buffer grows as needed and keeps its capacity once
+ * cleared, so a high rate of log events can be serialized without per event
+ * allocations. Use ir_serializer_get_buffered_ir to retrieve the buffered IR
+ * and ir_serializer_clear_buffered_ir once it has been consumed.
+ * ir_serializer_serialize_* functions clear the buffered IR. All pointer
+ * parameters must be non-null (non-nil Cgo C.<type> pointer or unsafe.Pointer
+ * from Go).
+ * @param[in] log_message Log message of the log event to serialize
+ * @param[in] timestamp_delta Timestamp delta to the previous log event in
+ *     the IR stream
+ * @param[in] ir_serializer ir::Serializer object to be used as storage
+ * @param[out] buffered_size Size of the buffered IR after appending
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::encode_message
+ */
+CLP_FFI_GO_METHOD int ir_serializer_append_four_byte_log_event(
+        StringView log_message,
+        epoch_time_ms_t timestamp_delta,
+        void* ir_serializer,
+        size_t* buffered_size
+);
+
+/**
+ * Given the fields of a batch of log events, serialize them with eight byte
+ * encoding and append the IR to the buffered IR of an ir::Serializer (see
+ * ir_serializer_append_eight_byte_log_event). The log messages are packed back
+ * to back in log_messages, with end_offsets marking the end of each message. If
+ * any log event fails to serialize, none of the batch is appended. All pointer
+ * parameters must be non-null (non-nil Cgo C.<type> pointer or unsafe.Pointer
+ * from Go).
+ * @param[in] log_messages Concatenation of the log messages to serialize
+ * @param[in] end_offsets Array of offsets into log_messages marking the end of
+ *     each log message
+ * @param[in] timestamps Array of the timestamps of each log event
+ * @param[in] ir_serializer ir::Serializer object to be used as storage
+ * @param[out] buffered_size Size of the buffered IR after appending
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the sizes of end_offsets
+ *     and timestamps differ or an end offset is out of bounds
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::encode_message
+ */
+CLP_FFI_GO_METHOD int ir_serializer_append_eight_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamps,
+        void* ir_serializer,
+        size_t* buffered_size
+);
+
+/**
+ * Given the fields of a batch of log events, serialize them with four byte
+ * encoding and append the IR to the buffered IR of an ir::Serializer (see
+ * ir_serializer_append_four_byte_log_event). The log messages are packed back
+ * to back in log_messages, with end_offsets marking the end of each message. If
+ * any log event fails to serialize, none of the batch is appended. All pointer
+ * parameters must be non-null (non-nil Cgo C.<type> pointer or unsafe.Pointer
+ * from Go).
+ * @param[in] log_messages Concatenation of the log messages to serialize
+ * @param[in] end_offsets Array of offsets into log_messages marking the end of
+ *     each log message
+ * @param[in] timestamp_deltas Array of the timestamp delta of each log event to
+ *     the previous log event in the IR stream
+ * @param[in] ir_serializer ir::Serializer object to be used as storage
+ * @param[out] buffered_size Size of the buffered IR after appending
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the sizes of end_offsets
+ *     and timestamp_deltas differ or an end offset is out of bounds
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::encode_message
+ */
+CLP_FFI_GO_METHOD int ir_serializer_append_four_byte_log_events_batch(
+        StringView log_messages,
+        SizetSpan end_offsets,
+        Int64tSpan timestamp_deltas,
+        void* ir_serializer,
+        size_t* buffered_size
+);
+
+/**
+ * Get a view of the IR buffered by ir_serializer_append_* functions. The view
+ * is invalidated by the next call using ir_serializer. All pointer parameters
+ * must be non-null (non-nil Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_serializer ir::Serializer object used as storage
+ * @param[out] ir_view View of the buffered IR (empty if ir_serializer is null)
+ */
+CLP_FFI_GO_METHOD void ir_serializer_get_buffered_ir(void* ir_serializer, ByteSpan* ir_view);
+
+/**
+ * Clear the IR buffered by ir_serializer_append_* functions, keeping the
+ * buffer's capacity for subsequent log events.
+ * @param[in] ir_serializer ir::Serializer object used as storage
+ */
+CLP_FFI_GO_METHOD void ir_serializer_clear_buffered_ir(void* ir_serializer);
+
+/**
+ * Snapshot the counters of an ir::Serializer. The counters are only maintained
+ * if the library is built with CLP_FFI_GO_ENABLE_COUNTERS defined, and
+ * otherwise compiled out entirely. All pointer parameters must be non-null
+ * (non-nil Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_serializer ir::Serializer to snapshot
+ * @param[out] counters Snapshot of the counters (all 0 if disabled)
+ * @return 1 if the counters are enabled
+ * @return 0 if the counters are disabled, or ir_serializer or counters is null
+ *     (with any counters left 0)
+ */
+CLP_FFI_GO_METHOD int ir_serializer_get_counters(void* ir_serializer, SerializerCounters* counters);
+
+// NOLINTEND(modernize-use-using)
 // NOLINTEND(modernize-use-trailing-return-type)
 #endif  // FFI_GO_IR_SERIALIZER_H
@@ -3,11 +3,20 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ir/types.hpp>
 
+#include "ffi_go/defs.h"
+#include "ffi_go/ir/deserializer.h"
+#include "ffi_go/ir/message_decoding.hpp"
+#include "ffi_go/ir/serializer.h"
+#include "ffi_go/search/compiled_query.hpp"
+#include "ffi_go/search/numeric_query.hpp"
 #include "ffi_go/types.hpp"
 
 namespace ffi_go::ir {
@@ -15,6 +24,72 @@ namespace ffi_go::ir {
 template <typename>
 [[maybe_unused]] constexpr bool cAlwaysFalse{false};
 
+// Returned by the ir_deserializer_deserialize_*_match functions once they find
+// a log event at or after the upper bound of the time interval. TODO this is an
+// extremely fragile hack until the CLP ffi ir code is refactored and
+// IRErrorCode includes things beyond decoding.
+constexpr int cEndOfTimeInterval{
+        static_cast<int>(clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Incomplete_IR) + 1
+};
+
+#ifdef CLP_FFI_GO_ENABLE_COUNTERS
+constexpr bool cCountersEnabled{true};
+#else
+constexpr bool cCountersEnabled{false};
+#endif
+
+/**
+ * Add n to a counter of DeserializerCounters or SerializerCounters. Compiles to
+ * nothing unless CLP_FFI_GO_ENABLE_COUNTERS is defined.
+ */
+inline auto add_to_counter([[maybe_unused]] uint64_t& counter, [[maybe_unused]] uint64_t n = 1)
+        -> void {
+    if constexpr (cCountersEnabled) {
+        counter += n;
+    }
+}
+
+/**
+ * Increments a counter on destruction if a container's capacity grew during
+ * the lifetime of the GrowthCounter (i.e. its storage was reallocated). Compiles
+ * to nothing unless CLP_FFI_GO_ENABLE_COUNTERS is defined.
+ */
+template <typename container_t>
+class GrowthCounter {
+public:
+    // Constructors
+    GrowthCounter(uint64_t& counter, container_t const& container)
+            : m_counter{counter},
+              m_container{container} {
+        if constexpr (cCountersEnabled) {
+            m_capacity = container.capacity();
+        }
+    }
+
+    // Delete copy/move constructors and assignment
+    GrowthCounter(GrowthCounter const&) = delete;
+    GrowthCounter(GrowthCounter&&) = delete;
+    auto operator=(GrowthCounter const&) -> GrowthCounter& = delete;
+    auto operator=(GrowthCounter&&) -> GrowthCounter& = delete;
+
+    // Destructor
+    ~GrowthCounter() {
+        if constexpr (cCountersEnabled) {
+            if (m_container.capacity() > m_capacity) {
+                ++m_counter;
+            }
+        }
+    }
+
+private:
+    // Variables
+    // NOLINTBEGIN(cppcoreguidelines-avoid-const-or-ref-data-members)
+    uint64_t& m_counter;
+    container_t const& m_container;
+    // NOLINTEND(cppcoreguidelines-avoid-const-or-ref-data-members)
+    size_t m_capacity{0};
+};
+
 template <typename encoded_var_t>
 struct LogMessage {
     auto reserve(size_t cap) -> void { m_logtype.reserve(cap); }
@@ -25,6 +100,66 @@ struct LogMessage {
     std::vector<int32_t> m_dict_var_end_offsets;
 };
 
+/**
+ * Storage for a log event deserialized into its encoded form, which its log
+ * message is decoded from, so that queries can be evaluated against it before
+ * (or without) decoding its log message. m_log_message.m_dict_vars and
+ * m_log_message.m_dict_var_end_offsets are unused, as m_dict_vars is decoded
+ * from directly. m_static_text holds the unescaped static text of the logtype,
+ * split at each (non-empty) variable, with m_static_text_end_offsets marking
+ * the end of each piece, and is only filled in while searching. m_decoded_vars
+ * holds the encoded variables decoded into strings, which is only done on
+ * demand.
+ */
+template <typename encoded_var_t>
+struct EncodedLogEventStorage {
+    LogMessage<encoded_var_t> m_log_message;
+    std::vector<std::string> m_dict_vars;
+    std::string m_static_text;
+    std::vector<size_t> m_static_text_end_offsets;
+    std::vector<std::string> m_decoded_vars;
+    bool m_vars_decoded{false};
+    MessageDecodingBuffers m_decoding_buffers;
+};
+
+/**
+ * What is known about which queries of a search::CompiledQuery match a log
+ * message from its logtype alone. Queries not in m_possible cannot match any
+ * log message with the logtype, queries in m_definite match every log message
+ * with the logtype, and all other queries depend on the variables.
+ */
+struct LogtypeMatch {
+    ffi_go::search::CompiledQuery::Candidates m_possible;
+    ffi_go::search::CompiledQuery::Candidates m_definite;
+};
+
+/**
+ * Cache of the LogtypeMatch of each logtype seen while searching with the
+ * search::CompiledQuery identified by m_compiled_query_id. Streams typically
+ * contain few distinct logtypes, but to bound its memory the cache is cleared
+ * once it holds cMaxSize logtypes.
+ */
+struct LogtypeMatchCache {
+    static constexpr size_t cMaxSize{4096};
+
+    std::optional<uint64_t> m_compiled_query_id;
+    std::unordered_map<std::string, LogtypeMatch> m_matches;
+};
+
+/**
+ * Cache of the variables compared by the search::NumericQuery identified by
+ * m_numeric_query_id in log events of each logtype seen while searching
+ * (std::nullopt if the query can't match the logtype). Like LogtypeMatchCache,
+ * it is cleared once it holds cMaxSize logtypes.
+ */
+struct NumericQueryCache {
+    static constexpr size_t cMaxSize{4096};
+
+    std::optional<uint64_t> m_numeric_query_id;
+    std::unordered_map<std::string, std::optional<ffi_go::search::NumericQuery::VariableRefs>>
+            m_variables;
+};
+
 /**
  * The backing storage for a Go ir.Decoder.
  * Mutating a field will invalidate the corresponding View (slice) stored in the
@@ -32,32 +167,106 @@ struct LogMessage {
  */
 struct Decoder {
     ffi_go::LogMessage m_log_message;
+    MessageDecodingBuffers m_decoding_buffers;
 };
 
 /**
  * The backing storage for a Go ir.Encoder.
  * Mutating a field will invalidate the corresponding View (slice) stored in the
  * ir.Encoder (without any warning or way to guard in Go).
+ * m_dict_var_bounds is scratch space for the begin and end positions of each
+ * dictionary variable in the message being encoded, kept so its capacity is
+ * reused across messages.
  */
 template <typename encoded_var_t>
 struct Encoder {
     LogMessage<encoded_var_t> m_log_message;
+    std::vector<int32_t> m_dict_var_bounds;
+};
+
+/**
+ * Storage for the log events of a chunk of an IR stream, deserialized
+ * concurrently with other chunks of the stream. m_end_pos is the position in
+ * the IR buffer after the chunk's last deserialized log event, and m_error is
+ * the error that ended the chunk before its end (IRErrorCode_Success if
+ * every log event of the chunk was deserialized). Only the encoded log event
+ * storage for the stream's encoding is used.
+ */
+struct LogEventChunk {
+    ffi_go::LogMessage m_log_message;
+    EncodedLogEventStorage<clp::ir::eight_byte_encoded_variable_t> m_eight_byte_encoded_log_event;
+    EncodedLogEventStorage<clp::ir::four_byte_encoded_variable_t> m_four_byte_encoded_log_event;
+    ffi_go::LogEventBatchStorage m_batch;
+    std::vector<clp::ir::epoch_time_ms_t> m_timestamps;
+    size_t m_end_pos{0};
+    clp::ffi::ir_stream::IRErrorCode m_error{};
+};
+
+/**
+ * The backing storage for the columns of a batch of log events (see
+ * LogEventColumns). Each log message is appended to m_message_data, with
+ * m_message_offsets marking where each begins (and the last ends). The optional
+ * columns are only filled in when requested.
+ */
+struct LogEventColumnsStorage {
+    auto clear() -> void {
+        m_timestamps.clear();
+        m_message_offsets.assign(1, 0);
+        m_message_data.clear();
+        m_logtype_ids.clear();
+        m_matching_queries.clear();
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_timestamps.size(); }
+
+    std::vector<clp::ir::epoch_time_ms_t> m_timestamps;
+    std::vector<int64_t> m_message_offsets;
+    std::string m_message_data;
+    std::vector<int64_t> m_logtype_ids;
+    std::vector<int64_t> m_matching_queries;
 };
 
 /**
  * The backing storage for a Go ir.Deserializer.
  * Mutating a field will invalidate the corresponding View (slice) stored in the
  * ir.Deserializer (without any warning or way to guard in Go).
+ * m_compiled_query caches the last merged query used for matching, so that it
+ * is only recompiled when the queries change between calls. Log events are
+ * deserialized into the encoded log event storage for the stream's encoding
+ * (the only one ever used by a Deserializer) before being decoded, and while
+ * searching m_logtype_match_cache (or m_numeric_query_cache) avoids evaluating
+ * the queries against the same logtype repeatedly. m_log_event_chunks and
+ * m_log_event_chunk_views hold the log events of chunks deserialized in
+ * parallel. m_log_event_columns holds the columns of the last batch deserialized
+ * into columns, and m_logtype_ids the id of every logtype seen while filling in
+ * their logtype id column (which grows with the number of distinct logtypes in
+ * the stream). m_counters is only updated if CLP_FFI_GO_ENABLE_COUNTERS is
+ * defined.
  */
 struct Deserializer {
     ffi_go::LogEventStorage m_log_event;
+    ffi_go::LogEventBatchStorage m_log_event_batch;
     clp::ir::epoch_time_ms_t m_timestamp{};
+    std::optional<ffi_go::search::CompiledQuery> m_compiled_query;
+    ffi_go::search::CompiledQuery::Candidates m_match_candidates;
+    EncodedLogEventStorage<clp::ir::eight_byte_encoded_variable_t> m_eight_byte_encoded_log_event;
+    EncodedLogEventStorage<clp::ir::four_byte_encoded_variable_t> m_four_byte_encoded_log_event;
+    LogtypeMatchCache m_logtype_match_cache;
+    NumericQueryCache m_numeric_query_cache;
+    std::vector<LogEventChunk> m_log_event_chunks;
+    std::vector<LogEventView> m_log_event_chunk_views;
+    LogEventColumnsStorage m_log_event_columns;
+    std::unordered_map<std::string, int64_t> m_logtype_ids;
+    DeserializerCounters m_counters{};
 };
 
 /**
  * The backing storage for a Go ir.Serializer.
  * Mutating a field will invalidate the corresponding View (slice) stored in the
  * ir.Serializer (without any warning or way to guard in Go).
+ * m_ir_buf holds the IR of the last serialize call, or accumulates the IR of
+ * append calls until it is cleared (retaining its capacity). m_counters is only
+ * updated if CLP_FFI_GO_ENABLE_COUNTERS is defined.
  */
 struct Serializer {
     /**
@@ -68,12 +277,14 @@ struct Serializer {
      * message, but in general this is true.
      */
     auto reserve(size_t cap) -> void {
+        GrowthCounter const ir_buf_growth{m_counters.m_buffer_growths, m_ir_buf};
         m_logtype.reserve(cap);
         m_ir_buf.reserve(cap + cap / 2);
     }
 
     std::string m_logtype;
     std::vector<int8_t> m_ir_buf;
+    SerializerCounters m_counters{};
 };
 }  // namespace ffi_go::ir
 
@@ -0,0 +1,193 @@
+#include "zstd_compressor.h"
+
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <zstd.h>
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+#include "ffi_go/ir/zstd_compressor.hpp"
+
+namespace ffi_go::ir {
+using clp::ffi::ir_stream::IRErrorCode;
+
+namespace {
+/**
+ * Error returned when zstd fails to compress a frame, mirroring Go's
+ * ir.EncodeError (which does not exist in ffi::ir_stream::IRErrorCode).
+ */
+constexpr int cEncodeError{static_cast<int>(IRErrorCode::IRErrorCode_Incomplete_IR) + 2};
+}  // namespace
+
+ZstdCompressor::ZstdCompressor(int compression_level, size_t frame_size)
+        : m_compression_level{compression_level},
+          m_frame_size{frame_size},
+          m_thread{[this] { run(); }} {
+    m_chunk.reserve(m_frame_size);
+}
+
+ZstdCompressor::~ZstdCompressor() {
+    {
+        std::lock_guard const lock{m_mutex};
+        m_stopped = true;
+    }
+    m_queue_changed.notify_all();
+    m_thread.join();
+}
+
+auto ZstdCompressor::write(std::span<char const> ir) -> void {
+    m_chunk.insert(m_chunk.end(), ir.begin(), ir.end());
+    if (m_chunk.size() >= m_frame_size) {
+        queue_chunk();
+    }
+}
+
+auto ZstdCompressor::finish() -> void {
+    if (false == m_chunk.empty()) {
+        queue_chunk();
+    }
+    std::unique_lock lock{m_mutex};
+    m_queue_changed.wait(lock, [&] { return m_queue.empty(); });
+}
+
+auto ZstdCompressor::take_output() -> std::span<char const> {
+    m_taken_output.clear();
+    {
+        std::lock_guard const lock{m_mutex};
+        std::swap(m_output, m_taken_output);
+    }
+    return {m_taken_output.data(), m_taken_output.size()};
+}
+
+auto ZstdCompressor::is_ok() -> bool {
+    std::lock_guard const lock{m_mutex};
+    return false == m_failed;
+}
+
+auto ZstdCompressor::queue_chunk() -> void {
+    {
+        std::unique_lock lock{m_mutex};
+        m_queue_changed.wait(lock, [&] { return m_queue.size() < cMaxQueuedChunks; });
+        m_queue.push_back(std::move(m_chunk));
+        if (m_free_chunks.empty()) {
+            m_chunk = {};
+        } else {
+            m_chunk = std::move(m_free_chunks.back());
+            m_free_chunks.pop_back();
+        }
+    }
+    m_queue_changed.notify_all();
+    m_chunk.reserve(m_frame_size);
+}
+
+auto ZstdCompressor::run() -> void {
+    ZSTD_CCtx* ctx{ZSTD_createCCtx()};
+    bool ok{nullptr != ctx
+            && 0 == ZSTD_isError(ZSTD_CCtx_setParameter(
+                            ctx,
+                            ZSTD_c_compressionLevel,
+                            m_compression_level
+                    ))};
+    std::vector<char> frame;
+    std::unique_lock lock{m_mutex};
+    while (true) {
+        m_queue_changed.wait(lock, [&] { return m_stopped || false == m_queue.empty(); });
+        if (m_queue.empty()) {
+            break;
+        }
+        // The chunk stays at the front of the queue while it is compressed, as
+        // finish waits for the queue to be empty.
+        auto& chunk{m_queue.front()};
+        lock.unlock();
+        size_t frame_size{0};
+        if (ok) {
+            // ZSTD_compress2 compresses the chunk into a single, complete frame.
+            frame.resize(ZSTD_compressBound(chunk.size()));
+            frame_size = ZSTD_compress2(
+                    ctx,
+                    frame.data(),
+                    frame.size(),
+                    chunk.data(),
+                    chunk.size()
+            );
+            ok = 0 == ZSTD_isError(frame_size);
+        }
+        lock.lock();
+        if (ok) {
+            m_output.insert(m_output.end(), frame.data(), frame.data() + frame_size);
+            m_uncompressed_size += chunk.size();
+            m_compressed_size += frame_size;
+            m_frame_uncompressed_ends.push_back(m_uncompressed_size);
+            m_frame_compressed_ends.push_back(m_compressed_size);
+        } else {
+            m_failed = true;
+        }
+        chunk.clear();
+        m_free_chunks.push_back(std::move(chunk));
+        m_queue.pop_front();
+        m_queue_changed.notify_all();
+    }
+    ZSTD_freeCCtx(ctx);
+}
+
+CLP_FFI_GO_METHOD auto ir_zstd_compressor_new(int compression_level, size_t frame_size) -> void* {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    return new ZstdCompressor{compression_level, frame_size};
+}
+
+CLP_FFI_GO_METHOD auto ir_zstd_compressor_close(void* zstd_compressor) -> void {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    delete static_cast<ZstdCompressor*>(zstd_compressor);
+}
+
+CLP_FFI_GO_METHOD auto
+ir_zstd_compressor_write(void* zstd_compressor, ByteSpan ir, ByteSpan* compressed) -> int {
+    if (nullptr == zstd_compressor || nullptr == compressed) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    auto* compressor{static_cast<ZstdCompressor*>(zstd_compressor)};
+    compressor->write({static_cast<char const*>(ir.m_data), ir.m_size});
+    if (false == compressor->is_ok()) {
+        return cEncodeError;
+    }
+    auto const output{compressor->take_output()};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    *compressed = {const_cast<char*>(output.data()), output.size()};
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+CLP_FFI_GO_METHOD auto ir_zstd_compressor_finish(void* zstd_compressor, ByteSpan* compressed)
+        -> int {
+    if (nullptr == zstd_compressor || nullptr == compressed) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    auto* compressor{static_cast<ZstdCompressor*>(zstd_compressor)};
+    compressor->finish();
+    if (false == compressor->is_ok()) {
+        return cEncodeError;
+    }
+    auto const output{compressor->take_output()};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    *compressed = {const_cast<char*>(output.data()), output.size()};
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+CLP_FFI_GO_METHOD auto ir_zstd_compressor_get_frames(
+        void* zstd_compressor,
+        SizetSpan* uncompressed_ends,
+        SizetSpan* compressed_ends
+) -> void {
+    auto const* compressor{static_cast<ZstdCompressor const*>(zstd_compressor)};
+    auto const& uncompressed{compressor->get_frame_uncompressed_ends()};
+    auto const& compressed{compressor->get_frame_compressed_ends()};
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+    *uncompressed_ends = {const_cast<size_t*>(uncompressed.data()), uncompressed.size()};
+    *compressed_ends = {const_cast<size_t*>(compressed.data()), compressed.size()};
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+}
+}  // namespace ffi_go::ir
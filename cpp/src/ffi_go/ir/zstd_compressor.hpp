@@ -0,0 +1,124 @@
+#ifndef FFI_GO_IR_ZSTD_COMPRESSOR_HPP
+#define FFI_GO_IR_ZSTD_COMPRESSOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ffi_go::ir {
+/**
+ * Compresses a CLP IR stream with zstd on a background thread, so that
+ * compressing a chunk of the stream overlaps with serializing the log events
+ * of the next. The stream is split into chunks of at least m_frame_size bytes,
+ * and each chunk is compressed into an independent zstd frame, allowing the
+ * frames to later be decompressed in parallel or seeked to (see
+ * get_frame_uncompressed_ends and get_frame_compressed_ends). Chunks are
+ * compressed in order, and once cMaxQueuedChunks chunks are waiting to be
+ * compressed, write blocks until the background thread catches up.
+ */
+class ZstdCompressor {
+public:
+    // Constants
+    static constexpr size_t cMaxQueuedChunks{2};
+
+    // Constructors
+    /**
+     * Start the background compression thread.
+     * @param compression_level zstd compression level
+     * @param frame_size Number of bytes of IR after which to end a frame
+     */
+    ZstdCompressor(int compression_level, size_t frame_size);
+
+    // Delete copy/move constructors and assignment
+    ZstdCompressor(ZstdCompressor const&) = delete;
+    ZstdCompressor(ZstdCompressor&&) = delete;
+    auto operator=(ZstdCompressor const&) -> ZstdCompressor& = delete;
+    auto operator=(ZstdCompressor&&) -> ZstdCompressor& = delete;
+
+    // Destructor
+    /**
+     * Wait for the background thread to compress any queued chunks and exit.
+     */
+    ~ZstdCompressor();
+
+    // Methods
+    /**
+     * Append IR to the current chunk, queueing the chunk to be compressed once
+     * it holds at least m_frame_size bytes.
+     * @param ir
+     */
+    auto write(std::span<char const> ir) -> void;
+
+    /**
+     * Queue the current chunk to be compressed (if it is not empty) and wait
+     * for every queued chunk to be compressed.
+     */
+    auto finish() -> void;
+
+    /**
+     * Remove the frames compressed since the last call. The returned view
+     * remains valid until the next call.
+     * @return A view of the compressed frames
+     */
+    [[nodiscard]] auto take_output() -> std::span<char const>;
+
+    /**
+     * @return Whether every chunk compressed so far was compressed successfully
+     */
+    [[nodiscard]] auto is_ok() -> bool;
+
+    /**
+     * Only complete (and safe to call) after finish.
+     * @return The position in the uncompressed stream of the end of each frame
+     */
+    [[nodiscard]] auto get_frame_uncompressed_ends() const -> std::vector<size_t> const& {
+        return m_frame_uncompressed_ends;
+    }
+
+    /**
+     * Only complete (and safe to call) after finish.
+     * @return The position in the compressed stream of the end of each frame
+     */
+    [[nodiscard]] auto get_frame_compressed_ends() const -> std::vector<size_t> const& {
+        return m_frame_compressed_ends;
+    }
+
+private:
+    /**
+     * Compress queued chunks in order until stopped and no chunks remain.
+     */
+    auto run() -> void;
+
+    /**
+     * Wait for space in the queue and move the current chunk into it.
+     */
+    auto queue_chunk() -> void;
+
+    int m_compression_level;
+    size_t m_frame_size;
+    std::vector<char> m_chunk;
+
+    // State shared with the background thread. A chunk is only removed from
+    // m_queue once it has been compressed.
+    std::mutex m_mutex;
+    std::condition_variable m_queue_changed;
+    std::deque<std::vector<char>> m_queue;
+    std::vector<std::vector<char>> m_free_chunks;
+    std::vector<char> m_output;
+    size_t m_uncompressed_size{0};
+    size_t m_compressed_size{0};
+    std::vector<size_t> m_frame_uncompressed_ends;
+    std::vector<size_t> m_frame_compressed_ends;
+    bool m_failed{false};
+    bool m_stopped{false};
+
+    std::vector<char> m_taken_output;
+    std::thread m_thread;
+};
+}  // namespace ffi_go::ir
+
+#endif  // FFI_GO_IR_ZSTD_COMPRESSOR_HPP
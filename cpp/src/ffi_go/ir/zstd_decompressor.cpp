@@ -0,0 +1,50 @@
+#include "zstd_decompressor.h"
+
+#include <cstddef>
+
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <zstd.h>
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+
+namespace ffi_go::ir {
+using clp::ffi::ir_stream::IRErrorCode;
+
+CLP_FFI_GO_METHOD auto ir_zstd_decompressor_new() -> void* {
+    return ZSTD_createDStream();
+}
+
+CLP_FFI_GO_METHOD auto ir_zstd_decompressor_close(void* zstd_decompressor) -> void {
+    ZSTD_freeDStream(static_cast<ZSTD_DStream*>(zstd_decompressor));
+}
+
+CLP_FFI_GO_METHOD auto ir_zstd_decompressor_decompress(
+        void* zstd_decompressor,
+        ByteSpan src,
+        ByteSpan dst,
+        size_t* src_pos,
+        size_t* dst_pos,
+        bool* frame_done
+) -> int {
+    if (nullptr == zstd_decompressor || nullptr == src_pos || nullptr == dst_pos
+        || nullptr == frame_done)
+    {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+    ZSTD_inBuffer input{src.m_data, src.m_size, 0};
+    ZSTD_outBuffer output{dst.m_data, dst.m_size, 0};
+    size_t const ret{ZSTD_decompressStream(
+            static_cast<ZSTD_DStream*>(zstd_decompressor),
+            &output,
+            &input
+    )};
+    if (0 != ZSTD_isError(ret)) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Decode_Error);
+    }
+    *src_pos = input.pos;
+    *dst_pos = output.pos;
+    *frame_done = 0 == ret;
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+}  // namespace ffi_go::ir
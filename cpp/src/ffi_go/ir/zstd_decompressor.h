@@ -0,0 +1,53 @@
+#ifndef FFI_GO_IR_ZSTD_DECOMPRESSOR_H
+#define FFI_GO_IR_ZSTD_DECOMPRESSOR_H
+// header must support C, making modernize checks inapplicable
+// NOLINTBEGIN(modernize-use-trailing-return-type)
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+
+/**
+ * Create a zstd decompression stream to be used as the backing storage for a
+ * Go ir.Reader created by ir.NewZstdReader.
+ * @return Address of a new zstd decompression stream
+ * @return nullptr if the stream could not be allocated
+ */
+CLP_FFI_GO_METHOD void* ir_zstd_decompressor_new();
+
+/**
+ * Clean up the underlying zstd decompression stream of a Go ir.Reader.
+ * @param[in] zstd_decompressor Address of a zstd decompression stream created
+ *     and returned by ir_zstd_decompressor_new
+ */
+CLP_FFI_GO_METHOD void ir_zstd_decompressor_close(void* zstd_decompressor);
+
+/**
+ * Decompress zstd compressed data from src directly into dst, stopping once src
+ * is consumed or dst is full. Decompression may stop with src unconsumed
+ * (because dst is full) or with data still buffered in the stream, so the
+ * caller should call again with the remainder of src and a new dst. All
+ * pointer parameters must be non-null (non-nil Cgo C.<type> pointer or
+ * unsafe.Pointer from Go).
+ * @param[in] zstd_decompressor Address of a zstd decompression stream
+ * @param[in] src Compressed data to decompress
+ * @param[in] dst Buffer to decompress into (e.g. the unused space of a Go
+ *     ir.Reader's buffer)
+ * @param[out] src_pos Position in src read to
+ * @param[out] dst_pos Position in dst written to
+ * @param[out] frame_done True if the last zstd frame started was completely
+ *     decompressed and flushed into dst
+ * @return ffi::ir_stream::IRErrorCode_Success on success
+ * @return ffi::ir_stream::IRErrorCode_Decode_Error if src is not valid zstd
+ *     compressed data
+ */
+CLP_FFI_GO_METHOD int ir_zstd_decompressor_decompress(
+        void* zstd_decompressor,
+        ByteSpan src,
+        ByteSpan dst,
+        size_t* src_pos,
+        size_t* dst_pos,
+        bool* frame_done
+);
+
+// NOLINTEND(modernize-use-trailing-return-type)
+#endif  // FFI_GO_IR_ZSTD_DECOMPRESSOR_H
@@ -0,0 +1,350 @@
+#include "compiled_query.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ffi_go/search/wildcard_match.hpp"
+#include "ffi_go/search/wildcard_query.h"
+
+namespace ffi_go::search {
+namespace {
+constexpr size_t cBitsPerWord{std::numeric_limits<uint64_t>::digits};
+constexpr uint32_t cRootState{0};
+constexpr uint32_t cNoState{std::numeric_limits<uint32_t>::max()};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<uint64_t> next_id{0};
+
+/**
+ * @param c
+ * @return c converted to lower case if it is an ASCII upper case letter
+ */
+[[nodiscard]] constexpr auto fold_case(char c) -> uint8_t {
+    auto const byte{static_cast<uint8_t>(c)};
+    return ('A' <= byte && byte <= 'Z') ? static_cast<uint8_t>(byte - 'A' + 'a') : byte;
+}
+
+/**
+ * @param query Cleaned wildcard query (see `clean_up_wildcard_search_string`)
+ * @return The literals (maximal substrings without wildcards) in query, with
+ *     escapes removed
+ */
+[[nodiscard]] auto extract_literals(std::string_view query) -> std::vector<std::string> {
+    std::vector<std::string> literals;
+    std::string current;
+    for (size_t i{0}; i < query.size(); ++i) {
+        char c{query[i]};
+        if ('*' == c || '?' == c) {
+            if (false == current.empty()) {
+                literals.push_back(std::move(current));
+                current.clear();
+            }
+            continue;
+        }
+        if ('\\' == c) {
+            ++i;
+            if (query.size() <= i) {
+                break;
+            }
+            c = query[i];
+        }
+        current.push_back(c);
+    }
+    if (false == current.empty()) {
+        literals.push_back(std::move(current));
+    }
+    return literals;
+}
+
+/**
+ * @param query Cleaned wildcard query (see `clean_up_wildcard_search_string`)
+ * @return Whether query begins and ends with '*' and contains no '?', meaning
+ *     it matches every target containing its literals in order
+ */
+[[nodiscard]] auto is_ordered_literals_query(std::string_view query) -> bool {
+    bool ends_with_star{false};
+    for (size_t i{0}; i < query.size(); ++i) {
+        char const c{query[i]};
+        if ('?' == c) {
+            return false;
+        }
+        if ('\\' == c) {
+            ++i;
+            ends_with_star = false;
+            continue;
+        }
+        ends_with_star = ('*' == c);
+    }
+    return false == query.empty() && '*' == query.front() && ends_with_star;
+}
+
+/**
+ * @param literals
+ * @return The case folded longest literal in literals
+ */
+[[nodiscard]] auto get_longest_literal(std::vector<std::string> const& literals) -> std::string {
+    std::string longest;
+    for (auto const& literal : literals) {
+        if (literal.size() > longest.size()) {
+            longest = literal;
+        }
+    }
+    for (auto& c : longest) {
+        c = static_cast<char>(fold_case(c));
+    }
+    return longest;
+}
+}  // namespace
+
+CompiledQuery::CompiledQuery(MergedWildcardQueryView merged_query) : m_id{next_id++} {
+    std::string_view const query_view{merged_query.m_queries.m_data, merged_query.m_queries.m_size};
+    std::span<size_t const> const sizes{
+            merged_query.m_end_offsets.m_data,
+            merged_query.m_end_offsets.m_size
+    };
+    std::span<bool const> const case_sensitivity{
+            merged_query.m_case_sensitivity.m_data,
+            merged_query.m_case_sensitivity.m_size
+    };
+
+    m_queries.reserve(sizes.size());
+    std::vector<std::string> literals;
+    literals.reserve(sizes.size());
+    size_t pos{0};
+    for (size_t i{0}; i < sizes.size(); ++i) {
+        std::string query{query_view.substr(pos, sizes[i])};
+        auto query_literals{extract_literals(query)};
+        pos += sizes[i];
+        literals.push_back(get_longest_literal(query_literals));
+        bool const ordered_literals{is_ordered_literals_query(query)};
+        m_queries.push_back(
+                {std::move(query), std::move(query_literals), case_sensitivity[i], ordered_literals}
+        );
+    }
+    m_always_candidates = make_candidates();
+    for (size_t i{0}; i < literals.size(); ++i) {
+        if (literals[i].empty()) {
+            add_candidate(m_always_candidates, i);
+        }
+    }
+    build_automaton(literals);
+}
+
+auto CompiledQuery::make_candidates() const -> Candidates {
+    return Candidates((m_queries.size() + cBitsPerWord - 1) / cBitsPerWord);
+}
+
+auto CompiledQuery::add_candidate(Candidates& candidates, size_t query_idx) -> void {
+    candidates[query_idx / cBitsPerWord] |= uint64_t{1} << (query_idx % cBitsPerWord);
+}
+
+auto CompiledQuery::is_candidate(Candidates const& candidates, size_t query_idx) -> bool {
+    uint64_t const bit{uint64_t{1} << (query_idx % cBitsPerWord)};
+    return 0 != (candidates[query_idx / cBitsPerWord] & bit);
+}
+
+auto CompiledQuery::matches(size_t query_idx, std::string_view target) const -> bool {
+    auto const& query{m_queries[query_idx]};
+    return wildcard_match(target, query.m_query, query.m_case_sensitive);
+}
+
+auto CompiledQuery::is_compiled_from(MergedWildcardQueryView merged_query) const -> bool {
+    if (merged_query.m_end_offsets.m_size != m_queries.size()
+        || merged_query.m_case_sensitivity.m_size != m_queries.size())
+    {
+        return false;
+    }
+    std::string_view const query_view{merged_query.m_queries.m_data, merged_query.m_queries.m_size};
+    std::span<size_t const> const sizes{
+            merged_query.m_end_offsets.m_data,
+            merged_query.m_end_offsets.m_size
+    };
+    std::span<bool const> const case_sensitivity{
+            merged_query.m_case_sensitivity.m_data,
+            merged_query.m_case_sensitivity.m_size
+    };
+    size_t pos{0};
+    for (size_t i{0}; i < m_queries.size(); ++i) {
+        if (m_queries[i].m_case_sensitive != case_sensitivity[i]
+            || m_queries[i].m_query != query_view.substr(pos, sizes[i]))
+        {
+            return false;
+        }
+        pos += sizes[i];
+    }
+    return pos == query_view.size();
+}
+
+auto CompiledQuery::find_first_match(std::string_view target, Candidates& candidates) const
+        -> std::optional<size_t> {
+    candidates.assign(m_always_candidates.cbegin(), m_always_candidates.cend());
+    find_candidates(target, candidates);
+    return verify_candidates(target, candidates, nullptr);
+}
+
+auto CompiledQuery::find_first_match(
+        std::string_view target,
+        Candidates const& possible,
+        Candidates const& definite,
+        Candidates& candidates
+) const -> std::optional<size_t> {
+    candidates.assign(m_always_candidates.cbegin(), m_always_candidates.cend());
+    find_candidates(target, candidates);
+    for (size_t word_idx{0}; word_idx < candidates.size(); ++word_idx) {
+        candidates[word_idx] &= possible[word_idx];
+    }
+    return verify_candidates(target, candidates, &definite);
+}
+
+auto CompiledQuery::find_all_matches(
+        std::string_view target,
+        Candidates const& possible,
+        Candidates const& definite,
+        Candidates& matching_queries
+) const -> void {
+    matching_queries.assign(m_always_candidates.cbegin(), m_always_candidates.cend());
+    find_candidates(target, matching_queries);
+    for (size_t word_idx{0}; word_idx < matching_queries.size(); ++word_idx) {
+        uint64_t& word{matching_queries[word_idx]};
+        word &= possible[word_idx];
+        for (uint64_t unverified{word & ~definite[word_idx]}; 0 != unverified;
+             unverified &= unverified - 1)
+        {
+            auto const bit_idx{static_cast<size_t>(std::countr_zero(unverified))};
+            if (false == matches(word_idx * cBitsPerWord + bit_idx, target)) {
+                word &= ~(uint64_t{1} << bit_idx);
+            }
+        }
+    }
+}
+
+auto CompiledQuery::verify_candidates(
+        std::string_view target,
+        Candidates const& candidates,
+        Candidates const* definite
+) const -> std::optional<size_t> {
+    for (size_t word_idx{0}; word_idx < candidates.size(); ++word_idx) {
+        for (uint64_t word{candidates[word_idx]}; 0 != word; word &= word - 1) {
+            size_t const query_idx{
+                    word_idx * cBitsPerWord + static_cast<size_t>(std::countr_zero(word))
+            };
+            if ((nullptr != definite && is_candidate(*definite, query_idx))
+                || matches(query_idx, target))
+            {
+                return query_idx;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+auto CompiledQuery::build_automaton(std::vector<std::string> const& literals) -> void {
+    // Assign a class to every (folded) byte used by a literal, then map each
+    // byte to the class of its folded form.
+    std::array<uint8_t, cNumBytes> folded_byte_classes{};
+    for (auto const& literal : literals) {
+        for (char const c : literal) {
+            auto& byte_class{folded_byte_classes.at(static_cast<uint8_t>(c))};
+            if (0 == byte_class) {
+                byte_class = static_cast<uint8_t>(m_num_byte_classes++);
+            }
+        }
+    }
+    for (size_t byte{0}; byte < cNumBytes; ++byte) {
+        m_byte_classes.at(byte) = folded_byte_classes.at(fold_case(static_cast<char>(byte)));
+    }
+
+    // Build the trie of all literals.
+    m_transitions.assign(m_num_byte_classes, cNoState);
+    std::vector<std::vector<uint32_t>> own_outputs(1);
+    for (size_t query_idx{0}; query_idx < literals.size(); ++query_idx) {
+        auto const& literal{literals[query_idx]};
+        if (literal.empty()) {
+            continue;
+        }
+        uint32_t state{cRootState};
+        for (char const c : literal) {
+            auto const transition_idx{
+                    state * m_num_byte_classes + m_byte_classes.at(static_cast<uint8_t>(c))
+            };
+            if (cNoState == m_transitions[transition_idx]) {
+                auto const new_state{static_cast<uint32_t>(own_outputs.size())};
+                m_transitions[transition_idx] = new_state;
+                m_transitions.resize(m_transitions.size() + m_num_byte_classes, cNoState);
+                own_outputs.emplace_back();
+            }
+            state = m_transitions[transition_idx];
+        }
+        own_outputs[state].push_back(static_cast<uint32_t>(query_idx));
+    }
+    size_t const num_states{own_outputs.size()};
+
+    // Breadth first traversal computing the failure links, which completes the
+    // transition table into a DFA and merges each state's outputs with those of
+    // its failure state (always shallower, so already merged).
+    std::vector<uint32_t> failure(num_states, cRootState);
+    std::vector<std::vector<uint32_t>> outputs(num_states);
+    std::queue<uint32_t> states;
+    states.push(cRootState);
+    while (false == states.empty()) {
+        uint32_t const state{states.front()};
+        states.pop();
+        outputs[state] = own_outputs[state];
+        if (cRootState != state) {
+            auto const& failure_outputs{outputs[failure[state]]};
+            outputs[state].insert(
+                    outputs[state].end(),
+                    failure_outputs.cbegin(),
+                    failure_outputs.cend()
+            );
+        }
+        for (size_t byte_class{0}; byte_class < m_num_byte_classes; ++byte_class) {
+            auto& next{m_transitions[state * m_num_byte_classes + byte_class]};
+            uint32_t const failure_next{
+                    cRootState == state
+                            ? cRootState
+                            : m_transitions[failure[state] * m_num_byte_classes + byte_class]
+            };
+            if (cNoState == next) {
+                next = failure_next;
+            } else {
+                failure[next] = failure_next;
+                states.push(next);
+            }
+        }
+    }
+
+    m_output_offsets.reserve(num_states + 1);
+    m_output_offsets.push_back(0);
+    for (auto const& state_outputs : outputs) {
+        m_outputs.insert(m_outputs.end(), state_outputs.cbegin(), state_outputs.cend());
+        m_output_offsets.push_back(static_cast<uint32_t>(m_outputs.size()));
+    }
+}
+
+auto CompiledQuery::find_candidates(std::string_view target, Candidates& candidates) const
+        -> void {
+    if (m_outputs.empty()) {
+        return;
+    }
+    uint32_t state{cRootState};
+    for (char const c : target) {
+        state = m_transitions
+                [state * m_num_byte_classes + m_byte_classes.at(static_cast<uint8_t>(c))];
+        for (auto i{m_output_offsets[state]}; i < m_output_offsets[state + 1]; ++i) {
+            auto const query_idx{m_outputs[i]};
+            candidates[query_idx / cBitsPerWord] |= uint64_t{1} << (query_idx % cBitsPerWord);
+        }
+    }
+}
+}  // namespace ffi_go::search
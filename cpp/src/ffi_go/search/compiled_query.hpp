@@ -0,0 +1,208 @@
+#ifndef FFI_GO_SEARCH_COMPILED_QUERY_HPP
+#define FFI_GO_SEARCH_COMPILED_QUERY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ffi_go/search/wildcard_query.h"
+
+namespace ffi_go::search {
+/**
+ * A set of wildcard queries compiled so that a target can be matched against
+ * every query at once, rather than scanning it once per query. Matching is done
+ * in two phases:
+ * 1. An Aho-Corasick automaton, built over the longest literal (substring
+ *    without wildcards) of each query, scans the target once and marks every
+ *    query whose literal occurs in the target as a candidate. Queries without
+ *    any literal are always candidates.
+ * 2. Candidates are verified in index order using wildcard_match (which has
+ *    the same semantics as CLP's wildcard matching).
+ * The automaton runs over ASCII case folded bytes, so a single scan serves
+ * both case sensitive and case insensitive queries (a literal occurring in the
+ * target implies its folded form occurs in the folded target).
+ * A CompiledQuery is immutable once constructed and may be shared between
+ * threads, as long as each thread provides its own Candidates storage.
+ */
+class CompiledQuery {
+public:
+    // Types
+    /**
+     * Bitset of candidate queries found while matching a target. It is passed
+     * in by the caller so its memory can be reused across matches.
+     */
+    using Candidates = std::vector<uint64_t>;
+
+    // Constructors
+    /**
+     * Compile every query of a merged query.
+     * @param merged_query Queries to compile
+     */
+    explicit CompiledQuery(MergedWildcardQueryView merged_query);
+
+    // Methods
+    /**
+     * @return An identifier unique to this CompiledQuery within the process,
+     *     allowing state derived from it to be cached and invalidated
+     */
+    [[nodiscard]] auto get_id() const -> uint64_t { return m_id; }
+
+    [[nodiscard]] auto empty() const -> bool { return m_queries.empty(); }
+
+    [[nodiscard]] auto size() const -> size_t { return m_queries.size(); }
+
+    /**
+     * @param query_idx
+     * @return The literals (maximal substrings without wildcards) of the query
+     *     at query_idx, with escapes removed. Every literal must occur in a
+     *     target for the query to match it.
+     */
+    [[nodiscard]] auto get_literals(size_t query_idx) const -> std::vector<std::string> const& {
+        return m_queries[query_idx].m_literals;
+    }
+
+    [[nodiscard]] auto is_case_sensitive(size_t query_idx) const -> bool {
+        return m_queries[query_idx].m_case_sensitive;
+    }
+
+    /**
+     * @param query_idx
+     * @return Whether the query at query_idx matches every target containing
+     *     its literals in order without overlap (i.e. the query begins and ends
+     *     with '*' and contains no '?')
+     */
+    [[nodiscard]] auto matches_ordered_literals(size_t query_idx) const -> bool {
+        return m_queries[query_idx].m_ordered_literals;
+    }
+
+    /**
+     * @return A Candidates bitset able to hold every query, with no query set
+     */
+    [[nodiscard]] auto make_candidates() const -> Candidates;
+
+    /**
+     * Add the query at query_idx to candidates.
+     */
+    static auto add_candidate(Candidates& candidates, size_t query_idx) -> void;
+
+    /**
+     * @return Whether the query at query_idx is in candidates
+     */
+    [[nodiscard]] static auto is_candidate(Candidates const& candidates, size_t query_idx) -> bool;
+
+    /**
+     * @param query_idx
+     * @param target
+     * @return Whether the query at query_idx matches target
+     */
+    [[nodiscard]] auto matches(size_t query_idx, std::string_view target) const -> bool;
+
+    /**
+     * @param merged_query
+     * @return Whether this CompiledQuery was compiled from the same queries (in
+     *     the same order) as merged_query
+     */
+    [[nodiscard]] auto is_compiled_from(MergedWildcardQueryView merged_query) const -> bool;
+
+    /**
+     * Find the first query (by index) that matches target.
+     * @param target String to perform matching on
+     * @param candidates Storage for the candidate queries of target
+     * @return Index of the first query matching target
+     * @return std::nullopt if no query matches target
+     */
+    [[nodiscard]] auto
+    find_first_match(std::string_view target, Candidates& candidates) const
+            -> std::optional<size_t>;
+
+    /**
+     * Find the first query (by index) that matches target, given prior
+     * knowledge of which queries can match it (e.g. from the logtype of an
+     * encoded log message).
+     * @param target String to perform matching on
+     * @param possible Bitset of the queries that may match target
+     * @param definite Bitset of the queries known to match target, which are
+     *     not verified
+     * @param candidates Storage for the candidate queries of target
+     * @return Index of the first query matching target
+     * @return std::nullopt if no query matches target
+     */
+    [[nodiscard]] auto find_first_match(
+            std::string_view target,
+            Candidates const& possible,
+            Candidates const& definite,
+            Candidates& candidates
+    ) const -> std::optional<size_t>;
+
+    /**
+     * Find every query that matches target, given prior knowledge of which
+     * queries can match it (as for find_first_match).
+     * @param target String to perform matching on
+     * @param possible Bitset of the queries that may match target
+     * @param definite Bitset of the queries known to match target, which are
+     *     not verified
+     * @param matching_queries Returns the bitset of the queries matching
+     *     target
+     */
+    auto find_all_matches(
+            std::string_view target,
+            Candidates const& possible,
+            Candidates const& definite,
+            Candidates& matching_queries
+    ) const -> void;
+
+private:
+    struct Query {
+        std::string m_query;
+        std::vector<std::string> m_literals;
+        bool m_case_sensitive;
+        bool m_ordered_literals;
+    };
+
+    static constexpr size_t cNumBytes{256};
+
+    /**
+     * Build the automaton over the literal of each query.
+     * @param literals Case folded literal of each query (empty if the query has
+     *     no literal)
+     */
+    auto build_automaton(std::vector<std::string> const& literals) -> void;
+
+    /**
+     * Scan target with the automaton, marking each query whose literal occurs
+     * in target in candidates.
+     */
+    auto find_candidates(std::string_view target, Candidates& candidates) const -> void;
+
+    /**
+     * Verify candidates in index order, skipping verification of the queries
+     * in definite (if non-null).
+     * @return Index of the first candidate matching target
+     * @return std::nullopt if no candidate matches target
+     */
+    [[nodiscard]] auto verify_candidates(
+            std::string_view target,
+            Candidates const& candidates,
+            Candidates const* definite
+    ) const -> std::optional<size_t>;
+
+    uint64_t m_id;
+    std::vector<Query> m_queries;
+    Candidates m_always_candidates;
+
+    // Bytes are mapped into classes of bytes that the automaton does not need
+    // to distinguish, keeping the transition table dense and small. Class 0
+    // holds every byte that does not occur in a literal.
+    std::array<uint8_t, cNumBytes> m_byte_classes{};
+    size_t m_num_byte_classes{1};
+    std::vector<uint32_t> m_transitions;
+    std::vector<uint32_t> m_output_offsets;
+    std::vector<uint32_t> m_outputs;
+};
+}  // namespace ffi_go::search
+
+#endif  // FFI_GO_SEARCH_COMPILED_QUERY_HPP
@@ -0,0 +1,284 @@
+#include "numeric_query.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/encoding_methods.hpp>
+#include <clp/ir/types.hpp>
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/search/numeric_query.h"
+#include "ffi_go/search/wildcard_match.hpp"
+#include "ffi_go/search/wildcard_query.h"
+
+namespace ffi_go::search {
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::four_byte_encoded_variable_t;
+using clp::ir::VariablePlaceholder;
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<uint64_t> next_id{0};
+
+// Length of the numbers parse_number copies without allocating.
+constexpr size_t cMaxShortNumberLength{63};
+
+// 10^i for every number of digits an encoded float can have, as exact doubles.
+constexpr auto cPowersOf10{[] {
+    std::array<double, 20> powers{};
+    double power{1};
+    for (auto& p : powers) {
+        p = power;
+        power *= 10;
+    }
+    return powers;
+}()};
+
+/**
+ * @param lhs
+ * @param comparison
+ * @param rhs
+ * @return Whether `lhs <comparison> rhs` holds
+ */
+[[nodiscard]] auto compare(double lhs, NumericComparison comparison, double rhs) -> bool;
+
+/**
+ * Decode an encoded float variable into a double. The digits stored by the
+ * encoding are converted to a double and divided by an exact power of 10 for
+ * the decimal point position. Digits below 2^53 (every four byte float, and
+ * eight byte floats of up to 15 digits) convert exactly, giving the double
+ * closest to the float's text. Larger digits are rounded before the division,
+ * so the result may be one rounding further from the text.
+ * @param var
+ * @return The value of var
+ * @return std::nullopt if var isn't a valid encoded float
+ */
+template <typename encoded_variable_t>
+[[nodiscard]] auto decode_float(encoded_variable_t var) -> std::optional<double>;
+
+/**
+ * @param text
+ * @return The value of text if it is entirely a decimal number: an optional
+ *     '-', then digits with at most one '.' among them (no sign, exponent,
+ *     whitespace, or hexadecimal, infinity, or NaN forms)
+ * @return std::nullopt otherwise
+ */
+[[nodiscard]] auto parse_number(std::string_view text) -> std::optional<double>;
+
+auto compare(double lhs, NumericComparison comparison, double rhs) -> bool {
+    switch (comparison) {
+        case NumericComparison::Less:
+            return lhs < rhs;
+        case NumericComparison::LessOrEqual:
+            return lhs <= rhs;
+        case NumericComparison::Equal:
+            return lhs == rhs;
+        case NumericComparison::NotEqual:
+            return lhs != rhs;
+        case NumericComparison::GreaterOrEqual:
+            return lhs >= rhs;
+        case NumericComparison::Greater:
+            return lhs > rhs;
+        default:
+            return false;
+    }
+}
+
+template <typename encoded_variable_t>
+auto decode_float(encoded_variable_t var) -> std::optional<double> {
+    bool is_negative{false};
+    std::conditional_t<
+            std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>,
+            uint64_t,
+            uint32_t>
+            digits{0};
+    size_t num_digits{0};
+    size_t decimal_point_pos{0};
+    clp::ffi::decode_float_properties(var, is_negative, digits, num_digits, decimal_point_pos);
+    // Rejected when decoding the message (see ir::append_float_var).
+    if (num_digits < decimal_point_pos || cPowersOf10.size() <= num_digits
+        || static_cast<double>(digits) >= cPowersOf10[num_digits])
+    {
+        return std::nullopt;
+    }
+    auto const value{static_cast<double>(digits) / cPowersOf10[decimal_point_pos]};
+    return is_negative ? -value : value;
+}
+
+auto parse_number(std::string_view text) -> std::optional<double> {
+    size_t pos{0};
+    if (pos < text.size() && '-' == text[pos]) {
+        ++pos;
+    }
+    size_t num_digits{0};
+    bool has_decimal_point{false};
+    for (; pos < text.size(); ++pos) {
+        char const c{text[pos]};
+        if ('0' <= c && c <= '9') {
+            ++num_digits;
+        } else if ('.' == c && false == has_decimal_point) {
+            has_decimal_point = true;
+        } else {
+            return std::nullopt;
+        }
+    }
+    if (0 == num_digits) {
+        return std::nullopt;
+    }
+
+    // strtod requires a null terminated string. As text was validated above,
+    // only the decimal point is locale dependent, and Go programs run in the
+    // "C" locale. (Floating point std::from_chars isn't used as libc++ lacks
+    // it before LLVM 20.)
+    std::array<char, cMaxShortNumberLength + 1> short_buf{};
+    std::string long_buf;
+    char const* str{short_buf.data()};
+    if (text.size() < short_buf.size()) {
+        text.copy(short_buf.data(), text.size());
+    } else {
+        long_buf = text;
+        str = long_buf.c_str();
+    }
+    return std::strtod(str, nullptr);
+}
+}  // namespace
+
+NumericQuery::NumericQuery(
+        std::string logtype_query,
+        bool case_sensitive,
+        std::vector<Predicate> predicates
+)
+        : m_id{next_id++},
+          m_logtype_query{std::move(logtype_query)},
+          m_case_sensitive{case_sensitive},
+          m_predicates{std::move(predicates)} {}
+
+auto NumericQuery::resolve_logtype(std::string_view logtype) const
+        -> std::optional<VariableRefs> {
+    // The logtype without escape characters, and where each of its variables
+    // is found.
+    std::string unescaped;
+    unescaped.reserve(logtype.size());
+    std::vector<VariableRef> logtype_vars;
+    size_t num_encoded_vars{0};
+    size_t num_dict_vars{0};
+    for (size_t pos{0}; pos < logtype.size(); ++pos) {
+        char const c{logtype[pos]};
+        auto const placeholder{static_cast<VariablePlaceholder>(c)};
+        switch (placeholder) {
+            case VariablePlaceholder::Integer:
+            case VariablePlaceholder::Float:
+                logtype_vars.push_back({placeholder, num_encoded_vars++});
+                break;
+            case VariablePlaceholder::Dictionary:
+                logtype_vars.push_back({placeholder, num_dict_vars++});
+                break;
+            case VariablePlaceholder::Escape:
+                if (logtype.size() - 1 == pos) {
+                    return std::nullopt;
+                }
+                unescaped.push_back(logtype[++pos]);
+                continue;
+            default:
+                break;
+        }
+        unescaped.push_back(c);
+    }
+    if (false == wildcard_match(unescaped, m_logtype_query, m_case_sensitive)) {
+        return std::nullopt;
+    }
+
+    VariableRefs variables;
+    variables.reserve(m_predicates.size());
+    for (auto const& predicate : m_predicates) {
+        if (logtype_vars.size() <= predicate.m_var_index) {
+            return std::nullopt;
+        }
+        variables.push_back(logtype_vars[predicate.m_var_index]);
+    }
+    return variables;
+}
+
+template <typename encoded_variable_t>
+auto NumericQuery::matches(
+        VariableRefs const& variables,
+        std::span<encoded_variable_t const> vars,
+        std::span<std::string const> dict_vars
+) const -> bool {
+    for (size_t i{0}; i < m_predicates.size(); ++i) {
+        auto const& [placeholder, index]{variables[i]};
+        std::optional<double> value;
+        if (VariablePlaceholder::Dictionary == placeholder) {
+            if (dict_vars.size() <= index) {
+                return false;
+            }
+            value = parse_number(dict_vars[index]);
+        } else {
+            if (vars.size() <= index) {
+                return false;
+            }
+            if (VariablePlaceholder::Integer == placeholder) {
+                value = static_cast<double>(static_cast<int64_t>(vars[index]));
+            } else {
+                value = decode_float(vars[index]);
+            }
+        }
+        auto const& predicate{m_predicates[i]};
+        if (false == value.has_value()
+            || false == compare(value.value(), predicate.m_comparison, predicate.m_value))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template auto NumericQuery::matches(
+        VariableRefs const& variables,
+        std::span<eight_byte_encoded_variable_t const> vars,
+        std::span<std::string const> dict_vars
+) const -> bool;
+template auto NumericQuery::matches(
+        VariableRefs const& variables,
+        std::span<four_byte_encoded_variable_t const> vars,
+        std::span<std::string const> dict_vars
+) const -> bool;
+
+CLP_FFI_GO_METHOD auto
+numeric_query_new(WildcardQueryView logtype_query, NumericPredicateSpan predicates) -> void* {
+    std::span<NumericPredicateView const> const views{predicates.m_data, predicates.m_size};
+    std::vector<NumericQuery::Predicate> query_predicates;
+    query_predicates.reserve(views.size());
+    for (auto const& view : views) {
+        if (view.m_comparison < static_cast<int8_t>(NumericComparison::Less)
+            || static_cast<int8_t>(NumericComparison::Greater) < view.m_comparison)
+        {
+            return nullptr;
+        }
+        query_predicates.push_back(
+                {view.m_var_index, static_cast<NumericComparison>(view.m_comparison), view.m_value}
+        );
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    return new NumericQuery{
+            {logtype_query.m_query.m_data, logtype_query.m_query.m_size},
+            logtype_query.m_case_sensitive,
+            std::move(query_predicates)
+    };
+}
+
+CLP_FFI_GO_METHOD auto numeric_query_delete(void* numeric_query) -> void {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    delete static_cast<NumericQuery*>(numeric_query);
+}
+}  // namespace ffi_go::search
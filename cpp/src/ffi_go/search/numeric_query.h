@@ -0,0 +1,53 @@
+#ifndef FFI_GO_SEARCH_NUMERIC_QUERY_H
+#define FFI_GO_SEARCH_NUMERIC_QUERY_H
+// header must support C, making modernize checks inapplicable
+// NOLINTBEGIN(modernize-use-trailing-return-type)
+// NOLINTBEGIN(modernize-use-using)
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+#include "ffi_go/search/wildcard_query.h"
+
+/**
+ * A view of a Go search.NumericPredicate passed down through Cgo, comparing
+ * the variable at m_var_index (among all variables of a log message, in order)
+ * against m_value. m_comparison is one of: 0 (<), 1 (<=), 2 (==), 3 (!=),
+ * 4 (>=), or 5 (>), with the variable on the left hand side.
+ */
+typedef struct {
+    size_t m_var_index;
+    double m_value;
+    int8_t m_comparison;
+} NumericPredicateView;
+
+/**
+ * A span of a NumericPredicateView array passed down through Cgo.
+ */
+typedef struct {
+    NumericPredicateView* m_data;
+    size_t m_size;
+} NumericPredicateSpan;
+
+/**
+ * Create a search::NumericQuery matching the log events whose logtype matches
+ * logtype_query and whose variables satisfy every predicate (see
+ * search::NumericQuery), which can be reused to search any number of streams
+ * (e.g. passed to ir_deserializer_deserialize_*_numeric_query_match).
+ * @param[in] logtype_query Wildcard query over the logtype of a log event
+ * @param[in] predicates Comparisons on the variables of a log event
+ * @return Address of a new search::NumericQuery
+ * @return nullptr if a predicate's comparison is invalid
+ */
+CLP_FFI_GO_METHOD void*
+numeric_query_new(WildcardQueryView logtype_query, NumericPredicateSpan predicates);
+
+/**
+ * Delete a search::NumericQuery.
+ * @param[in] numeric_query Address of a search::NumericQuery created and
+ *   returned by numeric_query_new
+ */
+CLP_FFI_GO_METHOD void numeric_query_delete(void* numeric_query);
+
+// NOLINTEND(modernize-use-using)
+// NOLINTEND(modernize-use-trailing-return-type)
+#endif  // FFI_GO_SEARCH_NUMERIC_QUERY_H
@@ -0,0 +1,112 @@
+#ifndef FFI_GO_SEARCH_NUMERIC_QUERY_HPP
+#define FFI_GO_SEARCH_NUMERIC_QUERY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+namespace ffi_go::search {
+/**
+ * The comparisons of a NumericQuery::Predicate, with the values of
+ * NumericPredicateView::m_comparison.
+ */
+enum class NumericComparison : int8_t {
+    Less,
+    LessOrEqual,
+    Equal,
+    NotEqual,
+    GreaterOrEqual,
+    Greater,
+};
+
+/**
+ * A wildcard query over the logtype of a log event combined with comparisons
+ * on its numeric variables, evaluated on the log event's encoded variables
+ * without decoding its log message. The logtype query is matched (with the
+ * semantics of wildcard_match) against the logtype with its escape characters
+ * removed, where each variable is a single placeholder character matched by
+ * '?' or '*' (e.g. "*latency=* ms*"). A log event matches if its logtype
+ * matches and every predicate holds for it.
+ *
+ * A predicate compares the variable at an index among all variables of the log
+ * message, and only holds if the variable is a number. Encoded integers are
+ * compared as doubles (rounding those beyond 2^53), and encoded floats as their
+ * decoded text would be parsed (except for possibly one more rounding of floats
+ * of 16 digits). A dictionary variable is parsed as a double if its text is a
+ * decimal number, as CLP stores numbers it cannot encode (e.g. integers beyond
+ * the range of four byte encoding) as dictionary variables.
+ * A NumericQuery is immutable once constructed and may be shared between
+ * threads.
+ */
+class NumericQuery {
+public:
+    // Types
+    struct Predicate {
+        size_t m_var_index;
+        NumericComparison m_comparison;
+        double m_value;
+    };
+
+    /**
+     * Where the variable compared by a predicate is found in a log event: the
+     * index among its encoded variables (for an integer or float placeholder)
+     * or dictionary variables (for a dictionary placeholder).
+     */
+    struct VariableRef {
+        clp::ir::VariablePlaceholder m_placeholder;
+        size_t m_index;
+    };
+
+    using VariableRefs = std::vector<VariableRef>;
+
+    // Constructors
+    NumericQuery(std::string logtype_query, bool case_sensitive, std::vector<Predicate> predicates);
+
+    // Methods
+    /**
+     * @return An identifier unique to this NumericQuery within the process,
+     *     allowing state derived from it to be cached and invalidated
+     */
+    [[nodiscard]] auto get_id() const -> uint64_t { return m_id; }
+
+    /**
+     * Evaluate the logtype query against a logtype, resolving where the
+     * variable of each predicate is found in log events with the logtype. The
+     * result only depends on the logtype, so it can be cached per logtype.
+     * @param logtype
+     * @return The variable of each predicate (in order)
+     * @return std::nullopt if the logtype query doesn't match logtype, or a
+     *     predicate's variable index is beyond the logtype's variables
+     */
+    [[nodiscard]] auto resolve_logtype(std::string_view logtype) const
+            -> std::optional<VariableRefs>;
+
+    /**
+     * @param variables The variable of each predicate, resolved from the log
+     *     event's logtype by resolve_logtype
+     * @param vars The log event's encoded variables
+     * @param dict_vars The log event's dictionary variables
+     * @return Whether every predicate holds for the log event
+     */
+    template <typename encoded_variable_t>
+    [[nodiscard]] auto matches(
+            VariableRefs const& variables,
+            std::span<encoded_variable_t const> vars,
+            std::span<std::string const> dict_vars
+    ) const -> bool;
+
+private:
+    uint64_t m_id;
+    std::string m_logtype_query;
+    bool m_case_sensitive;
+    std::vector<Predicate> m_predicates;
+};
+}  // namespace ffi_go::search
+
+#endif  // FFI_GO_SEARCH_NUMERIC_QUERY_HPP
@@ -0,0 +1,548 @@
+#include "search_engine.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
+#include <clp/ffi/ir_stream/protocol_constants.hpp>
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+#include "ffi_go/ir/deserializer.h"
+#include "ffi_go/ir/types.hpp"
+#include "ffi_go/search/compiled_query.hpp"
+#include "ffi_go/search/search_engine.hpp"
+#include "ffi_go/search/wildcard_query.h"
+
+namespace ffi_go::search {
+using clp::ffi::ir_stream::IRErrorCode;
+namespace Metadata = clp::ffi::ir_stream::cProtocol::Metadata;
+
+namespace {
+/**
+ * Read the entire contents of the file at path into buf.
+ * @param path
+ * @param buf
+ * @return Whether the file was read
+ */
+[[nodiscard]] auto read_file(std::string const& path, std::vector<char>& buf) -> bool;
+
+/**
+ * Create a SearchEngine, without letting an exception escape the C API.
+ * @param sources
+ * @param compiled_query
+ * @param time_interval
+ * @param num_threads
+ * @param result_capacity
+ * @return Address of the new SearchEngine
+ * @return nullptr if the SearchEngine couldn't be created (e.g. its worker
+ *     threads couldn't be started)
+ */
+[[nodiscard]] auto new_search_engine(
+        std::vector<SearchEngine::Source> sources,
+        CompiledQuery const& compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+) -> void*;
+
+/**
+ * Skip past any JSON whitespace in json starting at pos.
+ * @param json
+ * @param pos
+ */
+auto skip_json_whitespace(std::string_view json, size_t& pos) -> void;
+
+/**
+ * Scan the JSON string starting at pos (its opening quote).
+ * @param json
+ * @param pos Updated to the position after the string's closing quote
+ * @return The string's contents, without unescaping
+ * @return std::nullopt if pos isn't the start of a terminated string
+ */
+[[nodiscard]] auto scan_json_string(std::string_view json, size_t& pos)
+        -> std::optional<std::string_view>;
+
+/**
+ * Skip the JSON value starting at pos, including any nested objects or arrays.
+ * @param json
+ * @param pos Updated to the position after the value
+ * @return Whether a value was skipped
+ */
+[[nodiscard]] auto skip_json_value(std::string_view json, size_t& pos) -> bool;
+
+/**
+ * @param metadata JSON metadata of a four byte encoded IR stream
+ * @return The stream's reference timestamp, or 0 if it has none
+ * @return std::nullopt if metadata isn't a JSON object, or its reference
+ *     timestamp isn't a string of an integer
+ */
+[[nodiscard]] auto get_reference_timestamp(std::string_view metadata)
+        -> std::optional<epoch_time_ms_t>;
+
+auto read_file(std::string const& path, std::vector<char>& buf) -> bool {
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (false == file.is_open()) {
+        return false;
+    }
+    auto const size{file.tellg()};
+    if (size < 0) {
+        return false;
+    }
+    buf.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(buf.data(), size));
+}
+
+auto new_search_engine(
+        std::vector<SearchEngine::Source> sources,
+        CompiledQuery const& compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+) -> void* {
+    try {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        return new SearchEngine{
+                std::move(sources),
+                compiled_query,
+                time_interval,
+                num_threads,
+                result_capacity
+        };
+    } catch (std::exception const&) {
+        return nullptr;
+    }
+}
+
+auto skip_json_whitespace(std::string_view json, size_t& pos) -> void {
+    pos = std::min(json.find_first_not_of(" \t\r\n", pos), json.size());
+}
+
+auto scan_json_string(std::string_view json, size_t& pos) -> std::optional<std::string_view> {
+    if (json.size() <= pos || '"' != json[pos]) {
+        return std::nullopt;
+    }
+    for (size_t end{pos + 1}; end < json.size(); ++end) {
+        if ('\\' == json[end]) {
+            ++end;
+        } else if ('"' == json[end]) {
+            auto const contents{json.substr(pos + 1, end - pos - 1)};
+            pos = end + 1;
+            return contents;
+        }
+    }
+    return std::nullopt;
+}
+
+auto skip_json_value(std::string_view json, size_t& pos) -> bool {
+    if (json.size() <= pos) {
+        return false;
+    }
+    if ('"' == json[pos]) {
+        return scan_json_string(json, pos).has_value();
+    }
+    if ('{' != json[pos] && '[' != json[pos]) {
+        // A number, true, false, or null.
+        auto const end{std::min(json.find_first_of(",}] \t\r\n", pos), json.size())};
+        if (pos == end) {
+            return false;
+        }
+        pos = end;
+        return true;
+    }
+    size_t depth{0};
+    while (pos < json.size()) {
+        switch (json[pos]) {
+            case '"':
+                if (false == scan_json_string(json, pos).has_value()) {
+                    return false;
+                }
+                continue;
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                --depth;
+                break;
+            default:
+                break;
+        }
+        ++pos;
+        if (0 == depth) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto get_reference_timestamp(std::string_view metadata) -> std::optional<epoch_time_ms_t> {
+    size_t pos{0};
+    skip_json_whitespace(metadata, pos);
+    if (metadata.size() <= pos || '{' != metadata[pos]) {
+        return std::nullopt;
+    }
+    ++pos;
+    skip_json_whitespace(metadata, pos);
+    std::optional<std::string_view> timestamp_str;
+    bool is_end_of_object{pos < metadata.size() && '}' == metadata[pos]};
+    if (is_end_of_object) {
+        ++pos;
+    }
+    while (false == is_end_of_object) {
+        auto const key{scan_json_string(metadata, pos)};
+        skip_json_whitespace(metadata, pos);
+        if (false == key.has_value() || metadata.size() <= pos || ':' != metadata[pos]) {
+            return std::nullopt;
+        }
+        ++pos;
+        skip_json_whitespace(metadata, pos);
+        if (Metadata::ReferenceTimestampKey == key.value()) {
+            timestamp_str = scan_json_string(metadata, pos);
+            if (false == timestamp_str.has_value()) {
+                return std::nullopt;
+            }
+        } else if (false == skip_json_value(metadata, pos)) {
+            return std::nullopt;
+        }
+        skip_json_whitespace(metadata, pos);
+        if (metadata.size() <= pos || (',' != metadata[pos] && '}' != metadata[pos])) {
+            return std::nullopt;
+        }
+        is_end_of_object = '}' == metadata[pos];
+        ++pos;
+        skip_json_whitespace(metadata, pos);
+    }
+    skip_json_whitespace(metadata, pos);
+    if (metadata.size() != pos) {
+        return std::nullopt;
+    }
+    if (false == timestamp_str.has_value()) {
+        return 0;
+    }
+
+    epoch_time_ms_t timestamp{0};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto const* const end{timestamp_str->data() + timestamp_str->size()};
+    auto const [ptr, ec]{std::from_chars(timestamp_str->data(), end, timestamp)};
+    if (std::errc{} != ec || end != ptr) {
+        return std::nullopt;
+    }
+    return timestamp;
+}
+}  // namespace
+
+SearchEngine::SearchEngine(
+        std::vector<Source> sources,
+        CompiledQuery const& compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+)
+        : m_sources{std::move(sources)},
+          m_compiled_query{compiled_query},
+          m_time_interval{time_interval},
+          m_source_errors(m_sources.size()),
+          m_work_queues(std::min(std::max(num_threads, size_t{1}), m_sources.size())),
+          m_results(std::max(result_capacity, size_t{1})),
+          m_num_running_workers{m_work_queues.size()} {
+    for (size_t i{0}; i < m_sources.size(); ++i) {
+        m_source_errors[i] = static_cast<int>(IRErrorCode::IRErrorCode_Success);
+        m_work_queues[i % m_work_queues.size()].m_source_indices.push_back(i);
+    }
+    m_workers.reserve(m_work_queues.size());
+    try {
+        for (size_t i{0}; i < m_work_queues.size(); ++i) {
+            m_workers.emplace_back([this, i] { run_worker(i); });
+        }
+    } catch (std::exception const&) {
+        // The destructor doesn't run for a throwing constructor, so the
+        // workers already started must be joined here.
+        stop_workers();
+        throw;
+    }
+}
+
+SearchEngine::~SearchEngine() {
+    stop_workers();
+}
+
+auto SearchEngine::next_results(size_t max_results) -> std::span<Result const> {
+    std::unique_lock lock{m_results_mutex};
+    m_results_not_empty.wait(lock, [this] {
+        return 0 != m_num_results || 0 == m_num_running_workers || m_cancelled;
+    });
+    size_t const num_results{std::min(m_num_results, max_results)};
+    m_removed_results.resize(num_results);
+    // Swap rather than move the results out, so the ring buffer keeps reusing
+    // the log message strings' memory.
+    for (auto& result : m_removed_results) {
+        std::swap(result, m_results[m_results_head]);
+        m_results_head = (m_results_head + 1) % m_results.size();
+    }
+    m_num_results -= num_results;
+    lock.unlock();
+    m_results_not_full.notify_all();
+    return m_removed_results;
+}
+
+auto SearchEngine::get_source_error(size_t source_idx) const -> int {
+    return m_source_errors[source_idx];
+}
+
+auto SearchEngine::stop_workers() -> void {
+    {
+        std::lock_guard const lock{m_results_mutex};
+        m_cancelled = true;
+    }
+    m_results_not_full.notify_all();
+    m_results_not_empty.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+auto SearchEngine::run_worker(size_t worker_idx) -> void {
+    std::vector<char> file_buf;
+    Result result{};
+    for (auto source_idx{get_next_source(worker_idx)};
+         source_idx.has_value() && false == m_cancelled;
+         source_idx = get_next_source(worker_idx))
+    {
+        m_source_errors[source_idx.value()] = search_source(source_idx.value(), file_buf, result);
+    }
+    {
+        std::lock_guard const lock{m_results_mutex};
+        --m_num_running_workers;
+    }
+    m_results_not_empty.notify_all();
+}
+
+auto SearchEngine::get_next_source(size_t worker_idx) -> std::optional<size_t> {
+    {
+        auto& queue{m_work_queues[worker_idx]};
+        std::lock_guard const lock{queue.m_mutex};
+        if (false == queue.m_source_indices.empty()) {
+            auto const source_idx{queue.m_source_indices.front()};
+            queue.m_source_indices.pop_front();
+            return source_idx;
+        }
+    }
+    for (size_t i{1}; i < m_work_queues.size(); ++i) {
+        auto& queue{m_work_queues[(worker_idx + i) % m_work_queues.size()]};
+        std::lock_guard const lock{queue.m_mutex};
+        if (false == queue.m_source_indices.empty()) {
+            auto const source_idx{queue.m_source_indices.back()};
+            queue.m_source_indices.pop_back();
+            return source_idx;
+        }
+    }
+    return std::nullopt;
+}
+
+auto SearchEngine::search_source(size_t source_idx, std::vector<char>& file_buf, Result& result)
+        -> int {
+    auto const& source{m_sources[source_idx]};
+    ByteSpan ir_view{source.m_buffer};
+    if (false == source.m_path.empty()) {
+        if (false == read_file(source.m_path, file_buf)) {
+            return cReadError;
+        }
+        ir_view = {file_buf.data(), file_buf.size()};
+    }
+    auto* const ir_data{static_cast<char*>(ir_view.m_data)};
+
+    size_t pos{0};
+    int8_t ir_encoding{};
+    int8_t metadata_type{};
+    size_t metadata_pos{0};
+    uint16_t metadata_size{0};
+    void* deserializer_ptr{nullptr};
+    void* timestamp_ptr{nullptr};
+    if (auto const err{ir_deserializer_new_deserializer_with_preamble(
+                ir_view,
+                &pos,
+                &ir_encoding,
+                &metadata_type,
+                &metadata_pos,
+                &metadata_size,
+                &deserializer_ptr,
+                &timestamp_ptr
+        )};
+        static_cast<int>(IRErrorCode::IRErrorCode_Success) != err)
+    {
+        return err;
+    }
+    std::unique_ptr<void, decltype(&ir_deserializer_close)> const deserializer{
+            deserializer_ptr,
+            &ir_deserializer_close
+    };
+    if (Metadata::EncodingJson != metadata_type) {
+        return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+    }
+
+    auto* deserialize_match{&ir_deserializer_deserialize_eight_byte_compiled_query_match};
+    if (1 == ir_encoding) {
+        auto const reference_timestamp{
+                get_reference_timestamp({ir_data + metadata_pos, metadata_size})
+        };
+        if (false == reference_timestamp.has_value()) {
+            return static_cast<int>(IRErrorCode::IRErrorCode_Corrupted_IR);
+        }
+        *static_cast<epoch_time_ms_t*>(timestamp_ptr) = reference_timestamp.value();
+        deserialize_match = &ir_deserializer_deserialize_four_byte_compiled_query_match;
+    }
+
+    // The C API takes the compiled query as a void*, but does not modify it.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    auto* const compiled_query{const_cast<CompiledQuery*>(&m_compiled_query)};
+    while (false == m_cancelled) {
+        size_t end_pos{0};
+        LogEventView log_event{};
+        size_t matching_query{0};
+        auto const err{deserialize_match(
+                {ir_data + pos, ir_view.m_size - pos},
+                deserializer.get(),
+                m_time_interval,
+                compiled_query,
+                &end_pos,
+                &log_event,
+                &matching_query
+        )};
+        if (static_cast<int>(IRErrorCode::IRErrorCode_Eof) == err
+            || ir::cEndOfTimeInterval == err)
+        {
+            break;
+        }
+        if (static_cast<int>(IRErrorCode::IRErrorCode_Success) != err) {
+            return err;
+        }
+        pos += end_pos;
+        result.m_source_idx = source_idx;
+        result.m_matching_query = matching_query;
+        result.m_timestamp = log_event.m_timestamp;
+        result.m_log_message.assign(log_event.m_log_message.m_data, log_event.m_log_message.m_size);
+        if (false == push_result(result)) {
+            break;
+        }
+    }
+    return static_cast<int>(IRErrorCode::IRErrorCode_Success);
+}
+
+auto SearchEngine::push_result(Result& result) -> bool {
+    std::unique_lock lock{m_results_mutex};
+    m_results_not_full.wait(lock, [this] {
+        return m_num_results < m_results.size() || m_cancelled;
+    });
+    if (m_cancelled) {
+        return false;
+    }
+    std::swap(result, m_results[(m_results_head + m_num_results) % m_results.size()]);
+    ++m_num_results;
+    lock.unlock();
+    m_results_not_empty.notify_one();
+    return true;
+}
+
+CLP_FFI_GO_METHOD auto search_engine_search_buffers(
+        ByteSpanSpan buffers,
+        void* compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+) -> void* {
+    if (nullptr == compiled_query) {
+        return nullptr;
+    }
+    std::vector<SearchEngine::Source> sources;
+    sources.reserve(buffers.m_size);
+    for (auto const& buffer : std::span<ByteSpan const>{buffers.m_data, buffers.m_size}) {
+        sources.push_back({{}, buffer});
+    }
+    return new_search_engine(
+            std::move(sources),
+            *static_cast<CompiledQuery const*>(compiled_query),
+            time_interval,
+            num_threads,
+            result_capacity
+    );
+}
+
+CLP_FFI_GO_METHOD auto search_engine_search_files(
+        StringView paths,
+        SizetSpan path_end_offsets,
+        void* compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+) -> void* {
+    if (nullptr == compiled_query) {
+        return nullptr;
+    }
+    std::string_view const paths_view{paths.m_data, paths.m_size};
+    std::vector<SearchEngine::Source> sources;
+    sources.reserve(path_end_offsets.m_size);
+    size_t pos{0};
+    for (auto const end_offset :
+         std::span<size_t const>{path_end_offsets.m_data, path_end_offsets.m_size})
+    {
+        if (end_offset < pos || paths_view.size() < end_offset) {
+            return nullptr;
+        }
+        sources.push_back({std::string{paths_view.substr(pos, end_offset - pos)}, {nullptr, 0}});
+        pos = end_offset;
+    }
+    return new_search_engine(
+            std::move(sources),
+            *static_cast<CompiledQuery const*>(compiled_query),
+            time_interval,
+            num_threads,
+            result_capacity
+    );
+}
+
+CLP_FFI_GO_METHOD auto
+search_engine_next_results(void* search_engine, SearchResultSpan results, size_t* num_results)
+        -> int {
+    if (nullptr == search_engine || nullptr == num_results) {
+        return 0;
+    }
+    auto const next{static_cast<SearchEngine*>(search_engine)->next_results(results.m_size)};
+    std::span<SearchResult> const results_span{results.m_data, results.m_size};
+    for (size_t i{0}; i < next.size(); ++i) {
+        auto const& result{next[i]};
+        results_span[i] = {
+                {{result.m_log_message.data(), result.m_log_message.size()}, result.m_timestamp},
+                result.m_source_idx,
+                result.m_matching_query
+        };
+    }
+    *num_results = next.size();
+    return next.empty() ? 0 : 1;
+}
+
+CLP_FFI_GO_METHOD auto search_engine_get_source_error(void* search_engine, size_t source) -> int {
+    return static_cast<SearchEngine const*>(search_engine)->get_source_error(source);
+}
+
+CLP_FFI_GO_METHOD auto search_engine_delete(void* search_engine) -> void {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    delete static_cast<SearchEngine*>(search_engine);
+}
+}  // namespace ffi_go::search
@@ -0,0 +1,185 @@
+#ifndef FFI_GO_SEARCH_SEARCH_ENGINE_HPP
+#define FFI_GO_SEARCH_SEARCH_ENGINE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ffi_go/defs.h"
+#include "ffi_go/search/compiled_query.hpp"
+#include "ffi_go/search/wildcard_query.h"
+
+namespace ffi_go::search {
+/**
+ * Searches many uncompressed CLP IR streams (sources) for log events matching a
+ * CompiledQuery within a time interval, using a fixed pool of worker threads.
+ * Each source is searched from start to end by a single worker, so the results
+ * of a source are in stream order (results of different sources interleave).
+ * Sources are dealt out evenly between the workers' queues up front, and a
+ * worker that empties its own queue steals from the back of another worker's
+ * queue, balancing sources of uneven size.
+ * Results are passed to a single consumer through a bounded ring buffer. While
+ * the ring buffer is full workers block, bounding memory use regardless of how
+ * many log events match.
+ */
+class SearchEngine {
+public:
+    // Types
+    /**
+     * An IR stream to search: either the file at m_path, or the stream held in
+     * m_buffer if m_path is empty.
+     */
+    struct Source {
+        std::string m_path;
+        ByteSpan m_buffer;
+    };
+
+    /**
+     * A log event matching the query.
+     */
+    struct Result {
+        size_t m_source_idx;
+        size_t m_matching_query;
+        epoch_time_ms_t m_timestamp;
+        std::string m_log_message;
+    };
+
+    // Constants
+    /**
+     * Error of a source whose file could not be read.
+     */
+    static constexpr int cReadError{-1};
+
+    // Constructors
+    /**
+     * Start searching sources. The buffers of sources and compiled_query must
+     * remain valid until the SearchEngine is destroyed.
+     * @param sources IR streams to search
+     * @param compiled_query Queries to search for; if empty every log event
+     *     within time_interval is a match
+     * @param time_interval Timestamp interval: [lower, upper)
+     * @param num_threads Number of worker threads (at most one per source)
+     * @param result_capacity Capacity of the ring buffer of results
+     * @throw std::system_error if a worker thread can't be started, once the
+     *     workers already started have exited
+     */
+    SearchEngine(
+            std::vector<Source> sources,
+            CompiledQuery const& compiled_query,
+            TimestampInterval time_interval,
+            size_t num_threads,
+            size_t result_capacity
+    );
+
+    // Delete copy/move constructors and assignment
+    SearchEngine(SearchEngine const&) = delete;
+    SearchEngine(SearchEngine&&) = delete;
+    auto operator=(SearchEngine const&) -> SearchEngine& = delete;
+    auto operator=(SearchEngine&&) -> SearchEngine& = delete;
+
+    // Destructor
+    /**
+     * Cancel the search and wait for every worker to exit.
+     */
+    ~SearchEngine();
+
+    // Methods
+    [[nodiscard]] auto get_num_sources() const -> size_t { return m_sources.size(); }
+
+    /**
+     * Wait for results, removing up to max_results of them from the ring
+     * buffer. The returned results remain valid until the next call.
+     * @param max_results
+     * @return The removed results, which are only empty once every source has
+     *     been searched and all results have been removed
+     */
+    [[nodiscard]] auto next_results(size_t max_results) -> std::span<Result const>;
+
+    /**
+     * @param source_idx
+     * @return ffi::ir_stream::IRErrorCode_Success if the source was searched
+     *     without error (or is still being searched)
+     * @return cReadError if the source's file could not be read
+     * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the source's metadata
+     *     isn't a JSON object, or its reference timestamp isn't a string of an
+     *     integer
+     * @return ffi::ir_stream::IRErrorCode forwarded from searching the source
+     */
+    [[nodiscard]] auto get_source_error(size_t source_idx) const -> int;
+
+private:
+    /**
+     * The indices of the sources a worker has yet to search.
+     */
+    struct WorkQueue {
+        std::mutex m_mutex;
+        std::deque<size_t> m_source_indices;
+    };
+
+    /**
+     * Cancel the search and wait for every started worker to exit.
+     */
+    auto stop_workers() -> void;
+
+    /**
+     * Search sources until none remain, then exit.
+     * @param worker_idx
+     */
+    auto run_worker(size_t worker_idx) -> void;
+
+    /**
+     * @param worker_idx
+     * @return The index of the next source for the worker to search, taken from
+     *     the front of its own queue or else stolen from the back of another
+     *     worker's queue
+     * @return std::nullopt if no sources remain
+     */
+    [[nodiscard]] auto get_next_source(size_t worker_idx) -> std::optional<size_t>;
+
+    /**
+     * Search a source, pushing every result into the ring buffer.
+     * @param source_idx
+     * @param file_buf Storage for the contents of the source's file
+     * @param result Storage for a result (swapped into the ring buffer)
+     * @return The error of the source (see get_source_error)
+     */
+    [[nodiscard]] auto
+    search_source(size_t source_idx, std::vector<char>& file_buf, Result& result) -> int;
+
+    /**
+     * Wait for space in the ring buffer and swap result into it.
+     * @param result
+     * @return Whether result was pushed (false if the search was cancelled)
+     */
+    [[nodiscard]] auto push_result(Result& result) -> bool;
+
+    std::vector<Source> m_sources;
+    CompiledQuery const& m_compiled_query;
+    TimestampInterval m_time_interval;
+    // Written by the workers while get_source_error may read them.
+    std::vector<std::atomic<int>> m_source_errors;
+    std::vector<WorkQueue> m_work_queues;
+    std::atomic<bool> m_cancelled{false};
+
+    // Ring buffer of results, with m_results_head the index of the oldest.
+    std::mutex m_results_mutex;
+    std::condition_variable m_results_not_empty;
+    std::condition_variable m_results_not_full;
+    std::vector<Result> m_results;
+    size_t m_results_head{0};
+    size_t m_num_results{0};
+    size_t m_num_running_workers{0};
+    std::vector<Result> m_removed_results;
+
+    std::vector<std::thread> m_workers;
+};
+}  // namespace ffi_go::search
+
+#endif  // FFI_GO_SEARCH_SEARCH_ENGINE_HPP
@@ -0,0 +1,415 @@
+#include "wildcard_match.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <clp/string_utils/string_utils.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define FFI_GO_SEARCH_WILDCARD_MATCH_X86
+    #include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #define FFI_GO_SEARCH_WILDCARD_MATCH_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace ffi_go::search {
+namespace {
+constexpr size_t cNpos{std::string_view::npos};
+
+// ASCII upper and lower case letters only differ by this bit.
+constexpr char cCaseBit{0x20};
+
+/**
+ * A segment of a query between '*'s, along with the first and last of its
+ * characters that aren't '?', used to find candidate positions of the segment.
+ * When matching case insensitively, a letter's m_*_case_bit is cCaseBit and
+ * its m_*_char is lower case, so that the letter matches a character c if
+ * (c | m_*_case_bit) == m_*_char; otherwise m_*_case_bit is 0.
+ */
+struct Segment {
+    std::string_view m_chars;
+    size_t m_first_pos;
+    size_t m_last_pos;
+    char m_first_char;
+    char m_first_case_bit;
+    char m_last_char;
+    char m_last_case_bit;
+};
+
+/**
+ * @param c
+ * @return c converted to lower case if it is an ASCII upper case letter
+ */
+[[nodiscard]] constexpr auto to_lower(char c) -> char {
+    return ('A' <= c && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @param c
+ * @return Whether c is an ASCII letter
+ */
+[[nodiscard]] constexpr auto is_letter(char c) -> bool {
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+/**
+ * @param target Beginning of a string at least as long as segment
+ * @param segment Characters and '?'s (matching any character)
+ * @param case_sensitive
+ * @return Whether segment matches target
+ */
+[[nodiscard]] auto
+matches_segment(char const* target, std::string_view segment, bool case_sensitive) -> bool {
+    for (size_t i{0}; i < segment.size(); ++i) {
+        char const query_char{segment[i]};
+        if ('?' == query_char) {
+            continue;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        char const target_char{target[i]};
+        if (case_sensitive ? target_char != query_char
+                           : to_lower(target_char) != to_lower(query_char))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Find the first position of segment in target, starting at begin_pos, one
+ * position at a time. Vectorized kernels use this to finish the positions too
+ * close to the end of target to load a full vector.
+ * @return The position of the segment in target
+ * @return cNpos if segment doesn't occur in target
+ */
+[[nodiscard]] auto find_segment_scalar(
+        std::string_view target,
+        Segment const& segment,
+        bool case_sensitive,
+        size_t begin_pos
+) -> size_t {
+    if (target.size() < segment.m_chars.size()) {
+        return cNpos;
+    }
+    size_t const last_pos{target.size() - segment.m_chars.size()};
+    for (size_t pos{begin_pos}; pos <= last_pos; ++pos) {
+        char const c{target[pos + segment.m_first_pos]};
+        if (segment.m_first_char == static_cast<char>(c | segment.m_first_case_bit)
+            && matches_segment(target.data() + pos, segment.m_chars, case_sensitive))
+        {
+            return pos;
+        }
+    }
+    return cNpos;
+}
+
+/**
+ * Verify each candidate position of segment in target, in order. Candidates
+ * past the last position segment fits at are ignored.
+ * @param target
+ * @param segment
+ * @param case_sensitive
+ * @param block_pos Position in target of the first bit of mask
+ * @param mask Bitset of candidate positions (cBitsPerPos bits per position)
+ * @return The position of the first candidate matching segment
+ * @return cNpos if no candidate matches
+ */
+template <size_t cBitsPerPos, typename mask_t>
+[[nodiscard]] auto verify_candidates(
+        std::string_view target,
+        Segment const& segment,
+        bool case_sensitive,
+        size_t block_pos,
+        mask_t mask
+) -> size_t {
+    size_t const last_pos{target.size() - segment.m_chars.size()};
+    while (0 != mask) {
+        auto const bit{static_cast<size_t>(std::countr_zero(mask))};
+        size_t const pos{block_pos + bit / cBitsPerPos};
+        if (pos > last_pos) {
+            break;
+        }
+        if (matches_segment(target.data() + pos, segment.m_chars, case_sensitive)) {
+            return pos;
+        }
+        mask &= ~(((mask_t{1} << cBitsPerPos) - 1) << (bit - bit % cBitsPerPos));
+    }
+    return cNpos;
+}
+
+#if defined(FFI_GO_SEARCH_WILDCARD_MATCH_X86)
+/**
+ * find_segment_scalar comparing the first and last characters of segment
+ * against 16 positions of target at a time.
+ */
+[[nodiscard]] auto
+find_segment_sse2(std::string_view target, Segment const& segment, bool case_sensitive)
+        -> size_t {
+    constexpr size_t cWidth{16};
+    if (target.size() < segment.m_chars.size()) {
+        return cNpos;
+    }
+    __m128i const first_char{_mm_set1_epi8(segment.m_first_char)};
+    __m128i const first_case_bit{_mm_set1_epi8(segment.m_first_case_bit)};
+    __m128i const last_char{_mm_set1_epi8(segment.m_last_char)};
+    __m128i const last_case_bit{_mm_set1_epi8(segment.m_last_case_bit)};
+    char const* data{target.data()};
+    size_t pos{0};
+    for (; pos + segment.m_last_pos + cWidth <= target.size(); pos += cWidth) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        __m128i const first{
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos + segment.m_first_pos))
+        };
+        __m128i const last{
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos + segment.m_last_pos))
+        };
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        __m128i const first_eq{_mm_cmpeq_epi8(_mm_or_si128(first, first_case_bit), first_char)};
+        __m128i const last_eq{_mm_cmpeq_epi8(_mm_or_si128(last, last_case_bit), last_char)};
+        auto const mask{static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(first_eq, last_eq))
+        )};
+        if (auto const segment_pos{
+                    verify_candidates<1>(target, segment, case_sensitive, pos, mask)
+            };
+            cNpos != segment_pos)
+        {
+            return segment_pos;
+        }
+    }
+    return find_segment_scalar(target, segment, case_sensitive, pos);
+}
+
+/**
+ * find_segment_sse2 comparing 32 positions of target at a time.
+ */
+[[nodiscard]] __attribute__((target("avx2"))) auto
+find_segment_avx2(std::string_view target, Segment const& segment, bool case_sensitive)
+        -> size_t {
+    constexpr size_t cWidth{32};
+    if (target.size() < segment.m_chars.size()) {
+        return cNpos;
+    }
+    __m256i const first_char{_mm256_set1_epi8(segment.m_first_char)};
+    __m256i const first_case_bit{_mm256_set1_epi8(segment.m_first_case_bit)};
+    __m256i const last_char{_mm256_set1_epi8(segment.m_last_char)};
+    __m256i const last_case_bit{_mm256_set1_epi8(segment.m_last_case_bit)};
+    char const* data{target.data()};
+    size_t pos{0};
+    for (; pos + segment.m_last_pos + cWidth <= target.size(); pos += cWidth) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        __m256i const first{_mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(data + pos + segment.m_first_pos)
+        )};
+        __m256i const last{_mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(data + pos + segment.m_last_pos)
+        )};
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        __m256i const first_eq{
+                _mm256_cmpeq_epi8(_mm256_or_si256(first, first_case_bit), first_char)
+        };
+        __m256i const last_eq{_mm256_cmpeq_epi8(_mm256_or_si256(last, last_case_bit), last_char)};
+        auto const mask{
+                static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first_eq, last_eq)))
+        };
+        if (auto const segment_pos{
+                    verify_candidates<1>(target, segment, case_sensitive, pos, mask)
+            };
+            cNpos != segment_pos)
+        {
+            return segment_pos;
+        }
+    }
+    return find_segment_scalar(target, segment, case_sensitive, pos);
+}
+#endif
+
+#if defined(FFI_GO_SEARCH_WILDCARD_MATCH_NEON)
+/**
+ * find_segment_scalar comparing the first and last characters of segment
+ * against 16 positions of target at a time.
+ */
+[[nodiscard]] auto
+find_segment_neon(std::string_view target, Segment const& segment, bool case_sensitive)
+        -> size_t {
+    constexpr size_t cWidth{16};
+    // NEON has no movemask, so each position is narrowed to 4 bits of a 64-bit
+    // mask instead.
+    constexpr size_t cBitsPerPos{4};
+    if (target.size() < segment.m_chars.size()) {
+        return cNpos;
+    }
+    uint8x16_t const first_char{vdupq_n_u8(static_cast<uint8_t>(segment.m_first_char))};
+    uint8x16_t const first_case_bit{vdupq_n_u8(static_cast<uint8_t>(segment.m_first_case_bit))};
+    uint8x16_t const last_char{vdupq_n_u8(static_cast<uint8_t>(segment.m_last_char))};
+    uint8x16_t const last_case_bit{vdupq_n_u8(static_cast<uint8_t>(segment.m_last_case_bit))};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto const* data{reinterpret_cast<uint8_t const*>(target.data())};
+    size_t pos{0};
+    for (; pos + segment.m_last_pos + cWidth <= target.size(); pos += cWidth) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint8x16_t const first{vld1q_u8(data + pos + segment.m_first_pos)};
+        uint8x16_t const last{vld1q_u8(data + pos + segment.m_last_pos)};
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint8x16_t const first_eq{vceqq_u8(vorrq_u8(first, first_case_bit), first_char)};
+        uint8x16_t const last_eq{vceqq_u8(vorrq_u8(last, last_case_bit), last_char)};
+        uint64_t const mask{vget_lane_u64(
+                vreinterpret_u64_u8(
+                        vshrn_n_u16(vreinterpretq_u16_u8(vandq_u8(first_eq, last_eq)), 4)
+                ),
+                0
+        )};
+        if (auto const segment_pos{
+                    verify_candidates<cBitsPerPos>(target, segment, case_sensitive, pos, mask)
+            };
+            cNpos != segment_pos)
+        {
+            return segment_pos;
+        }
+    }
+    return find_segment_scalar(target, segment, case_sensitive, pos);
+}
+#endif
+
+/**
+ * @return The best kernel supported by the CPU
+ */
+[[nodiscard]] auto select_kernel() -> WildcardMatchKernel {
+#if defined(FFI_GO_SEARCH_WILDCARD_MATCH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return WildcardMatchKernel::Avx2;
+    }
+    return WildcardMatchKernel::Sse2;
+#elif defined(FFI_GO_SEARCH_WILDCARD_MATCH_NEON)
+    return WildcardMatchKernel::Neon;
+#else
+    return WildcardMatchKernel::Scalar;
+#endif
+}
+
+/**
+ * @return The kernel used by wildcard_match, selected on first use
+ */
+[[nodiscard]] auto get_kernel() -> WildcardMatchKernel {
+    static WildcardMatchKernel const cKernel{select_kernel()};
+    return cKernel;
+}
+
+/**
+ * Find the first position of a segment (without '*') of a query in target.
+ * @return The position of the segment in target
+ * @return cNpos if segment doesn't occur in target
+ */
+[[nodiscard]] auto find_segment(
+        std::string_view target,
+        std::string_view chars,
+        bool case_sensitive,
+        WildcardMatchKernel kernel
+) -> size_t {
+    size_t const first_pos{chars.find_first_not_of('?')};
+    if (cNpos == first_pos) {
+        return target.size() < chars.size() ? cNpos : 0;
+    }
+    size_t const last_pos{chars.find_last_not_of('?')};
+    char const first{chars[first_pos]};
+    char const last{chars[last_pos]};
+    bool const fold_first{false == case_sensitive && is_letter(first)};
+    bool const fold_last{false == case_sensitive && is_letter(last)};
+    Segment const segment{
+            chars,
+            first_pos,
+            last_pos,
+            fold_first ? to_lower(first) : first,
+            fold_first ? cCaseBit : char{0},
+            fold_last ? to_lower(last) : last,
+            fold_last ? cCaseBit : char{0}
+    };
+    switch (kernel) {
+#if defined(FFI_GO_SEARCH_WILDCARD_MATCH_X86)
+        case WildcardMatchKernel::Sse2:
+            return find_segment_sse2(target, segment, case_sensitive);
+        case WildcardMatchKernel::Avx2:
+            return find_segment_avx2(target, segment, case_sensitive);
+#endif
+#if defined(FFI_GO_SEARCH_WILDCARD_MATCH_NEON)
+        case WildcardMatchKernel::Neon:
+            return find_segment_neon(target, segment, case_sensitive);
+#endif
+        default:
+            return find_segment_scalar(target, segment, case_sensitive, 0);
+    }
+}
+}  // namespace
+
+auto get_supported_wildcard_match_kernels() -> std::vector<WildcardMatchKernel> {
+    std::vector<WildcardMatchKernel> kernels{WildcardMatchKernel::Scalar};
+#if defined(FFI_GO_SEARCH_WILDCARD_MATCH_X86)
+    kernels.push_back(WildcardMatchKernel::Sse2);
+#endif
+    if (WildcardMatchKernel::Scalar != get_kernel() && kernels.back() != get_kernel()) {
+        kernels.push_back(get_kernel());
+    }
+    return kernels;
+}
+
+auto wildcard_match(std::string_view target, std::string_view query, bool case_sensitive)
+        -> bool {
+    return wildcard_match(target, query, case_sensitive, get_kernel());
+}
+
+auto wildcard_match(
+        std::string_view target,
+        std::string_view query,
+        bool case_sensitive,
+        WildcardMatchKernel kernel
+) -> bool {
+    if (cNpos != query.find('\\')) {
+        return clp::string_utils::wildcard_match_unsafe(target, query, case_sensitive);
+    }
+
+    // The segment before the first '*' must match the beginning of target
+    size_t star_pos{query.find('*')};
+    if (cNpos == star_pos) {
+        return target.size() == query.size()
+               && matches_segment(target.data(), query, case_sensitive);
+    }
+    if (target.size() < star_pos
+        || false == matches_segment(target.data(), query.substr(0, star_pos), case_sensitive))
+    {
+        return false;
+    }
+    target.remove_prefix(star_pos);
+    query.remove_prefix(star_pos + 1);
+
+    // Each segment between '*'s is matched at its first occurrence after the
+    // previous segment, which leaves the most of target for the rest of query.
+    while (true) {
+        star_pos = query.find('*');
+        if (cNpos == star_pos) {
+            // The segment after the last '*' must match the end of target
+            return target.size() >= query.size()
+                   && matches_segment(
+                           target.data() + (target.size() - query.size()),
+                           query,
+                           case_sensitive
+                   );
+        }
+        auto const segment{query.substr(0, star_pos)};
+        query.remove_prefix(star_pos + 1);
+        size_t const segment_pos{find_segment(target, segment, case_sensitive, kernel)};
+        if (cNpos == segment_pos) {
+            return false;
+        }
+        target.remove_prefix(segment_pos + segment.size());
+    }
+}
+}  // namespace ffi_go::search
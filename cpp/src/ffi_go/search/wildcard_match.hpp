@@ -0,0 +1,63 @@
+#ifndef FFI_GO_SEARCH_WILDCARD_MATCH_HPP
+#define FFI_GO_SEARCH_WILDCARD_MATCH_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ffi_go::search {
+/**
+ * Implementations of the literal search done by wildcard_match. Sse2 and Avx2
+ * are only available on x86-64 (Avx2 depending on the CPU), and Neon on
+ * AArch64.
+ */
+enum class WildcardMatchKernel : uint8_t {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon,
+};
+
+/**
+ * @return Every kernel supported by the CPU, ending with the kernel used by
+ *     wildcard_match
+ */
+[[nodiscard]] auto get_supported_wildcard_match_kernels() -> std::vector<WildcardMatchKernel>;
+
+/**
+ * Match target against a wildcard query with the same semantics (and results)
+ * as clp::string_utils::wildcard_match_unsafe: '*' matches zero or more
+ * characters, '?' matches any one character, and case insensitive matching
+ * folds ASCII letters. The query must be cleaned as for wildcard_match_unsafe.
+ *
+ * The query is split at each '*' into segments of literal characters and '?'.
+ * The first and last segments are anchored to the ends of target, and every
+ * other segment is found greedily (leftmost first) after the previous one. To
+ * find a segment, the kernel picked for the CPU compares two characters of the
+ * segment against 16 (SSE2, NEON) or 32 (AVX2) positions of target at once,
+ * folding the case of target's letters in the same vectors when matching case
+ * insensitively, and only verifies the segment at the positions where both
+ * characters match. Unlike wildcard_match_unsafe, case insensitive matching
+ * doesn't copy target or query. Queries with escaped characters (rare in
+ * practice) are forwarded to wildcard_match_unsafe.
+ * @param target
+ * @param query
+ * @param case_sensitive
+ * @return Whether query matches target
+ */
+[[nodiscard]] auto
+wildcard_match(std::string_view target, std::string_view query, bool case_sensitive) -> bool;
+
+/**
+ * wildcard_match using the given kernel, which must be supported by the CPU
+ * (see get_supported_wildcard_match_kernels).
+ */
+[[nodiscard]] auto wildcard_match(
+        std::string_view target,
+        std::string_view query,
+        bool case_sensitive,
+        WildcardMatchKernel kernel
+) -> bool;
+}  // namespace ffi_go::search
+
+#endif  // FFI_GO_SEARCH_WILDCARD_MATCH_HPP
@@ -1,5 +1,6 @@
 #include "wildcard_query.h"
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -7,6 +8,8 @@
 
 #include "ffi_go/api_decoration.h"
 #include "ffi_go/defs.h"
+#include "ffi_go/search/compiled_query.hpp"
+#include "ffi_go/search/wildcard_match.hpp"
 
 namespace ffi_go::search {
 CLP_FFI_GO_METHOD auto wildcard_query_new(StringView query, void** ptr) -> StringView {
@@ -23,10 +26,38 @@ CLP_FFI_GO_METHOD auto wildcard_query_delete(void* str) -> void {
 }
 
 CLP_FFI_GO_METHOD auto wildcard_query_match(StringView target, WildcardQueryView query) -> int {
-    return static_cast<int>(clp::string_utils::wildcard_match_unsafe(
+    return static_cast<int>(wildcard_match(
             {target.m_data, target.m_size},
             {query.m_query.m_data, query.m_query.m_size},
             query.m_case_sensitive
     ));
 }
+
+CLP_FFI_GO_METHOD auto wildcard_query_compile(MergedWildcardQueryView merged_query) -> void* {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    return new CompiledQuery{merged_query};
+}
+
+CLP_FFI_GO_METHOD auto wildcard_query_compiled_delete(void* compiled_query) -> void {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    delete static_cast<CompiledQuery*>(compiled_query);
+}
+
+CLP_FFI_GO_METHOD auto
+wildcard_query_compiled_match(StringView target, void* compiled_query, size_t* matching_query)
+        -> int {
+    if (nullptr == compiled_query || nullptr == matching_query) {
+        return 0;
+    }
+    CompiledQuery::Candidates candidates;
+    auto const match{static_cast<CompiledQuery const*>(compiled_query)->find_first_match(
+            {target.m_data, target.m_size},
+            candidates
+    )};
+    if (false == match.has_value()) {
+        return 0;
+    }
+    *matching_query = match.value();
+    return 1;
+}
 }  // namespace ffi_go::search
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace ffi_go {
 /**
@@ -22,6 +23,28 @@ struct LogEventStorage {
 
     LogMessage m_log_message;
 };
+
+/**
+ * The backing storage for a batch of Go ffi.LogEventViews.
+ * All log messages in the batch are packed back to back into a single buffer
+ * (arena), with m_end_offsets marking the end of each message. Mutating a field
+ * will invalidate every View (slice) stored in the batch of ffi.LogEventViews
+ * (without any warning or way to guard in Go).
+ */
+struct LogEventBatchStorage {
+    auto clear() -> void {
+        m_log_messages.clear();
+        m_end_offsets.clear();
+    }
+
+    auto add_log_message(LogMessage const& log_message) -> void {
+        m_log_messages.append(log_message);
+        m_end_offsets.push_back(m_log_messages.size());
+    }
+
+    LogMessage m_log_messages;
+    std::vector<size_t> m_end_offsets;
+};
 }  // namespace ffi_go
 
 #endif  // FFI_GO_LOG_TYPES_HPP
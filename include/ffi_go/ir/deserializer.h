@@ -3,6 +3,7 @@
 // header must support C, making modernize checks inapplicable
 // NOLINTBEGIN(modernize-deprecated-headers)
 // NOLINTBEGIN(modernize-use-trailing-return-type)
+// NOLINTBEGIN(modernize-use-using)
 
 #include <stdint.h>
 #include <stdlib.h>
@@ -11,6 +12,45 @@
 #include "ffi_go/defs.h"
 #include "ffi_go/search/wildcard_query.h"
 
+/**
+ * A snapshot of the work done by an ir::Deserializer (see
+ * ir_deserializer_get_counters). m_events_deserialized counts every log event
+ * read from the IR (including those later rejected by a search), and
+ * m_messages_decoded the log messages reconstructed from them. While searching,
+ * m_events_skipped_by_time counts the log events outside the time interval,
+ * m_events_rejected_by_logtype those ruled out from their encoded form without
+ * decoding their log message, and m_matcher_invocations the log messages
+ * matched against the queries. m_buffer_growths counts the reallocations of
+ * the ir::Deserializer's storage.
+ */
+typedef struct {
+    uint64_t m_events_deserialized;
+    uint64_t m_messages_decoded;
+    uint64_t m_bytes_consumed;
+    uint64_t m_events_skipped_by_time;
+    uint64_t m_events_rejected_by_logtype;
+    uint64_t m_matcher_invocations;
+    uint64_t m_buffer_growths;
+} DeserializerCounters;
+
+/**
+ * The columns of a batch of log events deserialized by
+ * ir_deserializer_deserialize_*_log_event_columns, laid out as the buffers of
+ * an Apache Arrow record batch. Log event i has timestamp m_timestamps[i] and
+ * log message m_message_data[m_message_offsets[i], m_message_offsets[i + 1]),
+ * so m_message_offsets and m_message_data are the offsets and data buffers of
+ * an Arrow large_utf8 array (m_message_offsets holds one more offset than
+ * there are log events, beginning with 0). m_logtype_ids and
+ * m_matching_queries are optional and empty unless requested.
+ */
+typedef struct {
+    Int64tSpan m_timestamps;
+    Int64tSpan m_message_offsets;
+    ByteSpan m_message_data;
+    Int64tSpan m_logtype_ids;
+    Int64tSpan m_matching_queries;
+} LogEventColumns;
+
 /**
  * Clean up the underlying ir::Deserializer of a Go ir.Deserializer.
  * @param[in] ir_deserializer The address of a ir::Deserializer created and
@@ -88,6 +128,239 @@ CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_log_event(
         LogEventView* log_event
 );
 
+/**
+ * Given a CLP IR buffer with eight byte encoding, deserialize a batch of log
+ * events. Deserialization stops once log_events is full, at least max_bytes of
+ * ir_view have been consumed, or no further complete log event can be
+ * deserialized. The messages of the batch are packed into a single buffer
+ * inside ir_deserializer, so every view returned is invalidated by the next
+ * deserialization call. All pointer parameters must be non-null (non-nil Cgo
+ * C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for the
+ *     found log events
+ * @param[in] max_bytes Number of bytes of ir_view after which to stop
+ *     deserializing (0 for no limit)
+ * @param[out] ir_pos Position in ir_view read to (the end of the last log event
+ *     in the batch)
+ * @param[out] log_events Caller allocated array filled with the log events
+ *     stored in ir_deserializer
+ * @param[out] num_events Number of log events written to log_events
+ * @return ffi::ir_stream::IRErrorCode_Success if at least one log event was
+ *     deserialized
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::deserialize_log_event if no log
+ *     event could be deserialized
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_eight_byte_log_events_batch(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_bytes,
+        size_t* ir_pos,
+        LogEventViewSpan log_events,
+        size_t* num_events
+);
+
+/**
+ * Given a CLP IR buffer with four byte encoding, deserialize a batch of log
+ * events. Deserialization stops once log_events is full, at least max_bytes of
+ * ir_view have been consumed, or no further complete log event can be
+ * deserialized. The messages of the batch are packed into a single buffer
+ * inside ir_deserializer, so every view returned is invalidated by the next
+ * deserialization call. All pointer parameters must be non-null (non-nil Cgo
+ * C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for the
+ *     found log events
+ * @param[in] max_bytes Number of bytes of ir_view after which to stop
+ *     deserializing (0 for no limit)
+ * @param[out] ir_pos Position in ir_view read to (the end of the last log event
+ *     in the batch)
+ * @param[out] log_events Caller allocated array filled with the log events
+ *     stored in ir_deserializer
+ * @param[out] num_events Number of log events written to log_events
+ * @return ffi::ir_stream::IRErrorCode_Success if at least one log event was
+ *     deserialized
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::deserialize_log_event if no log event
+ *     could be deserialized
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_log_events_batch(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_bytes,
+        size_t* ir_pos,
+        LogEventViewSpan log_events,
+        size_t* num_events
+);
+
+/**
+ * Given a CLP IR buffer with eight byte encoding, deserialize every complete
+ * log event in it, splitting the buffer into chunks at chunk_offsets and
+ * deserializing the chunks in parallel (on at most as many threads as the
+ * hardware supports, including the calling thread). Each offset must
+ * be the start of a log event (e.g. an ir.Checkpoint of the stream), and
+ * chunk_timestamps must hold the timestamp preceding the log event at each
+ * offset (unused as eight byte timestamps are absolute). Deserialization
+ * stops at the first chunk that fails, returning the log events of the
+ * preceding chunks. The messages are stored inside ir_deserializer, so every
+ * view returned is invalidated by the next deserialization call. All pointer
+ * parameters must be non-null (non-nil Cgo C.<type> pointer or unsafe.Pointer
+ * from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for the
+ *     found log events
+ * @param[in] chunk_offsets Strictly increasing offsets into ir_view at which
+ *     to split it
+ * @param[in] chunk_timestamps Timestamp preceding the log event at each offset
+ *     in chunk_offsets
+ * @param[out] ir_pos Position in ir_view read to (the end of the last log event
+ *     returned)
+ * @param[out] log_events The log events stored in ir_deserializer
+ * @return ffi::ir_stream::IRErrorCode_Success if at least one log event was
+ *     deserialized
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if chunk_offsets is invalid
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR if ir_view is empty
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::deserialize_log_event if no log
+ *     event could be deserialized
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_eight_byte_log_events_parallel(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        SizetSpan chunk_offsets,
+        Int64tSpan chunk_timestamps,
+        size_t* ir_pos,
+        LogEventViewSpan* log_events
+);
+
+/**
+ * Given a CLP IR buffer with four byte encoding, deserialize every complete
+ * log event in it, splitting the buffer into chunks at chunk_offsets and
+ * deserializing the chunks in parallel (on at most as many threads as the
+ * hardware supports, including the calling thread). Each offset must
+ * be the start of a log event (e.g. an ir.Checkpoint of the stream), and
+ * chunk_timestamps must hold the timestamp preceding the log event at each
+ * offset. Deserialization stops at the first chunk that
+ * fails, returning the log events of the preceding chunks. The messages are
+ * stored inside ir_deserializer, so every view returned is invalidated by the
+ * next deserialization call. All pointer parameters must be non-null (non-nil
+ * Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for the
+ *     found log events
+ * @param[in] chunk_offsets Strictly increasing offsets into ir_view at which
+ *     to split it
+ * @param[in] chunk_timestamps Timestamp preceding the log event at each offset
+ *     in chunk_offsets
+ * @param[out] ir_pos Position in ir_view read to (the end of the last log event
+ *     returned)
+ * @param[out] log_events The log events stored in ir_deserializer
+ * @return ffi::ir_stream::IRErrorCode_Success if at least one log event was
+ *     deserialized
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if chunk_offsets is invalid
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR if ir_view is empty
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::deserialize_log_event if no log
+ *     event could be deserialized
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_log_events_parallel(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        SizetSpan chunk_offsets,
+        Int64tSpan chunk_timestamps,
+        size_t* ir_pos,
+        LogEventViewSpan* log_events
+);
+
+/**
+ * Given a CLP IR buffer with eight byte encoding, deserialize a batch of log
+ * events into columns (see LogEventColumns). Deserialization stops once the
+ * columns hold max_events log events, at least max_bytes of ir_view have been
+ * consumed, or no further complete log event can be deserialized. If
+ * compiled_query is non-null only the log events matching one of its queries
+ * are added to the columns, so log events may be consumed without any being
+ * added. The columns are stored inside ir_deserializer and reuse its memory,
+ * so every view returned is invalidated by the next deserialization call. All
+ * pointer parameters other than compiled_query must be non-null (non-nil Cgo
+ * C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for the
+ *     columns
+ * @param[in] max_events Maximum number of log events to add to the columns
+ * @param[in] max_bytes Number of bytes of ir_view after which to stop
+ *     deserializing (0 for no limit)
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile to filter the log events with and fill in
+ *     m_matching_queries (the index of the first query each log event
+ *     matches), or null to add every log event
+ * @param[in] logtype_ids Whether to fill in m_logtype_ids, where log events
+ *     share an id if and only if they share a logtype (ids are assigned from 0
+ *     in the order ir_deserializer first sees each logtype)
+ * @param[out] ir_pos Position in ir_view read to (the end of the last log event
+ *     consumed)
+ * @param[out] columns The columns stored in ir_deserializer
+ * @return ffi::ir_stream::IRErrorCode_Success if at least one log event was
+ *     consumed (or max_events is 0)
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::deserialize_log_event if no log
+ *     event could be consumed
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_eight_byte_log_event_columns(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_events,
+        size_t max_bytes,
+        void* compiled_query,
+        bool logtype_ids,
+        size_t* ir_pos,
+        LogEventColumns* columns
+);
+
+/**
+ * Given a CLP IR buffer with four byte encoding, deserialize a batch of log
+ * events into columns (see LogEventColumns). Deserialization stops once the
+ * columns hold max_events log events, at least max_bytes of ir_view have been
+ * consumed, or no further complete log event can be deserialized. If
+ * compiled_query is non-null only the log events matching one of its queries
+ * are added to the columns, so log events may be consumed without any being
+ * added. The columns are stored inside ir_deserializer and reuse its memory,
+ * so every view returned is invalidated by the next deserialization call. All
+ * pointer parameters other than compiled_query must be non-null (non-nil Cgo
+ * C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for the
+ *     columns
+ * @param[in] max_events Maximum number of log events to add to the columns
+ * @param[in] max_bytes Number of bytes of ir_view after which to stop
+ *     deserializing (0 for no limit)
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile to filter the log events with and fill in
+ *     m_matching_queries (the index of the first query each log event
+ *     matches), or null to add every log event
+ * @param[in] logtype_ids Whether to fill in m_logtype_ids, where log events
+ *     share an id if and only if they share a logtype (ids are assigned from 0
+ *     in the order ir_deserializer first sees each logtype)
+ * @param[out] ir_pos Position in ir_view read to (the end of the last log event
+ *     consumed)
+ * @param[out] columns The columns stored in ir_deserializer
+ * @return ffi::ir_stream::IRErrorCode_Success if at least one log event was
+ *     consumed (or max_events is 0)
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::deserialize_log_event if no log
+ *     event could be consumed
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_log_event_columns(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        size_t max_events,
+        size_t max_bytes,
+        void* compiled_query,
+        bool logtype_ids,
+        size_t* ir_pos,
+        LogEventColumns* columns
+);
+
 /**
  * Given a CLP IR buffer with eight byte encoding, deserialize the next log
  * event until finding an event that is both within the time interval and
@@ -101,7 +374,10 @@ CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_log_event(
  * @param[in] time_interval Timestamp interval: [lower, upper)
  * @param[in] merged_query A concatenation of all queries to filter for; if
  *     empty any log event as a match
- * @param[out] ir_pos Position in ir_view read to
+ * @param[out] ir_pos Position in ir_view read to, or on
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR (or + 1) the end of the log
+ *     events consumed before the incomplete log event (or the first log event
+ *     at or after time_interval.m_upper, which is left unconsumed)
  * @param[out] log_event Log event stored in ir_deserializer
  * @param[out] matching_query Index into queries of the first matching query or
  *     0 if queries is empty
@@ -134,7 +410,10 @@ CLP_FFI_GO_METHOD int ir_deserializer_deserialize_eight_byte_wildcard_match(
  * @param[in] time_interval Timestamp interval: [lower, upper)
  * @param[in] merged_query A concatenation of all queries to filter for; if
  *     empty any log event as a match
- * @param[out] ir_pos Position in ir_view read to
+ * @param[out] ir_pos Position in ir_view read to, or on
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR (or + 1) the end of the log
+ *     events consumed before the incomplete log event (or the first log event
+ *     at or after time_interval.m_upper, which is left unconsumed)
  * @param[out] log_event Log event stored in ir_deserializer
  * @param[out] matching_query Index into queries of the matching query
  * @return ffi::ir_stream::IRErrorCode forwarded from
@@ -153,6 +432,255 @@ CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_wildcard_match(
         size_t* matching_query
 );
 
+/**
+ * Given a CLP IR buffer with eight byte encoding, deserialize the next log
+ * event until finding an event that is both within the time interval and
+ * matches any query of a compiled query. If the compiled query is empty, the
+ * first log event within the time interval is treated as a match. Unlike
+ * ir_deserializer_deserialize_*_wildcard_match the queries are not processed
+ * on each call. All pointer parameters must be non-null (non-nil Cgo C.<type>
+ * pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for a found
+ *     log event
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile
+ * @param[out] ir_pos Position in ir_view read to, or on
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR (or + 1) the end of the log
+ *     events consumed before the incomplete log event (or the first log event
+ *     at or after time_interval.m_upper, which is left unconsumed)
+ * @param[out] log_event Log event stored in ir_deserializer
+ * @param[out] matching_query Index into the compiled queries of the first
+ *     matching query or 0 if the compiled query is empty
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::decode_next_message
+ * @return ffi::ir_stream::IRErrorCode_Unsupported_Version + 1 if no query is
+ *     found before time_interval.m_upper (TODO this should be replaced/fix in
+ *     clp core)
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_eight_byte_compiled_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* compiled_query,
+        size_t* ir_pos,
+        LogEventView* log_event,
+        size_t* matching_query
+);
+
+/**
+ * Given a CLP IR buffer with four byte encoding, deserialize the next log event
+ * until finding an event that is both within the time interval and matches any
+ * query of a compiled query. If the compiled query is empty, the first log
+ * event within the time interval is treated as a match. Unlike
+ * ir_deserializer_deserialize_*_wildcard_match the queries are not processed
+ * on each call. All pointer parameters must be non-null (non-nil Cgo C.<type>
+ * pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for a found
+ *     log event
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile
+ * @param[out] ir_pos Position in ir_view read to, or on
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR (or + 1) the end of the log
+ *     events consumed before the incomplete log event (or the first log event
+ *     at or after time_interval.m_upper, which is left unconsumed)
+ * @param[out] log_event Log event stored in ir_deserializer
+ * @param[out] matching_query Index into the compiled queries of the first
+ *     matching query or 0 if the compiled query is empty
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::decode_next_message
+ * @return ffi::ir_stream::IRErrorCode_Unsupported_Version + 1 if no query is
+ *     found before time_interval.m_upper (TODO this should be replaced/fix in
+ *     clp core)
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_compiled_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* compiled_query,
+        size_t* ir_pos,
+        LogEventView* log_event,
+        size_t* matching_query
+);
+
+/**
+ * Given a CLP IR buffer with eight byte encoding, deserialize the next log event
+ * until finding an event that is both within the time interval and matches a
+ * numeric query. The query's predicates are evaluated directly on the encoded
+ * integer and float variables of each log event whose logtype the query
+ * matches (resolved once per logtype), so a log message is only decoded if the
+ * log event matches. All pointer parameters must be non-null (non-nil Cgo
+ * C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for a found
+ *     log event
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] numeric_query Address of a search::NumericQuery created by
+ *     numeric_query_new
+ * @param[out] ir_pos Position in ir_view read to, or on
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR (or + 1) the end of the log
+ *     events consumed before the incomplete log event (or the first log event
+ *     at or after time_interval.m_upper, which is left unconsumed)
+ * @param[out] log_event Log event stored in ir_deserializer
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::decode_next_message
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR + 1 if no log event
+ *     matches before time_interval.m_upper
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_eight_byte_numeric_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* numeric_query,
+        size_t* ir_pos,
+        LogEventView* log_event
+);
+
+/**
+ * Given a CLP IR buffer with four byte encoding, deserialize the next log event
+ * until finding an event that is both within the time interval and matches a
+ * numeric query. The query's predicates are evaluated directly on the encoded
+ * integer and float variables of each log event whose logtype the query
+ * matches (resolved once per logtype), so a log message is only decoded if the
+ * log event matches. All pointer parameters must be non-null (non-nil Cgo
+ * C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage for a found
+ *     log event
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] numeric_query Address of a search::NumericQuery created by
+ *     numeric_query_new
+ * @param[out] ir_pos Position in ir_view read to, or on
+ *     ffi::ir_stream::IRErrorCode_Incomplete_IR (or + 1) the end of the log
+ *     events consumed before the incomplete log event (or the first log event
+ *     at or after time_interval.m_upper, which is left unconsumed)
+ * @param[out] log_event Log event stored in ir_deserializer
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::decode_next_message
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR + 1 if no log event
+ *     matches before time_interval.m_upper
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_deserialize_four_byte_numeric_query_match(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        void* numeric_query,
+        size_t* ir_pos,
+        LogEventView* log_event
+);
+
+/**
+ * Given a CLP IR buffer with eight byte encoding, count the log events within
+ * the time interval matching each query of a compiled query, per time bucket,
+ * without returning any log event. Bucket i holds the log events with a
+ * timestamp in [lower + i * bucket_width, lower + (i + 1) * bucket_width), and
+ * the count of the log events in bucket i matching query q is added to
+ * counts[q * num_buckets + i], where num_buckets is the number of buckets
+ * needed to cover the time interval. A log event is counted once for each
+ * query it matches, and its log message is only decoded if its logtype (and
+ * encoded variables) leave a match undecided. Counting continues until the end
+ * of the stream, the end of ir_view, or the first log event at or after
+ * time_interval.m_upper, so a stream can be counted across several buffers by
+ * passing the same counts. All pointer parameters must be non-null (non-nil
+ * Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage while
+ *     counting
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] bucket_width Width of each time bucket in milliseconds
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile
+ * @param[out] ir_pos Position in ir_view read to (the end of the log events
+ *     counted)
+ * @param[in,out] counts Caller allocated count matrix of num_buckets columns
+ *     for each query, added to
+ * @return ffi::ir_stream::IRErrorCode_Eof if the IR stream's EOF tag is found
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR if ir_view ends (possibly
+ *     part way through a log event)
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR + 1 if a log event at or
+ *     after time_interval.m_upper is found (which is left unconsumed)
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the time interval,
+ *     bucket_width, or size of counts is invalid, or the compiled query is
+ *     empty
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::eight_byte_encoding::deserialize_log_event (ir_pos is
+ *     not set and the log events counted before the error are not reported)
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_eight_byte_count_matches(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        epoch_time_ms_t bucket_width,
+        void* compiled_query,
+        size_t* ir_pos,
+        Int64tSpan counts
+);
+
+/**
+ * Given a CLP IR buffer with four byte encoding, count the log events within
+ * the time interval matching each query of a compiled query, per time bucket,
+ * without returning any log event. Bucket i holds the log events with a
+ * timestamp in [lower + i * bucket_width, lower + (i + 1) * bucket_width), and
+ * the count of the log events in bucket i matching query q is added to
+ * counts[q * num_buckets + i], where num_buckets is the number of buckets
+ * needed to cover the time interval. A log event is counted once for each
+ * query it matches, and its log message is only decoded if its logtype (and
+ * encoded variables) leave a match undecided. Counting continues until the end
+ * of the stream, the end of ir_view, or the first log event at or after
+ * time_interval.m_upper, so a stream can be counted across several buffers by
+ * passing the same counts. All pointer parameters must be non-null (non-nil
+ * Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_view Byte buffer/slice containing CLP IR
+ * @param[in] ir_deserializer ir::Deserializer to be used as storage while
+ *     counting
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] bucket_width Width of each time bucket in milliseconds
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile
+ * @param[out] ir_pos Position in ir_view read to (the end of the log events
+ *     counted)
+ * @param[in,out] counts Caller allocated count matrix of num_buckets columns
+ *     for each query, added to
+ * @return ffi::ir_stream::IRErrorCode_Eof if the IR stream's EOF tag is found
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR if ir_view ends (possibly
+ *     part way through a log event)
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR + 1 if a log event at or
+ *     after time_interval.m_upper is found (which is left unconsumed)
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the time interval,
+ *     bucket_width, or size of counts is invalid, or the compiled query is
+ *     empty
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ffi::ir_stream::four_byte_encoding::deserialize_log_event (ir_pos is
+ *     not set and the log events counted before the error are not reported)
+ */
+CLP_FFI_GO_METHOD int ir_deserializer_four_byte_count_matches(
+        ByteSpan ir_view,
+        void* ir_deserializer,
+        TimestampInterval time_interval,
+        epoch_time_ms_t bucket_width,
+        void* compiled_query,
+        size_t* ir_pos,
+        Int64tSpan counts
+);
+
+/**
+ * Snapshot the counters of an ir::Deserializer. The counters are only
+ * maintained if the library is built with CLP_FFI_GO_ENABLE_COUNTERS defined,
+ * and otherwise compiled out entirely. All pointer parameters must be non-null
+ * (non-nil Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] ir_deserializer ir::Deserializer to snapshot
+ * @param[out] counters Snapshot of the counters (all 0 if disabled)
+ * @return 1 if the counters are enabled
+ * @return 0 if the counters are disabled, or ir_deserializer or counters is
+ *     null (with any counters left 0)
+ */
+CLP_FFI_GO_METHOD int
+ir_deserializer_get_counters(void* ir_deserializer, DeserializerCounters* counters);
+
+// NOLINTEND(modernize-use-using)
 // NOLINTEND(modernize-use-trailing-return-type)
 // NOLINTEND(modernize-deprecated-headers)
 #endif  // FFI_GO_IR_DESERIALIZER_H
@@ -0,0 +1,76 @@
+#ifndef FFI_GO_IR_ZSTD_COMPRESSOR_H
+#define FFI_GO_IR_ZSTD_COMPRESSOR_H
+// header must support C, making modernize checks inapplicable
+// NOLINTBEGIN(modernize-use-trailing-return-type)
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+
+/**
+ * Create an ir::ZstdCompressor to compress the IR of a Go ir.Writer (see
+ * ir.Writer.EnableZstd), starting its background compression thread.
+ * @param[in] compression_level zstd compression level
+ * @param[in] frame_size Number of bytes of IR after which to end a zstd frame
+ * @return Address of a new ir::ZstdCompressor
+ */
+CLP_FFI_GO_METHOD void* ir_zstd_compressor_new(int compression_level, size_t frame_size);
+
+/**
+ * Clean up the underlying ir::ZstdCompressor of a Go ir.Writer, waiting for
+ * its background thread to exit.
+ * @param[in] zstd_compressor Address of a ir::ZstdCompressor created and
+ *     returned by ir_zstd_compressor_new
+ */
+CLP_FFI_GO_METHOD void ir_zstd_compressor_close(void* zstd_compressor);
+
+/**
+ * Copy IR into an ir::ZstdCompressor to be compressed in the background, and
+ * return any frames compressed since the last call. The returned view is
+ * invalidated by the next call to ir_zstd_compressor_write or
+ * ir_zstd_compressor_finish. All pointer parameters must be non-null (non-nil
+ * Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] zstd_compressor Address of a ir::ZstdCompressor
+ * @param[in] ir IR to compress
+ * @param[out] compressed View of the compressed frames
+ * @return ffi::ir_stream::IRErrorCode_Success on success
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if a pointer is null
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR + 2 (Go ir.EncodeError) if
+ *     zstd failed to compress a frame
+ */
+CLP_FFI_GO_METHOD int
+ir_zstd_compressor_write(void* zstd_compressor, ByteSpan ir, ByteSpan* compressed);
+
+/**
+ * Compress all the remaining IR of an ir::ZstdCompressor, ending the last
+ * frame, and return every frame compressed since the last call. The returned
+ * view is invalidated by the next call to ir_zstd_compressor_write or
+ * ir_zstd_compressor_finish. All pointer parameters must be non-null (non-nil
+ * Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] zstd_compressor Address of a ir::ZstdCompressor
+ * @param[out] compressed View of the compressed frames
+ * @return ffi::ir_stream::IRErrorCode_Success on success
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if a pointer is null
+ * @return ffi::ir_stream::IRErrorCode_Incomplete_IR + 2 (Go ir.EncodeError) if
+ *     zstd failed to compress a frame
+ */
+CLP_FFI_GO_METHOD int ir_zstd_compressor_finish(void* zstd_compressor, ByteSpan* compressed);
+
+/**
+ * Get the boundaries of the zstd frames of an ir::ZstdCompressor, after
+ * ir_zstd_compressor_finish. The views remain valid until the ir::ZstdCompressor
+ * is closed. All pointer parameters must be non-null (non-nil Cgo C.<type>
+ * pointer or unsafe.Pointer from Go).
+ * @param[in] zstd_compressor Address of a ir::ZstdCompressor
+ * @param[out] uncompressed_ends Position in the uncompressed IR stream of the
+ *     end of each frame
+ * @param[out] compressed_ends Position in the compressed stream of the end of
+ *     each frame
+ */
+CLP_FFI_GO_METHOD void ir_zstd_compressor_get_frames(
+        void* zstd_compressor,
+        SizetSpan* uncompressed_ends,
+        SizetSpan* compressed_ends
+);
+
+// NOLINTEND(modernize-use-trailing-return-type)
+#endif  // FFI_GO_IR_ZSTD_COMPRESSOR_H
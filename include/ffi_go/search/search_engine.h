@@ -0,0 +1,130 @@
+#ifndef FFI_GO_SEARCH_SEARCH_ENGINE_H
+#define FFI_GO_SEARCH_SEARCH_ENGINE_H
+// header must support C, making modernize checks inapplicable
+// NOLINTBEGIN(modernize-use-trailing-return-type)
+// NOLINTBEGIN(modernize-use-using)
+
+#include "ffi_go/api_decoration.h"
+#include "ffi_go/defs.h"
+#include "ffi_go/search/wildcard_query.h"
+
+/**
+ * A log event found by a search::SearchEngine. m_source is the index of the
+ * source (buffer or file) containing the log event, and m_matching_query is the
+ * index of the first query in the compiled query that matches it.
+ */
+typedef struct {
+    LogEventView m_log_event;
+    size_t m_source;
+    size_t m_matching_query;
+} SearchResult;
+
+/**
+ * A span of a SearchResult array passed down through Cgo.
+ */
+typedef struct {
+    SearchResult* m_data;
+    size_t m_size;
+} SearchResultSpan;
+
+/**
+ * Start searching CLP IR buffers in parallel with a search::SearchEngine (see
+ * search_engine_next_results). Each buffer must hold an entire uncompressed IR
+ * stream, starting with its preamble. The buffers and compiled query must
+ * remain valid until the search::SearchEngine is deleted.
+ * @param[in] buffers IR streams to search
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile; if empty every log event within time_interval is
+ *     a match
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] num_threads Number of worker threads to search with
+ * @param[in] result_capacity Number of results that can be buffered before
+ *     the worker threads wait for them to be consumed
+ * @return Address of a new search::SearchEngine
+ * @return nullptr if compiled_query is null
+ * @return nullptr if the search::SearchEngine couldn't be created (e.g. its
+ *     worker threads couldn't be started)
+ */
+CLP_FFI_GO_METHOD void* search_engine_search_buffers(
+        ByteSpanSpan buffers,
+        void* compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+);
+
+/**
+ * Start searching uncompressed CLP IR files in parallel with a
+ * search::SearchEngine (see search_engine_next_results). The paths are packed
+ * back to back in paths, with path_end_offsets marking the end of each path.
+ * Each file is read into memory by the worker thread searching it. The compiled
+ * query must remain valid until the search::SearchEngine is deleted.
+ * @param[in] paths Concatenation of the paths of the files to search
+ * @param[in] path_end_offsets Array of offsets into paths marking the end of
+ *     each path
+ * @param[in] compiled_query Address of a search::CompiledQuery created by
+ *     wildcard_query_compile; if empty every log event within time_interval is
+ *     a match
+ * @param[in] time_interval Timestamp interval: [lower, upper)
+ * @param[in] num_threads Number of worker threads to search with
+ * @param[in] result_capacity Number of results that can be buffered before
+ *     the worker threads wait for them to be consumed
+ * @return Address of a new search::SearchEngine
+ * @return nullptr if compiled_query is null
+ * @return nullptr if an end offset is out of bounds
+ * @return nullptr if the search::SearchEngine couldn't be created (e.g. its
+ *     worker threads couldn't be started)
+ */
+CLP_FFI_GO_METHOD void* search_engine_search_files(
+        StringView paths,
+        SizetSpan path_end_offsets,
+        void* compiled_query,
+        TimestampInterval time_interval,
+        size_t num_threads,
+        size_t result_capacity
+);
+
+/**
+ * Wait for the next results of a search::SearchEngine. The views in results
+ * remain valid until the next call. All pointer parameters must be non-null
+ * (non-nil Cgo C.<type> pointer or unsafe.Pointer from Go).
+ * @param[in] search_engine Address of a search::SearchEngine
+ * @param[out] results Storage for up to results.m_size results
+ * @param[out] num_results Number of results stored in results
+ * @return 1 if any results were stored, 0 once every source has been searched
+ *     and all results have been returned
+ */
+CLP_FFI_GO_METHOD int search_engine_next_results(
+        void* search_engine,
+        SearchResultSpan results,
+        size_t* num_results
+);
+
+/**
+ * Get the error that occurred while searching a source. Only complete once
+ * search_engine_next_results has returned 0.
+ * @param[in] search_engine Address of a search::SearchEngine
+ * @param[in] source Index of the source
+ * @return ffi::ir_stream::IRErrorCode_Success if the source was searched
+ *     without error
+ * @return -1 if the source's file could not be read
+ * @return ffi::ir_stream::IRErrorCode_Corrupted_IR if the source's metadata
+ *     isn't a JSON object, or its reference timestamp isn't a string of an
+ *     integer
+ * @return ffi::ir_stream::IRErrorCode forwarded from
+ *     ir_deserializer_new_deserializer_with_preamble or
+ *     ir_deserializer_deserialize_*_compiled_query_match
+ */
+CLP_FFI_GO_METHOD int search_engine_get_source_error(void* search_engine, size_t source);
+
+/**
+ * Cancel the search of a search::SearchEngine, wait for its worker threads to
+ * exit, and delete it.
+ * @param[in] search_engine Address of a search::SearchEngine created and
+ *     returned by search_engine_search_*
+ */
+CLP_FFI_GO_METHOD void search_engine_delete(void* search_engine);
+
+// NOLINTEND(modernize-use-using)
+// NOLINTEND(modernize-use-trailing-return-type)
+#endif  // FFI_GO_SEARCH_SEARCH_ENGINE_H
@@ -58,14 +58,46 @@ CLP_FFI_GO_METHOD StringView wildcard_query_new(StringView query, void** ptr);
 CLP_FFI_GO_METHOD void wildcard_query_delete(void* str);
 
 /**
- * Given a target string perform CLP wildcard matching using query. See
- * `wildcard_match_unsafe` in CLP src/string_utils.hpp.
+ * Given a target string perform CLP wildcard matching using query, with the
+ * same results as `wildcard_match_unsafe` in CLP src/string_utils.hpp (see
+ * search::wildcard_match for the vectorized implementation).
  * @param[in] target String to perform matching on
  * @param[in] query Query to use for matching
  * @return 1 if query matches target, 0 otherwise
  */
 CLP_FFI_GO_METHOD int wildcard_query_match(StringView target, WildcardQueryView query);
 
+/**
+ * Compile the queries of a merged query into a search::CompiledQuery, which
+ * can be reused to match any number of targets (e.g. passed to
+ * ir_deserializer_deserialize_*_compiled_query_match).
+ * @param[in] merged_query Queries to compile
+ * @return Address of a new search::CompiledQuery
+ */
+CLP_FFI_GO_METHOD void* wildcard_query_compile(MergedWildcardQueryView merged_query);
+
+/**
+ * Delete a search::CompiledQuery.
+ * @param[in] compiled_query Address of a search::CompiledQuery created and
+ *   returned by wildcard_query_compile
+ */
+CLP_FFI_GO_METHOD void wildcard_query_compiled_delete(void* compiled_query);
+
+/**
+ * Given a target string find the first query in a compiled query that matches
+ * it. All pointer parameters must be non-null (non-nil Cgo C.<type> pointer or
+ * unsafe.Pointer from Go).
+ * @param[in] target String to perform matching on
+ * @param[in] compiled_query Address of a search::CompiledQuery
+ * @param[out] matching_query Index of the first matching query
+ * @return 1 if any query matches target, 0 otherwise
+ */
+CLP_FFI_GO_METHOD int wildcard_query_compiled_match(
+        StringView target,
+        void* compiled_query,
+        size_t* matching_query
+);
+
 // NOLINTEND(modernize-use-using)
 // NOLINTEND(modernize-use-trailing-return-type)
 #endif  // FFI_GO_IR_WILDCARD_QUERY_H
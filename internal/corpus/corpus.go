@@ -0,0 +1,281 @@
+// The corpus package generates large, deterministic sets of log events for
+// testing and benchmarking CLP IR without storing them. Log messages are built
+// from a fixed number of randomly generated logtypes (templates of static text
+// and variable placeholders), with the variables of each message drawn fresh.
+// The same [Config] (including its Seed) always generates the same log events.
+package corpus
+
+import (
+	"errors"
+	"fmt"
+	"math"
+	"math/rand"
+	"strings"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+)
+
+// Config controls the shape of the log events generated by a [Generator].
+type Config struct {
+	// Seed of the random number generator.
+	Seed int64
+
+	// NumLogtypes is the number of distinct logtypes to generate messages
+	// from. LogtypeSkew is the Zipf exponent (> 1) of how often each logtype
+	// is used, so a few logtypes make up most messages as in real logs; 0
+	// uses every logtype equally often.
+	NumLogtypes int
+	LogtypeSkew float64
+
+	// VarDensity is the fraction of the tokens of a logtype that are
+	// variables. IntWeight, FloatWeight, and DictWeight are the relative
+	// frequencies of integer, float, and dictionary variables.
+	VarDensity  float64
+	IntWeight   int
+	FloatWeight int
+	DictWeight  int
+
+	// DictCardinality bounds the number of distinct dictionary variable
+	// values (0 for no bound).
+	DictCardinality int
+
+	// The length of each logtype's messages is drawn from a log-normal
+	// distribution with median MedianLength and shape LengthSigma, clamped to
+	// [MinLength, MaxLength].
+	MedianLength int
+	LengthSigma  float64
+	MinLength    int
+	MaxLength    int
+
+	// The i-th log event's timestamp is Start + i*Interval, offset by up to
+	// Jitter in either direction (so log events may be slightly out of order).
+	Start    ffi.EpochTimeMs
+	Interval ffi.EpochTimeMs
+	Jitter   ffi.EpochTimeMs
+}
+
+// DefaultConfig returns a Config resembling the logs of a typical service:
+// 256 skewed logtypes of about 120 bytes, with a mix of every variable type,
+// and a log event every 10ms.
+func DefaultConfig() Config {
+	return Config{
+		Seed:            1,
+		NumLogtypes:     256,
+		LogtypeSkew:     1.2,
+		VarDensity:      0.3,
+		IntWeight:       3,
+		FloatWeight:     1,
+		DictWeight:      2,
+		DictCardinality: 0,
+		MedianLength:    120,
+		LengthSigma:     0.5,
+		MinLength:       16,
+		MaxLength:       4096,
+		Start:           1704067200000,
+		Interval:        10,
+		Jitter:          5,
+	}
+}
+
+// ErrInvalidConfig is wrapped by the error returned from [NewGenerator] for an
+// invalid [Config].
+var ErrInvalidConfig = errors.New("corpus: invalid config")
+
+type varKind int
+
+const (
+	staticText varKind = iota
+	intVar
+	floatVar
+	dictVar
+)
+
+type segment struct {
+	kind varKind
+	text string // static text, or the key preceding a variable
+}
+
+// A Generator generates log events according to a [Config].
+type Generator struct {
+	config    Config
+	rng       *rand.Rand
+	zipf      *rand.Zipf
+	logtypes  [][]segment
+	numEvents int
+	msg       strings.Builder
+}
+
+// Words making up the static text of logtypes.
+var words = []string{
+	"request", "response", "connection", "block", "task", "stage", "worker",
+	"received", "sent", "failed", "completed", "started", "stopped", "retrying",
+	"from", "to", "in", "of", "with", "for", "after", "timeout", "cache", "miss",
+	"hit", "user", "session", "query", "table", "partition", "replica", "leader",
+	"INFO", "WARN", "ERROR", "DEBUG", "storage", "executor", "scheduler", "lease",
+}
+
+// Keys preceding the variables of logtypes. Each ends with a delimiter so the
+// variable is tokenized on its own.
+var keys = []string{
+	"id=", "size=", "took ", "count=", "offset=", "latency=", "host=", "path=",
+	"block:", "attempt ", "port ", "ratio=", "",
+}
+
+// NewGenerator validates config and generates its logtypes. Returns:
+//   - success: valid [*Generator], nil
+//   - error: nil [*Generator], error wrapping [ErrInvalidConfig]
+func NewGenerator(config Config) (*Generator, error) {
+	if err := config.validate(); nil != err {
+		return nil, err
+	}
+	gen := &Generator{config: config, rng: rand.New(rand.NewSource(config.Seed))}
+	if 0 != config.LogtypeSkew {
+		gen.zipf = rand.NewZipf(gen.rng, config.LogtypeSkew, 1, uint64(config.NumLogtypes-1))
+	}
+	gen.logtypes = make([][]segment, config.NumLogtypes)
+	for i := range gen.logtypes {
+		gen.logtypes[i] = gen.newLogtype()
+	}
+	return gen, nil
+}
+
+func (config Config) validate() error {
+	switch {
+	case 0 >= config.NumLogtypes:
+		return fmt.Errorf("%w: NumLogtypes must be positive", ErrInvalidConfig)
+	case 0 != config.LogtypeSkew && 1 >= config.LogtypeSkew:
+		return fmt.Errorf("%w: LogtypeSkew must be 0 or greater than 1", ErrInvalidConfig)
+	case 0 > config.VarDensity || 1 < config.VarDensity:
+		return fmt.Errorf("%w: VarDensity must be within [0, 1]", ErrInvalidConfig)
+	case 0 > config.IntWeight || 0 > config.FloatWeight || 0 > config.DictWeight:
+		return fmt.Errorf("%w: variable weights must not be negative", ErrInvalidConfig)
+	case 0 < config.VarDensity && 0 == config.IntWeight+config.FloatWeight+config.DictWeight:
+		return fmt.Errorf("%w: variables require a positive weight", ErrInvalidConfig)
+	case 0 > config.DictCardinality:
+		return fmt.Errorf("%w: DictCardinality must not be negative", ErrInvalidConfig)
+	case 0 >= config.MinLength || config.MinLength > config.MaxLength:
+		return fmt.Errorf("%w: MinLength must be within [1, MaxLength]", ErrInvalidConfig)
+	case 0 >= config.MedianLength || 0 > config.LengthSigma:
+		return fmt.Errorf("%w: invalid length distribution", ErrInvalidConfig)
+	case 0 > config.Interval || 0 > config.Jitter:
+		return fmt.Errorf("%w: Interval and Jitter must not be negative", ErrInvalidConfig)
+	}
+	return nil
+}
+
+// newLogtype returns a logtype of static words and variables whose messages
+// are roughly a length drawn from the configured distribution.
+func (gen *Generator) newLogtype() []segment {
+	length := int(float64(gen.config.MedianLength) *
+		math.Exp(gen.rng.NormFloat64()*gen.config.LengthSigma))
+	length = max(gen.config.MinLength, min(length, gen.config.MaxLength))
+	var logtype []segment
+	// The estimated length of a variable's value.
+	const varLength int = 8
+	for size := 0; size < length; {
+		if 0 < size {
+			logtype = append(logtype, segment{staticText, " "})
+			size++
+		}
+		if gen.rng.Float64() >= gen.config.VarDensity {
+			word := words[gen.rng.Intn(len(words))]
+			logtype = append(logtype, segment{staticText, word})
+			size += len(word)
+			continue
+		}
+		key := keys[gen.rng.Intn(len(keys))]
+		logtype = append(logtype, segment{gen.newVarKind(), key})
+		size += len(key) + varLength
+	}
+	return logtype
+}
+
+func (gen *Generator) newVarKind() varKind {
+	n := gen.rng.Intn(gen.config.IntWeight + gen.config.FloatWeight + gen.config.DictWeight)
+	switch {
+	case n < gen.config.IntWeight:
+		return intVar
+	case n < gen.config.IntWeight+gen.config.FloatWeight:
+		return floatVar
+	default:
+		return dictVar
+	}
+}
+
+// Next returns the next log event.
+func (gen *Generator) Next() ffi.LogEvent {
+	var logtype []segment
+	if nil != gen.zipf {
+		logtype = gen.logtypes[gen.zipf.Uint64()]
+	} else {
+		logtype = gen.logtypes[gen.rng.Intn(len(gen.logtypes))]
+	}
+	gen.msg.Reset()
+	for _, seg := range logtype {
+		gen.msg.WriteString(seg.text)
+		switch seg.kind {
+		case intVar:
+			gen.writeInt()
+		case floatVar:
+			gen.writeFloat()
+		case dictVar:
+			gen.writeDictVar()
+		}
+	}
+	timestamp := gen.config.Start + ffi.EpochTimeMs(gen.numEvents)*gen.config.Interval
+	if 0 < gen.config.Jitter {
+		timestamp += ffi.EpochTimeMs(gen.rng.Int63n(int64(2*gen.config.Jitter+1))) -
+			gen.config.Jitter
+	}
+	gen.numEvents++
+	return ffi.LogEvent{LogMessage: gen.msg.String(), Timestamp: timestamp}
+}
+
+// Generate returns the next n log events.
+func (gen *Generator) Generate(n int) []ffi.LogEvent {
+	events := make([]ffi.LogEvent, n)
+	for i := range events {
+		events[i] = gen.Next()
+	}
+	return events
+}
+
+// writeInt writes an integer that is usually small, occasionally large, and
+// occasionally negative.
+func (gen *Generator) writeInt() {
+	var n int64
+	switch r := gen.rng.Intn(10); {
+	case 0 == r:
+		n = gen.rng.Int63()
+	case 1 == r:
+		n = -gen.rng.Int63n(1000)
+	default:
+		n = gen.rng.Int63n(100000)
+	}
+	fmt.Fprintf(&gen.msg, "%d", n)
+}
+
+func (gen *Generator) writeFloat() {
+	precision := 1 + gen.rng.Intn(4)
+	fmt.Fprintf(&gen.msg, "%.*f", precision, gen.rng.Float64()*math.Pow10(gen.rng.Intn(5)))
+}
+
+// writeDictVar writes a value that CLP stores in its dictionary (i.e. contains
+// a digit but isn't an integer or float): an identifier, an IP address, or a
+// path.
+func (gen *Generator) writeDictVar() {
+	var id int64
+	if 0 < gen.config.DictCardinality {
+		id = gen.rng.Int63n(int64(gen.config.DictCardinality))
+	} else {
+		id = gen.rng.Int63()
+	}
+	switch id % 3 {
+	case 0:
+		fmt.Fprintf(&gen.msg, "job_%x_%d", id, id%7)
+	case 1:
+		fmt.Fprintf(&gen.msg, "10.%d.%d.%d", (id>>16)&0xff, (id>>8)&0xff, id&0xff)
+	default:
+		fmt.Fprintf(&gen.msg, "/data/%d/part-%05d", id%97, id%100000)
+	}
+}
@@ -0,0 +1,64 @@
+package corpus
+
+import (
+	"errors"
+	"slices"
+	"strings"
+	"testing"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+)
+
+func TestGeneratorDeterministic(t *testing.T) {
+	config := DefaultConfig()
+	first, err := NewGenerator(config)
+	if nil != err {
+		t.Fatalf("NewGenerator failed: %v", err)
+	}
+	second, _ := NewGenerator(config)
+	events := first.Generate(1000)
+	if !slices.Equal(events, second.Generate(1000)) {
+		t.Fatalf("Generators with the same Config generated different log events")
+	}
+	config.Seed++
+	other, _ := NewGenerator(config)
+	if slices.Equal(events, other.Generate(1000)) {
+		t.Fatalf("Generators with different seeds generated the same log events")
+	}
+}
+
+func TestGeneratorConfig(t *testing.T) {
+	config := DefaultConfig()
+	config.NumLogtypes = 1
+	config.VarDensity = 0
+	config.MinLength = 100
+	config.MaxLength = 100
+	config.Interval = 3
+	config.Jitter = 0
+	gen, err := NewGenerator(config)
+	if nil != err {
+		t.Fatalf("NewGenerator failed: %v", err)
+	}
+	events := gen.Generate(10)
+	for i, event := range events {
+		if events[0].LogMessage != event.LogMessage {
+			t.Fatalf(
+				"Static logtype generated different messages: '%v' != '%v'",
+				event.LogMessage,
+				events[0].LogMessage,
+			)
+		}
+		if config.Start+3*ffi.EpochTimeMs(i) != event.Timestamp {
+			t.Fatalf("Wrong timestamp: %v", event.Timestamp)
+		}
+	}
+	msg := events[0].LogMessage
+	if len(msg) < config.MinLength || strings.ContainsAny(msg, "0123456789") {
+		t.Fatalf("Wrong static message: '%v'", msg)
+	}
+
+	config.LogtypeSkew = 0.5
+	if _, err = NewGenerator(config); !errors.Is(err, ErrInvalidConfig) {
+		t.Fatalf("NewGenerator accepted an invalid LogtypeSkew: %v", err)
+	}
+}
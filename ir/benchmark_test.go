@@ -0,0 +1,449 @@
+package ir
+
+import (
+	"bytes"
+	"fmt"
+	"math/rand"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+	"github.com/y-scope/clp-ffi-go/internal/corpus"
+	"github.com/y-scope/clp-ffi-go/search"
+)
+
+const benchCorpusSize int = 4096
+
+// A benchCorpus is a set of log events that every benchmark runs over, so
+// results of different entry points can be compared.
+type benchCorpus struct {
+	name   string
+	events []ffi.LogEvent
+	size   int64
+}
+
+// Templates of log messages resembling those of common distributed systems.
+// Each %v is replaced by a value drawn by realisticValue.
+var realisticTemplates = []string{
+	"INFO hdfs.server.datanode.DataNode: Receiving block blk_%v src: /%v:%v dest: /%v:%v",
+	"INFO mapred.TaskTracker: attempt_%v_m_%v_0 %v%% reduce > copy (%v of %v at %v MB/s)",
+	"WARN spark.storage.BlockManager: Putting block rdd_%v_%v failed due to exception %v",
+	"ERROR container_%v: Container killed on request. Exit code is %v, memory used %v GB of %v GB",
+	"DEBUG c.y.s.HttpServer: GET /api/v1/jobs/%v/tasks?limit=%v took %vms status=%v user=%v",
+	"INFO Executor: Finished task %v.0 in stage %v.0 (TID %v). %v bytes result sent to driver",
+}
+
+func realisticValue(rng *rand.Rand) any {
+	switch rng.Intn(5) {
+	case 0:
+		return rng.Int63n(1 << 40)
+	case 1:
+		return fmt.Sprintf("10.%v.%v.%v", rng.Intn(256), rng.Intn(256), rng.Intn(256))
+	case 2:
+		return fmt.Sprintf("%.3f", rng.Float64()*1000)
+	case 3:
+		return fmt.Sprintf("job_%x", rng.Uint32())
+	default:
+		return rng.Intn(100)
+	}
+}
+
+// Returns a corpus generated with a uniform mix of static text, integer, float,
+// and dictionary variables, and a corpus drawn from realisticTemplates. Both
+// are deterministic.
+func benchCorpora() []benchCorpus {
+	config := corpus.DefaultConfig()
+	config.LogtypeSkew = 0
+	config.VarDensity = 0.5
+	config.IntWeight, config.FloatWeight, config.DictWeight = 1, 1, 1
+	gen, err := corpus.NewGenerator(config)
+	if nil != err {
+		panic(err)
+	}
+	synthetic := benchCorpus{name: "Synthetic"}
+	for _, event := range gen.Generate(benchCorpusSize) {
+		synthetic.add(event.LogMessage, event.Timestamp)
+	}
+
+	rng := rand.New(rand.NewSource(1))
+	start := ffi.EpochTimeMs(time.Date(2024, 1, 1, 0, 0, 0, 0, time.UTC).UnixMilli())
+	realistic := benchCorpus{name: "Realistic"}
+	for i := 0; i < benchCorpusSize; i++ {
+		template := realisticTemplates[rng.Intn(len(realisticTemplates))]
+		args := make([]any, strings.Count(template, "%v"))
+		for j := range args {
+			args[j] = realisticValue(rng)
+		}
+		realistic.add(fmt.Sprintf(template, args...), start+ffi.EpochTimeMs(i))
+	}
+	return []benchCorpus{synthetic, realistic}
+}
+
+func (corpus *benchCorpus) add(msg string, timestamp ffi.EpochTimeMs) {
+	corpus.events = append(corpus.events, ffi.LogEvent{LogMessage: msg, Timestamp: timestamp})
+	corpus.size += int64(len(msg))
+}
+
+// Serializes the corpus into a complete IR stream with T encoding.
+func serializeBenchCorpus[T EightByteEncoding | FourByteEncoding](
+	b *testing.B,
+	corpus benchCorpus,
+) []byte {
+	writer, err := NewWriterSize[T](int(corpus.size), "UTC")
+	if nil != err {
+		b.Fatalf("NewWriterSize failed: %v", err)
+	}
+	if _, err = writer.WriteBatch(corpus.events); nil != err {
+		b.Fatalf("Writer.WriteBatch failed: %v", err)
+	}
+	var buf bytes.Buffer
+	if _, err = writer.CloseTo(&buf); nil != err {
+		b.Fatalf("Writer.CloseTo failed: %v", err)
+	}
+	return buf.Bytes()
+}
+
+// Starts measuring a benchmark that processes every event of corpus per
+// iteration. reportEventRate must be called once the iterations are done.
+func startBenchCorpus(b *testing.B, corpus benchCorpus) {
+	b.ReportAllocs()
+	b.SetBytes(corpus.size)
+	b.ResetTimer()
+}
+
+func reportEventRate(b *testing.B, eventsPerOp int) {
+	b.ReportMetric(float64(b.N*eventsPerOp)/b.Elapsed().Seconds(), "events/s")
+}
+
+// Runs bench for both encodings over every corpus.
+func runBenchCorpora(
+	b *testing.B,
+	bench func(b *testing.B, encoding testArg, corpus benchCorpus),
+) {
+	for _, corpus := range benchCorpora() {
+		for _, encoding := range []testArg{eightByteEncoding, fourByteEncoding} {
+			corpus, encoding := corpus, encoding // capture range variables for func literal
+			b.Run(corpus.name+"/"+testArgStr[encoding], func(b *testing.B) {
+				bench(b, encoding, corpus)
+			})
+		}
+	}
+}
+
+func BenchmarkEncodeCorpus(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		if eightByteEncoding == encoding {
+			encoder, _ := EightByteEncoder()
+			defer encoder.Close()
+			benchmarkEncodeCorpus(b, encoder, corpus)
+		} else {
+			encoder, _ := FourByteEncoder()
+			defer encoder.Close()
+			benchmarkEncodeCorpus(b, encoder, corpus)
+		}
+	})
+}
+
+func benchmarkEncodeCorpus[T EightByteEncoding | FourByteEncoding](
+	b *testing.B,
+	encoder Encoder[T],
+	corpus benchCorpus,
+) {
+	startBenchCorpus(b, corpus)
+	for i := 0; i < b.N; i++ {
+		for _, event := range corpus.events {
+			if _, err := encoder.EncodeLogMessage(event.LogMessage); nil != err {
+				b.Fatalf("Encoder.EncodeLogMessage failed: %v", err)
+			}
+		}
+	}
+	reportEventRate(b, len(corpus.events))
+}
+
+func BenchmarkDecodeCorpus(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		if eightByteEncoding == encoding {
+			encoder, _ := EightByteEncoder()
+			defer encoder.Close()
+			decoder, _ := EightByteDecoder()
+			defer decoder.Close()
+			benchmarkDecodeCorpus(b, encoder, decoder, corpus)
+		} else {
+			encoder, _ := FourByteEncoder()
+			defer encoder.Close()
+			decoder, _ := FourByteDecoder()
+			defer decoder.Close()
+			benchmarkDecodeCorpus(b, encoder, decoder, corpus)
+		}
+	})
+}
+
+func benchmarkDecodeCorpus[T EightByteEncoding | FourByteEncoding](
+	b *testing.B,
+	encoder Encoder[T],
+	decoder Decoder[T],
+	corpus benchCorpus,
+) {
+	// Copy each encoded message out of the encoder's reused view.
+	irMsgs := make([]LogMessage[T], len(corpus.events))
+	for i, event := range corpus.events {
+		irMsg, err := encoder.EncodeLogMessage(event.LogMessage)
+		if nil != err {
+			b.Fatalf("Encoder.EncodeLogMessage failed: %v", err)
+		}
+		irMsgs[i] = LogMessage[T]{
+			Logtype:           strings.Clone(irMsg.Logtype),
+			Vars:              append([]T(nil), irMsg.Vars...),
+			DictVars:          strings.Clone(irMsg.DictVars),
+			DictVarEndOffsets: append([]int32(nil), irMsg.DictVarEndOffsets...),
+		}
+	}
+	startBenchCorpus(b, corpus)
+	for i := 0; i < b.N; i++ {
+		for _, irMsg := range irMsgs {
+			if _, err := decoder.DecodeLogMessage(irMsg); nil != err {
+				b.Fatalf("Decoder.DecodeLogMessage failed: %v", err)
+			}
+		}
+	}
+	reportEventRate(b, len(irMsgs))
+}
+
+func newBenchSerializer(b *testing.B, encoding testArg) Serializer {
+	var serializer Serializer
+	var err error
+	if eightByteEncoding == encoding {
+		serializer, _, err = EightByteSerializer("", "", "UTC")
+	} else {
+		serializer, _, err = FourByteSerializer("", "", "UTC", 0)
+	}
+	if nil != err {
+		b.Fatalf("Serializer creation failed: %v", err)
+	}
+	return serializer
+}
+
+func BenchmarkSerializeLogEvent(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		serializer := newBenchSerializer(b, encoding)
+		defer serializer.Close()
+		startBenchCorpus(b, corpus)
+		for i := 0; i < b.N; i++ {
+			for _, event := range corpus.events {
+				if _, err := serializer.SerializeLogEvent(event); nil != err {
+					b.Fatalf("Serializer.SerializeLogEvent failed: %v", err)
+				}
+			}
+		}
+		reportEventRate(b, len(corpus.events))
+	})
+}
+
+func BenchmarkSerializeLogEventBatch(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		serializer := newBenchSerializer(b, encoding)
+		defer serializer.Close()
+		startBenchCorpus(b, corpus)
+		for i := 0; i < b.N; i++ {
+			if _, err := serializer.SerializeLogEventBatch(corpus.events); nil != err {
+				b.Fatalf("Serializer.SerializeLogEventBatch failed: %v", err)
+			}
+		}
+		reportEventRate(b, len(corpus.events))
+	})
+}
+
+func BenchmarkAppendLogEventBatch(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		serializer := newBenchSerializer(b, encoding)
+		defer serializer.Close()
+		startBenchCorpus(b, corpus)
+		for i := 0; i < b.N; i++ {
+			serializer.ClearBufferedIr()
+			if _, err := serializer.AppendLogEventBatch(corpus.events); nil != err {
+				b.Fatalf("Serializer.AppendLogEventBatch failed: %v", err)
+			}
+		}
+		reportEventRate(b, len(corpus.events))
+	})
+}
+
+func serializeBenchCorpusAs(b *testing.B, encoding testArg, corpus benchCorpus) []byte {
+	if eightByteEncoding == encoding {
+		return serializeBenchCorpus[EightByteEncoding](b, corpus)
+	}
+	return serializeBenchCorpus[FourByteEncoding](b, corpus)
+}
+
+func BenchmarkDeserializeLogEvent(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		irBuf := serializeBenchCorpusAs(b, encoding, corpus)
+		startBenchCorpus(b, corpus)
+		for i := 0; i < b.N; i++ {
+			deserializer, pos, err := DeserializePreamble(irBuf)
+			if nil != err {
+				b.Fatalf("DeserializePreamble failed: %v", err)
+			}
+			for {
+				_, n, err := deserializer.DeserializeLogEvent(irBuf[pos:])
+				if EndOfIr == err {
+					break
+				}
+				if nil != err {
+					b.Fatalf("Deserializer.DeserializeLogEvent failed: %v", err)
+				}
+				pos += n
+			}
+			deserializer.Close()
+		}
+		reportEventRate(b, len(corpus.events))
+	})
+}
+
+func BenchmarkDeserializeLogEventBatch(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		irBuf := serializeBenchCorpusAs(b, encoding, corpus)
+		events := make([]ffi.LogEventView, 256)
+		startBenchCorpus(b, corpus)
+		for i := 0; i < b.N; i++ {
+			deserializer, pos, err := DeserializePreamble(irBuf)
+			if nil != err {
+				b.Fatalf("DeserializePreamble failed: %v", err)
+			}
+			for {
+				_, n, err := deserializer.DeserializeLogEventBatch(irBuf[pos:], events, 0)
+				if EndOfIr == err {
+					break
+				}
+				if nil != err {
+					b.Fatalf("Deserializer.DeserializeLogEventBatch failed: %v", err)
+				}
+				pos += n
+			}
+			deserializer.Close()
+		}
+		reportEventRate(b, len(corpus.events))
+	})
+}
+
+func BenchmarkDeserializeLogEventColumns(b *testing.B) {
+	runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+		irBuf := serializeBenchCorpusAs(b, encoding, corpus)
+		startBenchCorpus(b, corpus)
+		for i := 0; i < b.N; i++ {
+			deserializer, pos, err := DeserializePreamble(irBuf)
+			if nil != err {
+				b.Fatalf("DeserializePreamble failed: %v", err)
+			}
+			for {
+				_, n, err := deserializer.DeserializeLogEventColumns(
+					irBuf[pos:],
+					256,
+					0,
+					LogEventColumnsOptions{},
+				)
+				if EndOfIr == err {
+					break
+				}
+				if nil != err {
+					b.Fatalf("Deserializer.DeserializeLogEventColumns failed: %v", err)
+				}
+				pos += n
+			}
+			deserializer.Close()
+		}
+		reportEventRate(b, len(corpus.events))
+	})
+}
+
+// Returns numQueries queries over the realistic corpus, where roughly one in
+// four matches a log event.
+func benchQueries(numQueries int) []search.WildcardQuery {
+	patterns := []string{
+		"*Receiving block blk_*",
+		"*Exit code is 1?,*",
+		"*took 9*ms*",
+		"*BlockManager*failed*",
+		"*attempt_*_m_*_0 9?%*",
+		"*not in the corpus*",
+		"*TID 4*",
+		"*status=5*",
+	}
+	queries := make([]search.WildcardQuery, numQueries)
+	for i := range queries {
+		queries[i] = search.NewWildcardQuery(patterns[i%len(patterns)], 0 == i%2)
+	}
+	return queries
+}
+
+// Benchmarks searching the IR stream of each corpus with an increasing number
+// of queries, using a merged query, a compiled query, and a ParallelSearch of
+// a single buffer.
+func BenchmarkWildcardSearch(b *testing.B) {
+	for _, numQueries := range []int{1, 4, 16, 64} {
+		queries := benchQueries(numQueries)
+		runBenchCorpora(b, func(b *testing.B, encoding testArg, corpus benchCorpus) {
+			irBuf := serializeBenchCorpusAs(b, encoding, corpus)
+			b.Run(fmt.Sprintf("Merged/Queries=%v", numQueries), func(b *testing.B) {
+				benchmarkReaderSearch(b, irBuf, corpus, func(reader *Reader) error {
+					_, _, err := reader.ReadToWildcardMatch(queries)
+					return err
+				})
+			})
+			b.Run(fmt.Sprintf("Compiled/Queries=%v", numQueries), func(b *testing.B) {
+				compiledQuery := search.CompileWildcardQueries(queries)
+				defer compiledQuery.Close()
+				benchmarkReaderSearch(b, irBuf, corpus, func(reader *Reader) error {
+					_, _, err := reader.ReadToCompiledQueryMatch(compiledQuery)
+					return err
+				})
+			})
+			b.Run(fmt.Sprintf("Parallel/Queries=%v", numQueries), func(b *testing.B) {
+				compiledQuery := search.CompileWildcardQueries(queries)
+				defer compiledQuery.Close()
+				timeInterval := search.TimestampInterval{Lower: 0, Upper: 1 << 62}
+				startBenchCorpus(b, corpus)
+				for i := 0; i < b.N; i++ {
+					ps, err := SearchBuffers([][]byte{irBuf}, compiledQuery, timeInterval, 1)
+					if nil != err {
+						b.Fatalf("SearchBuffers failed: %v", err)
+					}
+					for {
+						if _, err := ps.Next(); nil != err {
+							break
+						}
+					}
+					ps.Close()
+				}
+				reportEventRate(b, len(corpus.events))
+			})
+		})
+	}
+}
+
+// Reads the IR stream with readNext until EndOfIr, once per iteration.
+func benchmarkReaderSearch(
+	b *testing.B,
+	irBuf []byte,
+	corpus benchCorpus,
+	readNext func(reader *Reader) error,
+) {
+	startBenchCorpus(b, corpus)
+	for i := 0; i < b.N; i++ {
+		reader, err := NewReaderSize(bytes.NewReader(irBuf), len(irBuf))
+		if nil != err {
+			b.Fatalf("NewReaderSize failed: %v", err)
+		}
+		for {
+			if err = readNext(reader); nil != err {
+				break
+			}
+		}
+		if EndOfIr != err {
+			b.Fatalf("Reader search failed: %v", err)
+		}
+		reader.Close()
+	}
+	reportEventRate(b, len(corpus.events))
+}
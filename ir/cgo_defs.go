@@ -40,6 +40,13 @@ func newCInt64tSpan(s []int64) C.Int64tSpan {
 	}
 }
 
+func newCSizetSpan(s []int) C.SizetSpan {
+	return C.SizetSpan{
+		(*C.size_t)(unsafe.Pointer(unsafe.SliceData(s))),
+		C.size_t(len(s)),
+	}
+}
+
 func newCStringView(s string) C.StringView {
 	return C.StringView{
 		(*C.char)(unsafe.Pointer(unsafe.StringData(s))),
@@ -47,13 +54,17 @@ func newCStringView(s string) C.StringView {
 	}
 }
 
+func newCStringViewFromBytes(s []byte) C.StringView {
+	return C.StringView{
+		(*C.char)(unsafe.Pointer(unsafe.SliceData(s))),
+		C.size_t(len(s)),
+	}
+}
+
 func newMergedWildcardQueryView(mergedQuery search.MergedWildcardQuery) C.MergedWildcardQueryView {
 	return C.MergedWildcardQueryView{
 		newCStringView(mergedQuery.Queries()),
-		C.SizetSpan{
-			(*C.size_t)(unsafe.Pointer(unsafe.SliceData(mergedQuery.EndOffsets()))),
-			C.size_t(len(mergedQuery.EndOffsets())),
-		},
+		newCSizetSpan(mergedQuery.EndOffsets()),
 		C.BoolSpan{
 			(*C.bool)(unsafe.Pointer(unsafe.SliceData(mergedQuery.CaseSensitivity()))),
 			C.size_t(len(mergedQuery.CaseSensitivity())),
@@ -61,13 +72,17 @@ func newMergedWildcardQueryView(mergedQuery search.MergedWildcardQuery) C.Merged
 	}
 }
 
-func newLogMessageView[Tgo EightByteEncoding | FourByteEncoding, Tc C.Int64tSpan | C.Int32tSpan](
+// setLogMessageView points msgView at the C++ allocated fields of an encoded
+// log message, so that an Encoder can reuse the same LogMessageView for every
+// message it encodes.
+func setLogMessageView[Tgo EightByteEncoding | FourByteEncoding, Tc C.Int64tSpan | C.Int32tSpan](
+	msgView *LogMessageView[Tgo],
 	logtype C.StringView,
 	vars Tc,
 	dictVars C.StringView,
 	dictVarEndOffsets C.Int32tSpan,
 ) *LogMessageView[Tgo] {
-	var msgView LogMessageView[Tgo]
+	*msgView = LogMessageView[Tgo]{}
 	msgView.Logtype = unsafe.String((*byte)(unsafe.Pointer(logtype.m_data)), logtype.m_size)
 	switch any(msgView.Vars).(type) {
 	case []EightByteEncoding:
@@ -86,7 +101,7 @@ func newLogMessageView[Tgo EightByteEncoding | FourByteEncoding, Tc C.Int64tSpan
 		return nil
 	}
 	if 0 < dictVars.m_size && nil != dictVars.m_data {
-		msgView.Logtype = unsafe.String((*byte)(unsafe.Pointer(dictVars.m_data)), dictVars.m_size)
+		msgView.DictVars = unsafe.String((*byte)(unsafe.Pointer(dictVars.m_data)), dictVars.m_size)
 	}
 	if 0 < dictVarEndOffsets.m_size && nil != dictVarEndOffsets.m_data {
 		msgView.DictVarEndOffsets = unsafe.Slice(
@@ -94,5 +109,5 @@ func newLogMessageView[Tgo EightByteEncoding | FourByteEncoding, Tc C.Int64tSpan
 			dictVarEndOffsets.m_size,
 		)
 	}
-	return &msgView
+	return msgView
 }
@@ -33,15 +33,148 @@ const (
 // failure to do so will result in a memory leak.
 type Deserializer interface {
 	DeserializeLogEvent(irBuf []byte) (*ffi.LogEventView, int, error)
+	DeserializeLogEventBatch(
+		irBuf []byte,
+		events []ffi.LogEventView,
+		maxBytes int,
+	) (int, int, error)
+	DeserializeLogEventColumns(
+		irBuf []byte,
+		maxEvents int,
+		maxBytes int,
+		options LogEventColumnsOptions,
+	) (*LogEventColumns, int, error)
 	DeserializeWildcardMatchWithTimeInterval(
 		irBuf []byte,
 		mergedQuery search.MergedWildcardQuery,
 		timeInterval search.TimestampInterval,
 	) (*ffi.LogEventView, int, int, error)
+	DeserializeCompiledQueryMatchWithTimeInterval(
+		irBuf []byte,
+		compiledQuery *search.CompiledQuery,
+		timeInterval search.TimestampInterval,
+	) (*ffi.LogEventView, int, int, error)
+	DeserializeNumericQueryMatchWithTimeInterval(
+		irBuf []byte,
+		numericQuery *search.NumericQuery,
+		timeInterval search.TimestampInterval,
+	) (*ffi.LogEventView, int, error)
+	CountMatches(
+		irBuf []byte,
+		compiledQuery *search.CompiledQuery,
+		counts *MatchCounts,
+	) (int, error)
 	TimestampInfo() TimestampInfo
+	Counters() (DeserializerCounters, bool)
 	Close() error
 }
 
+// DeserializerCounters is a snapshot of the work done by a Deserializer, for
+// finding where the time of a slow deserialization or search goes.
+// EventsDeserialized counts every log event read from the IR (including those
+// rejected by a search), and MessagesDecoded the log messages reconstructed
+// from them. While searching, EventsSkippedByTime counts the log events outside
+// the time interval, EventsRejectedByLogtype those ruled out without decoding
+// their log message, and MatcherInvocations the log messages matched against
+// the queries. BufferGrowths counts the reallocations of the Deserializer's
+// underlying storage.
+type DeserializerCounters struct {
+	EventsDeserialized      uint64
+	MessagesDecoded         uint64
+	BytesConsumed           uint64
+	EventsSkippedByTime     uint64
+	EventsRejectedByLogtype uint64
+	MatcherInvocations      uint64
+	BufferGrowths           uint64
+}
+
+// LogEventColumns holds a batch of log events as columns, laid out as the
+// buffers of an Apache Arrow record batch so that they can be handed to a
+// columnar engine without a copy per log event. Log event i has the timestamp
+// Timestamps[i] and the log message
+// MessageData[MessageOffsets[i]:MessageOffsets[i+1]], so MessageOffsets and
+// MessageData are the offsets and data buffers of an Arrow large_utf8 array
+// (MessageOffsets holds one more offset than there are log events, beginning
+// with 0). LogtypeIds and MatchingQueries are empty unless requested through
+// [LogEventColumnsOptions]. Every slice is a view of the Deserializer's
+// underlying memory, invalidated by the next call to the Deserializer.
+type LogEventColumns struct {
+	Timestamps      []ffi.EpochTimeMs
+	MessageOffsets  []int64
+	MessageData     []byte
+	LogtypeIds      []int64
+	MatchingQueries []int64
+}
+
+// Len returns the number of log events in the columns.
+func (columns *LogEventColumns) Len() int {
+	return len(columns.Timestamps)
+}
+
+// LogMessage returns a view of the log message of log event i.
+func (columns *LogEventColumns) LogMessage(i int) string {
+	begin := columns.MessageOffsets[i]
+	end := columns.MessageOffsets[i+1]
+	if begin == end {
+		return ""
+	}
+	return unsafe.String(&columns.MessageData[begin], end-begin)
+}
+
+// LogEventColumnsOptions selects the log events and optional columns of
+// [LogEventColumns]. If CompiledQuery is non-nil only the log events matching
+// one of its queries are included, and MatchingQueries holds the index of the
+// first query each log event matches. If LogtypeIds is set, LogtypeIds holds
+// an id of each log event's logtype: log events share an id if and only if
+// they share a logtype, with ids assigned from 0 in the order the Deserializer
+// first sees each logtype.
+type LogEventColumnsOptions struct {
+	CompiledQuery *search.CompiledQuery
+	LogtypeIds    bool
+}
+
+// MatchCounts is a count matrix of the log events matching each query of a
+// [search.CompiledQuery] per time bucket, added to by
+// [Deserializer].CountMatches. Bucket i covers the timestamps in
+// [Start + i*BucketWidth, Start + (i+1)*BucketWidth), and Counts[q*NumBuckets+i]
+// holds the number of log events in bucket i matching query q (a log event is
+// counted once for each query it matches).
+type MatchCounts struct {
+	Start       ffi.EpochTimeMs
+	BucketWidth ffi.EpochTimeMs
+	NumBuckets  int
+	Counts      []int64
+}
+
+// NewMatchCounts returns a zeroed MatchCounts for numQueries queries, with
+// numBuckets buckets of bucketWidth beginning at start.
+func NewMatchCounts(
+	numQueries int,
+	start ffi.EpochTimeMs,
+	bucketWidth ffi.EpochTimeMs,
+	numBuckets int,
+) *MatchCounts {
+	return &MatchCounts{
+		Start:       start,
+		BucketWidth: bucketWidth,
+		NumBuckets:  numBuckets,
+		Counts:      make([]int64, numQueries*numBuckets),
+	}
+}
+
+// Count returns the number of log events in bucket matching query.
+func (counts *MatchCounts) Count(query int, bucket int) int64 {
+	return counts.Counts[query*counts.NumBuckets+bucket]
+}
+
+// TimeInterval returns the time interval covered by the buckets.
+func (counts *MatchCounts) TimeInterval() search.TimestampInterval {
+	return search.TimestampInterval{
+		Lower: counts.Start,
+		Upper: counts.Start + counts.BucketWidth*ffi.EpochTimeMs(counts.NumBuckets),
+	}
+}
+
 // DeserializePreamble attempts to read an IR stream preamble from irBuf,
 // returning an Deserializer (of the correct stream encoding size), the position
 // read to in irBuf (the end of the preamble), and an error. Note the metadata
@@ -111,9 +244,15 @@ func DeserializePreamble(irBuf []byte) (Deserializer, int, error) {
 				*(*ffi.EpochTimeMs)(timestampCptr) = refTs
 			}
 		}
-		deserializer = &fourByteDeserializer{commonDeserializer{tsInfo, deserializerCptr}, refTs}
+		deserializer = &fourByteDeserializer{
+			commonDeserializer{tsInfo: tsInfo, cptr: deserializerCptr},
+			refTs,
+			timestampCptr,
+		}
 	} else {
-		deserializer = &eightByteDeserializer{commonDeserializer{tsInfo, deserializerCptr}}
+		deserializer = &eightByteDeserializer{
+			commonDeserializer{tsInfo: tsInfo, cptr: deserializerCptr},
+		}
 	}
 
 	return deserializer, int(pos), nil
@@ -124,9 +263,16 @@ func DeserializePreamble(irBuf []byte) (Deserializer, int, error) {
 // cptr holds a reference to the underlying C++ objected used as backing storage
 // for the Views returned by the deserializer. Close must be called to free this
 // underlying memory and failure to do so will result in a memory leak.
+// batchViews is reused across batch deserialization calls to receive the C
+// views of each log event in the batch, and parallelViews likewise for the
+// log events of parallel deserialization calls. columns holds the views of the
+// last batch deserialized into columns.
 type commonDeserializer struct {
-	tsInfo TimestampInfo
-	cptr   unsafe.Pointer
+	tsInfo        TimestampInfo
+	cptr          unsafe.Pointer
+	batchViews    []C.LogEventView
+	parallelViews []ffi.LogEventView
+	columns       LogEventColumns
 }
 
 // Close will delete the underlying C++ allocated memory used by the
@@ -144,6 +290,23 @@ func (deserializer commonDeserializer) TimestampInfo() TimestampInfo {
 	return deserializer.tsInfo
 }
 
+// Counters returns a snapshot of the Deserializer's counters and whether they
+// are maintained. Unless the native library is built with
+// CLP_FFI_GO_ENABLE_COUNTERS the counters are compiled out and are all 0.
+func (deserializer *commonDeserializer) Counters() (DeserializerCounters, bool) {
+	var counters C.DeserializerCounters
+	enabled := C.ir_deserializer_get_counters(deserializer.cptr, &counters)
+	return DeserializerCounters{
+		EventsDeserialized:      uint64(counters.m_events_deserialized),
+		MessagesDecoded:         uint64(counters.m_messages_decoded),
+		BytesConsumed:           uint64(counters.m_bytes_consumed),
+		EventsSkippedByTime:     uint64(counters.m_events_skipped_by_time),
+		EventsRejectedByLogtype: uint64(counters.m_events_rejected_by_logtype),
+		MatcherInvocations:      uint64(counters.m_matcher_invocations),
+		BufferGrowths:           uint64(counters.m_buffer_growths),
+	}, 0 != enabled
+}
+
 type eightByteDeserializer struct {
 	commonDeserializer
 }
@@ -161,16 +324,59 @@ func (deserializer *eightByteDeserializer) DeserializeLogEvent(
 	return deserializeLogEvent(deserializer, irBuf)
 }
 
+// DeserializeLogEventBatch attempts to read the next log events from the IR
+// stream in irBuf into events. Reading stops once events is full, at least
+// maxBytes of irBuf have been consumed (0 for no limit), or irBuf does not
+// contain another complete log event. It returns the number of log events read,
+// the position read to in irBuf (the end of the last log event read), and an
+// error. Every view in events is invalidated by the next call to the
+// Deserializer. On error returns:
+//   - 0 log events
+//   - 0 position
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+func (deserializer *eightByteDeserializer) DeserializeLogEventBatch(
+	irBuf []byte,
+	events []ffi.LogEventView,
+	maxBytes int,
+) (int, int, error) {
+	return deserializeLogEventBatch(deserializer, irBuf, events, maxBytes)
+}
+
+// DeserializeLogEventColumns attempts to read the next log events from the IR
+// stream in irBuf into [LogEventColumns]. Reading stops once the columns hold
+// maxEvents log events, at least maxBytes of irBuf have been consumed (0 for no
+// limit), or irBuf does not contain another complete log event. With a
+// CompiledQuery in options, log events may be consumed without any being
+// included. It returns the columns, the position read to in irBuf (the end of
+// the last log event read), and an error. The columns are invalidated by the
+// next call to the Deserializer. On error returns:
+//   - nil *LogEventColumns
+//   - 0 position
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+func (deserializer *eightByteDeserializer) DeserializeLogEventColumns(
+	irBuf []byte,
+	maxEvents int,
+	maxBytes int,
+	options LogEventColumnsOptions,
+) (*LogEventColumns, int, error) {
+	return deserializeLogEventColumns(deserializer, irBuf, maxEvents, maxBytes, options)
+}
+
 // DeserializeWildcardMatchWithTimeInterval attempts to read the next log event
 // from the IR stream in irBuf that matches mergedQuery within timeInterval. It
 // returns the deserialized [ffi.LogEventView], the position read to in irBuf
 // (the end of the log event in irBuf), the index of the matched query in
 // mergedQuery, and an error. On error returns:
 //   - nil *ffi.LogEventView
-//   - 0 position
+//   - 0 position, or the end of the log events consumed if err is
+//     [IncompleteIr] or [QueryNotFound]
 //   - -1 index
 //   - [IrError] error: CLP failed to successfully deserialize
 //   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval
 func (deserializer *eightByteDeserializer) DeserializeWildcardMatchWithTimeInterval(
 	irBuf []byte,
 	mergedQuery search.MergedWildcardQuery,
@@ -179,13 +385,89 @@ func (deserializer *eightByteDeserializer) DeserializeWildcardMatchWithTimeInter
 	return deserializeWildcardMatch(deserializer, irBuf, mergedQuery, timeInterval)
 }
 
+// DeserializeCompiledQueryMatchWithTimeInterval attempts to read the next log
+// event from the IR stream in irBuf that matches compiledQuery within
+// timeInterval. Unlike DeserializeWildcardMatchWithTimeInterval, the queries
+// are not processed again on each call. It returns the deserialized
+// [ffi.LogEventView], the position read to in irBuf (the end of the log event
+// in irBuf), the index of the matched query in compiledQuery, and an error. On
+// error returns:
+//   - nil *ffi.LogEventView
+//   - 0 position, or the end of the log events consumed if err is
+//     [IncompleteIr] or [QueryNotFound]
+//   - -1 index
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval
+//   - [CorruptedIr] error: compiledQuery is nil or closed
+func (deserializer *eightByteDeserializer) DeserializeCompiledQueryMatchWithTimeInterval(
+	irBuf []byte,
+	compiledQuery *search.CompiledQuery,
+	timeInterval search.TimestampInterval,
+) (*ffi.LogEventView, int, int, error) {
+	return deserializeCompiledQueryMatch(deserializer, irBuf, compiledQuery, timeInterval)
+}
+
+// DeserializeNumericQueryMatchWithTimeInterval attempts to read the next log
+// event from the IR stream in irBuf that matches numericQuery within
+// timeInterval. The query's predicates are evaluated on the encoded variables
+// of each log event, so only the matching log event's message is decoded. It
+// returns the deserialized [ffi.LogEventView], the position read to in irBuf
+// (the end of the log event in irBuf), and an error. On error returns:
+//   - nil *ffi.LogEventView
+//   - 0 position, or the end of the log events consumed if err is
+//     [IncompleteIr] or [QueryNotFound]
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval
+func (deserializer *eightByteDeserializer) DeserializeNumericQueryMatchWithTimeInterval(
+	irBuf []byte,
+	numericQuery *search.NumericQuery,
+	timeInterval search.TimestampInterval,
+) (*ffi.LogEventView, int, error) {
+	return deserializeNumericQueryMatch(deserializer, irBuf, numericQuery, timeInterval)
+}
+
+// CountMatches counts the log events of the IR stream in irBuf within the time
+// interval of counts that match each query in compiledQuery, adding them to
+// counts, without returning any log event to Go. Counting continues until the
+// end of irBuf (or of the stream), or the first log event after the time
+// interval, so a stream can be counted across several buffers by passing the
+// same counts. It returns the position read to in irBuf (the end of the log
+// events counted), and an error, which is always one of:
+//   - [IncompleteIr] error: irBuf ended (possibly part way through a log event)
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: a log event after the time interval was found,
+//     which is left unconsumed
+//   - [IrError] error: CLP failed to successfully deserialize, or
+//     [CorruptedIr] if compiledQuery is nil or closed (with a 0 position)
+func (deserializer *eightByteDeserializer) CountMatches(
+	irBuf []byte,
+	compiledQuery *search.CompiledQuery,
+	counts *MatchCounts,
+) (int, error) {
+	return countMatches(deserializer, irBuf, compiledQuery, counts)
+}
+
 // fourByteDeserializer contains both a common CLP IR deserializer and stores
 // the previously seen log event's timestamp. The previous timestamp is
 // necessary to calculate the current timestamp as four byte encoding only
 // encodes the timestamp delta between the current log event and the previous.
+// timestampCptr points to the previous timestamp stored by the underlying C++
+// deserializer, allowing it to be reset when seeking within the stream.
 type fourByteDeserializer struct {
 	commonDeserializer
 	prevTimestamp ffi.EpochTimeMs
+	timestampCptr unsafe.Pointer
+}
+
+// setPrevTimestamp sets the timestamp that the timestamp delta of the next log
+// event is relative to (e.g. after seeking to a [Checkpoint]).
+func (deserializer *fourByteDeserializer) setPrevTimestamp(timestamp ffi.EpochTimeMs) {
+	deserializer.prevTimestamp = timestamp
+	*(*ffi.EpochTimeMs)(deserializer.timestampCptr) = timestamp
 }
 
 // DeserializeLogEvent attempts to read the next log event from the IR stream in
@@ -201,16 +483,59 @@ func (deserializer *fourByteDeserializer) DeserializeLogEvent(
 	return deserializeLogEvent(deserializer, irBuf)
 }
 
+// DeserializeLogEventBatch attempts to read the next log events from the IR
+// stream in irBuf into events. Reading stops once events is full, at least
+// maxBytes of irBuf have been consumed (0 for no limit), or irBuf does not
+// contain another complete log event. It returns the number of log events read,
+// the position read to in irBuf (the end of the last log event read), and an
+// error. Every view in events is invalidated by the next call to the
+// Deserializer. On error returns:
+//   - 0 log events
+//   - 0 position
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+func (deserializer *fourByteDeserializer) DeserializeLogEventBatch(
+	irBuf []byte,
+	events []ffi.LogEventView,
+	maxBytes int,
+) (int, int, error) {
+	return deserializeLogEventBatch(deserializer, irBuf, events, maxBytes)
+}
+
+// DeserializeLogEventColumns attempts to read the next log events from the IR
+// stream in irBuf into [LogEventColumns]. Reading stops once the columns hold
+// maxEvents log events, at least maxBytes of irBuf have been consumed (0 for no
+// limit), or irBuf does not contain another complete log event. With a
+// CompiledQuery in options, log events may be consumed without any being
+// included. It returns the columns, the position read to in irBuf (the end of
+// the last log event read), and an error. The columns are invalidated by the
+// next call to the Deserializer. On error returns:
+//   - nil *LogEventColumns
+//   - 0 position
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+func (deserializer *fourByteDeserializer) DeserializeLogEventColumns(
+	irBuf []byte,
+	maxEvents int,
+	maxBytes int,
+	options LogEventColumnsOptions,
+) (*LogEventColumns, int, error) {
+	return deserializeLogEventColumns(deserializer, irBuf, maxEvents, maxBytes, options)
+}
+
 // DeserializeWildcardMatchWithTimeInterval attempts to read the next log event
 // from the IR stream in irBuf that matches mergedQuery within timeInterval. It
 // returns the deserialized [ffi.LogEventView], the position read to in irBuf
 // (the end of the log event in irBuf), the index of the matched query in
 // mergedQuery, and an error. On error returns:
 //   - nil *ffi.LogEventView
-//   - 0 position
+//   - 0 position, or the end of the log events consumed if err is
+//     [IncompleteIr] or [QueryNotFound]
 //   - -1 index
 //   - [IrError] error: CLP failed to successfully deserialize
 //   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval
 func (deserializer *fourByteDeserializer) DeserializeWildcardMatchWithTimeInterval(
 	irBuf []byte,
 	mergedQuery search.MergedWildcardQuery,
@@ -219,6 +544,72 @@ func (deserializer *fourByteDeserializer) DeserializeWildcardMatchWithTimeInterv
 	return deserializeWildcardMatch(deserializer, irBuf, mergedQuery, timeInterval)
 }
 
+// DeserializeCompiledQueryMatchWithTimeInterval attempts to read the next log
+// event from the IR stream in irBuf that matches compiledQuery within
+// timeInterval. Unlike DeserializeWildcardMatchWithTimeInterval, the queries
+// are not processed again on each call. It returns the deserialized
+// [ffi.LogEventView], the position read to in irBuf (the end of the log event
+// in irBuf), the index of the matched query in compiledQuery, and an error. On
+// error returns:
+//   - nil *ffi.LogEventView
+//   - 0 position, or the end of the log events consumed if err is
+//     [IncompleteIr] or [QueryNotFound]
+//   - -1 index
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval
+//   - [CorruptedIr] error: compiledQuery is nil or closed
+func (deserializer *fourByteDeserializer) DeserializeCompiledQueryMatchWithTimeInterval(
+	irBuf []byte,
+	compiledQuery *search.CompiledQuery,
+	timeInterval search.TimestampInterval,
+) (*ffi.LogEventView, int, int, error) {
+	return deserializeCompiledQueryMatch(deserializer, irBuf, compiledQuery, timeInterval)
+}
+
+// DeserializeNumericQueryMatchWithTimeInterval attempts to read the next log
+// event from the IR stream in irBuf that matches numericQuery within
+// timeInterval. The query's predicates are evaluated on the encoded variables
+// of each log event, so only the matching log event's message is decoded. It
+// returns the deserialized [ffi.LogEventView], the position read to in irBuf
+// (the end of the log event in irBuf), and an error. On error returns:
+//   - nil *ffi.LogEventView
+//   - 0 position, or the end of the log events consumed if err is
+//     [IncompleteIr] or [QueryNotFound]
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval
+func (deserializer *fourByteDeserializer) DeserializeNumericQueryMatchWithTimeInterval(
+	irBuf []byte,
+	numericQuery *search.NumericQuery,
+	timeInterval search.TimestampInterval,
+) (*ffi.LogEventView, int, error) {
+	return deserializeNumericQueryMatch(deserializer, irBuf, numericQuery, timeInterval)
+}
+
+// CountMatches counts the log events of the IR stream in irBuf within the time
+// interval of counts that match each query in compiledQuery, adding them to
+// counts, without returning any log event to Go. Counting continues until the
+// end of irBuf (or of the stream), or the first log event after the time
+// interval, so a stream can be counted across several buffers by passing the
+// same counts. It returns the position read to in irBuf (the end of the log
+// events counted), and an error, which is always one of:
+//   - [IncompleteIr] error: irBuf ended (possibly part way through a log event)
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: a log event after the time interval was found,
+//     which is left unconsumed
+//   - [IrError] error: CLP failed to successfully deserialize, or
+//     [CorruptedIr] if compiledQuery is nil or closed (with a 0 position)
+func (deserializer *fourByteDeserializer) CountMatches(
+	irBuf []byte,
+	compiledQuery *search.CompiledQuery,
+	counts *MatchCounts,
+) (int, error) {
+	return countMatches(deserializer, irBuf, compiledQuery, counts)
+}
+
 func deserializeLogEvent(
 	deserializer Deserializer,
 	irBuf []byte,
@@ -261,6 +652,257 @@ func deserializeLogEvent(
 		nil
 }
 
+func deserializeLogEventBatch(
+	deserializer Deserializer,
+	irBuf []byte,
+	events []ffi.LogEventView,
+	maxBytes int,
+) (int, int, error) {
+	if 0 >= len(irBuf) {
+		return 0, 0, IncompleteIr
+	}
+	if 0 >= len(events) {
+		return 0, 0, nil
+	}
+
+	var common *commonDeserializer
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		common = &irs.commonDeserializer
+	case *fourByteDeserializer:
+		common = &irs.commonDeserializer
+	}
+	if cap(common.batchViews) < len(events) {
+		common.batchViews = make([]C.LogEventView, len(events))
+	}
+	views := common.batchViews[:len(events)]
+	cViews := C.LogEventViewSpan{&views[0], C.size_t(len(views))}
+
+	var pos C.size_t
+	var numEvents C.size_t
+	var err error
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		err = IrError(C.ir_deserializer_deserialize_eight_byte_log_events_batch(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.size_t(maxBytes),
+			&pos,
+			cViews,
+			&numEvents,
+		))
+	case *fourByteDeserializer:
+		err = IrError(C.ir_deserializer_deserialize_four_byte_log_events_batch(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.size_t(maxBytes),
+			&pos,
+			cViews,
+			&numEvents,
+		))
+	}
+	if Success != err {
+		return 0, 0, err
+	}
+
+	for i, view := range views[:numEvents] {
+		events[i] = ffi.LogEventView{
+			LogMessageView: unsafe.String(
+				(*byte)((unsafe.Pointer)(view.m_log_message.m_data)),
+				view.m_log_message.m_size,
+			),
+			Timestamp: ffi.EpochTimeMs(view.m_timestamp),
+		}
+	}
+	return int(numEvents), int(pos), nil
+}
+
+func countMatches(
+	deserializer Deserializer,
+	irBuf []byte,
+	compiledQuery *search.CompiledQuery,
+	counts *MatchCounts,
+) (int, error) {
+	if 0 >= len(irBuf) {
+		return 0, IncompleteIr
+	}
+
+	timeInterval := counts.TimeInterval()
+	cTimeInterval := C.TimestampInterval{
+		C.int64_t(timeInterval.Lower),
+		C.int64_t(timeInterval.Upper),
+	}
+	var pos C.size_t
+	var err error
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		err = IrError(C.ir_deserializer_eight_byte_count_matches(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			cTimeInterval,
+			C.int64_t(counts.BucketWidth),
+			compiledQuery.Pointer(),
+			&pos,
+			newCInt64tSpan(counts.Counts),
+		))
+	case *fourByteDeserializer:
+		err = IrError(C.ir_deserializer_four_byte_count_matches(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			cTimeInterval,
+			C.int64_t(counts.BucketWidth),
+			compiledQuery.Pointer(),
+			&pos,
+			newCInt64tSpan(counts.Counts),
+		))
+	}
+	if IncompleteIr == err || EndOfIr == err || QueryNotFound == err {
+		return int(pos), err
+	}
+	return 0, err
+}
+
+func deserializeLogEventColumns(
+	deserializer Deserializer,
+	irBuf []byte,
+	maxEvents int,
+	maxBytes int,
+	options LogEventColumnsOptions,
+) (*LogEventColumns, int, error) {
+	if 0 >= len(irBuf) {
+		return nil, 0, IncompleteIr
+	}
+
+	var compiledQuery unsafe.Pointer
+	if nil != options.CompiledQuery {
+		compiledQuery = options.CompiledQuery.Pointer()
+	}
+	var pos C.size_t
+	var cColumns C.LogEventColumns
+	var common *commonDeserializer
+	var err error
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		common = &irs.commonDeserializer
+		err = IrError(C.ir_deserializer_deserialize_eight_byte_log_event_columns(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.size_t(max(maxEvents, 0)),
+			C.size_t(maxBytes),
+			compiledQuery,
+			C.bool(options.LogtypeIds),
+			&pos,
+			&cColumns,
+		))
+	case *fourByteDeserializer:
+		common = &irs.commonDeserializer
+		err = IrError(C.ir_deserializer_deserialize_four_byte_log_event_columns(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.size_t(max(maxEvents, 0)),
+			C.size_t(maxBytes),
+			compiledQuery,
+			C.bool(options.LogtypeIds),
+			&pos,
+			&cColumns,
+		))
+	}
+	if Success != err {
+		return nil, 0, err
+	}
+
+	common.columns = LogEventColumns{
+		Timestamps: unsafe.Slice(
+			(*ffi.EpochTimeMs)(unsafe.Pointer(cColumns.m_timestamps.m_data)),
+			cColumns.m_timestamps.m_size,
+		),
+		MessageOffsets: unsafe.Slice(
+			(*int64)(unsafe.Pointer(cColumns.m_message_offsets.m_data)),
+			cColumns.m_message_offsets.m_size,
+		),
+		MessageData: unsafe.Slice(
+			(*byte)(cColumns.m_message_data.m_data),
+			cColumns.m_message_data.m_size,
+		),
+		LogtypeIds: unsafe.Slice(
+			(*int64)(unsafe.Pointer(cColumns.m_logtype_ids.m_data)),
+			cColumns.m_logtype_ids.m_size,
+		),
+		MatchingQueries: unsafe.Slice(
+			(*int64)(unsafe.Pointer(cColumns.m_matching_queries.m_data)),
+			cColumns.m_matching_queries.m_size,
+		),
+	}
+	return &common.columns, int(pos), nil
+}
+
+// deserializeLogEventsParallel deserializes every complete log event in irBuf,
+// splitting it at chunkOffsets and deserializing the chunks in parallel on at
+// most as many C++ threads as the hardware supports. Each offset must be the
+// start of a log event and each timestamp in chunkTimestamps the timestamp
+// preceding it (see [Checkpoint]).
+// It returns the log events of every chunk up to the first to fail, the
+// position read to in irBuf (the end of the last log event), and an error.
+// Every view returned is invalidated by the next call to the Deserializer. On
+// error returns:
+//   - nil []ffi.LogEventView
+//   - 0 position
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+func deserializeLogEventsParallel(
+	deserializer Deserializer,
+	irBuf []byte,
+	chunkOffsets []int,
+	chunkTimestamps []int64,
+) ([]ffi.LogEventView, int, error) {
+	if 0 >= len(irBuf) {
+		return nil, 0, IncompleteIr
+	}
+
+	var pos C.size_t
+	var cViews C.LogEventViewSpan
+	var common *commonDeserializer
+	var err error
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		common = &irs.commonDeserializer
+		err = IrError(C.ir_deserializer_deserialize_eight_byte_log_events_parallel(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			newCSizetSpan(chunkOffsets),
+			newCInt64tSpan(chunkTimestamps),
+			&pos,
+			&cViews,
+		))
+	case *fourByteDeserializer:
+		common = &irs.commonDeserializer
+		err = IrError(C.ir_deserializer_deserialize_four_byte_log_events_parallel(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			newCSizetSpan(chunkOffsets),
+			newCInt64tSpan(chunkTimestamps),
+			&pos,
+			&cViews,
+		))
+	}
+	if Success != err {
+		return nil, 0, err
+	}
+
+	views := unsafe.Slice(cViews.m_data, cViews.m_size)
+	common.parallelViews = common.parallelViews[:0]
+	for _, view := range views {
+		common.parallelViews = append(common.parallelViews, ffi.LogEventView{
+			LogMessageView: unsafe.String(
+				(*byte)((unsafe.Pointer)(view.m_log_message.m_data)),
+				view.m_log_message.m_size,
+			),
+			Timestamp: ffi.EpochTimeMs(view.m_timestamp),
+		})
+	}
+	return common.parallelViews, int(pos), nil
+}
+
 func deserializeWildcardMatch(
 	deserializer Deserializer,
 	irBuf []byte,
@@ -297,6 +939,10 @@ func deserializeWildcardMatch(
 			&match,
 		))
 	}
+	if IncompleteIr == err || QueryNotFound == err {
+		// The log events before pos were consumed without a match.
+		return nil, int(pos), -1, err
+	}
 	if Success != err {
 		return nil, 0, -1, err
 	}
@@ -312,3 +958,111 @@ func deserializeWildcardMatch(
 		int(match),
 		nil
 }
+
+func deserializeCompiledQueryMatch(
+	deserializer Deserializer,
+	irBuf []byte,
+	compiledQuery *search.CompiledQuery,
+	time search.TimestampInterval,
+) (*ffi.LogEventView, int, int, error) {
+	if 0 >= len(irBuf) {
+		return nil, 0, -1, IncompleteIr
+	}
+
+	var pos C.size_t
+	var event C.LogEventView
+	var match C.size_t
+	var err error
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		err = IrError(C.ir_deserializer_deserialize_eight_byte_compiled_query_match(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.TimestampInterval{C.int64_t(time.Lower), C.int64_t(time.Upper)},
+			compiledQuery.Pointer(),
+			&pos,
+			&event,
+			&match,
+		))
+	case *fourByteDeserializer:
+		err = IrError(C.ir_deserializer_deserialize_four_byte_compiled_query_match(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.TimestampInterval{C.int64_t(time.Lower), C.int64_t(time.Upper)},
+			compiledQuery.Pointer(),
+			&pos,
+			&event,
+			&match,
+		))
+	}
+	if IncompleteIr == err || QueryNotFound == err {
+		// The log events before pos were consumed without a match.
+		return nil, int(pos), -1, err
+	}
+	if Success != err {
+		return nil, 0, -1, err
+	}
+
+	return &ffi.LogEventView{
+			LogMessageView: unsafe.String(
+				(*byte)((unsafe.Pointer)(event.m_log_message.m_data)),
+				event.m_log_message.m_size,
+			),
+			Timestamp: ffi.EpochTimeMs(event.m_timestamp),
+		},
+		int(pos),
+		int(match),
+		nil
+}
+
+func deserializeNumericQueryMatch(
+	deserializer Deserializer,
+	irBuf []byte,
+	numericQuery *search.NumericQuery,
+	time search.TimestampInterval,
+) (*ffi.LogEventView, int, error) {
+	if 0 >= len(irBuf) {
+		return nil, 0, IncompleteIr
+	}
+
+	var pos C.size_t
+	var event C.LogEventView
+	var err error
+	switch irs := deserializer.(type) {
+	case *eightByteDeserializer:
+		err = IrError(C.ir_deserializer_deserialize_eight_byte_numeric_query_match(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.TimestampInterval{C.int64_t(time.Lower), C.int64_t(time.Upper)},
+			numericQuery.Pointer(),
+			&pos,
+			&event,
+		))
+	case *fourByteDeserializer:
+		err = IrError(C.ir_deserializer_deserialize_four_byte_numeric_query_match(
+			newCByteSpan(irBuf),
+			irs.cptr,
+			C.TimestampInterval{C.int64_t(time.Lower), C.int64_t(time.Upper)},
+			numericQuery.Pointer(),
+			&pos,
+			&event,
+		))
+	}
+	if IncompleteIr == err || QueryNotFound == err {
+		// The log events before pos were consumed without a match.
+		return nil, int(pos), err
+	}
+	if Success != err {
+		return nil, 0, err
+	}
+
+	return &ffi.LogEventView{
+			LogMessageView: unsafe.String(
+				(*byte)((unsafe.Pointer)(event.m_log_message.m_data)),
+				event.m_log_message.m_size,
+			),
+			Timestamp: ffi.EpochTimeMs(event.m_timestamp),
+		},
+		int(pos),
+		nil
+}
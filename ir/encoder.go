@@ -21,16 +21,23 @@ type Encoder[T EightByteEncoding | FourByteEncoding] interface {
 
 // Return a new Encoder that produces IR using [EightByteEncoding].
 func EightByteEncoder() (Encoder[EightByteEncoding], error) {
-	return &eightByteEncoder{C.ir_encoder_eight_byte_new()}, nil
+	return &eightByteEncoder{cptr: C.ir_encoder_eight_byte_new()}, nil
 }
 
 // Return a new Encoder that produces IR using [FourByteEncoding].
 func FourByteEncoder() (Encoder[FourByteEncoding], error) {
-	return &fourByteEncoder{C.ir_encoder_four_byte_new()}, nil
+	return &fourByteEncoder{cptr: C.ir_encoder_four_byte_new()}, nil
 }
 
 type eightByteEncoder struct {
 	cptr unsafe.Pointer
+	// Kept in the struct, rather than as locals, so the values passed to C++
+	// by pointer don't need a heap allocation per call.
+	logtype           C.StringView
+	vars              C.Int64tSpan
+	dictVars          C.StringView
+	dictVarEndOffsets C.Int32tSpan
+	view              LogMessageView[EightByteEncoding]
 }
 
 // Close will delete the underlying C++ allocated memory used by the
@@ -44,29 +51,39 @@ func (encoder *eightByteEncoder) Close() error {
 }
 
 // Encode a log message into CLP IR, returning a view of the encoded message.
+// The view is reused (and overwritten) by the next call.
 func (encoder *eightByteEncoder) EncodeLogMessage(
 	logMessage ffi.LogMessage,
 ) (*LogMessageView[EightByteEncoding], error) {
-	var logtype C.StringView
-	var vars C.Int64tSpan
-	var dictVars C.StringView
-	var dictVarEndOffsets C.Int32tSpan
 	err := IrError(C.ir_encoder_encode_eight_byte_log_message(
 		newCStringView(logMessage),
 		encoder.cptr,
-		&logtype,
-		&vars,
-		&dictVars,
-		&dictVarEndOffsets,
+		&encoder.logtype,
+		&encoder.vars,
+		&encoder.dictVars,
+		&encoder.dictVarEndOffsets,
 	))
 	if Success != err {
 		return nil, EncodeError
 	}
-	return newLogMessageView[EightByteEncoding](logtype, vars, dictVars, dictVarEndOffsets), nil
+	return setLogMessageView(
+		&encoder.view,
+		encoder.logtype,
+		encoder.vars,
+		encoder.dictVars,
+		encoder.dictVarEndOffsets,
+	), nil
 }
 
 type fourByteEncoder struct {
 	cptr unsafe.Pointer
+	// Kept in the struct, rather than as locals, so the values passed to C++
+	// by pointer don't need a heap allocation per call.
+	logtype           C.StringView
+	vars              C.Int32tSpan
+	dictVars          C.StringView
+	dictVarEndOffsets C.Int32tSpan
+	view              LogMessageView[FourByteEncoding]
 }
 
 // Close will delete the underlying C++ allocated memory used by the
@@ -80,23 +97,26 @@ func (encoder *fourByteEncoder) Close() error {
 }
 
 // Encode a log message into CLP IR, returning a view of the encoded message.
+// The view is reused (and overwritten) by the next call.
 func (encoder *fourByteEncoder) EncodeLogMessage(
 	logMessage ffi.LogMessage,
 ) (*LogMessageView[FourByteEncoding], error) {
-	var logtype C.StringView
-	var vars C.Int32tSpan
-	var dictVars C.StringView
-	var dictVarEndOffsets C.Int32tSpan
 	err := IrError(C.ir_encoder_encode_four_byte_log_message(
 		newCStringView(logMessage),
 		encoder.cptr,
-		&logtype,
-		&vars,
-		&dictVars,
-		&dictVarEndOffsets,
+		&encoder.logtype,
+		&encoder.vars,
+		&encoder.dictVars,
+		&encoder.dictVarEndOffsets,
 	))
 	if Success != err {
 		return nil, EncodeError
 	}
-	return newLogMessageView[FourByteEncoding](logtype, vars, dictVars, dictVarEndOffsets), nil
+	return setLogMessageView(
+		&encoder.view,
+		encoder.logtype,
+		encoder.vars,
+		encoder.dictVars,
+		encoder.dictVarEndOffsets,
+	), nil
 }
@@ -0,0 +1,124 @@
+package ir
+
+import (
+	"fmt"
+	"strings"
+	"testing"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+)
+
+// Builds a log message with numDictVars dictionary variables, each followed by
+// an encoded integer variable.
+func dictVarLogMessage(id int, numDictVars int) ffi.LogMessage {
+	var msg strings.Builder
+	fmt.Fprintf(&msg, "request %v:", id)
+	for i := 0; i < numDictVars; i++ {
+		fmt.Fprintf(&msg, " user_%v/host_%v took %v", id, i, i)
+	}
+	return msg.String()
+}
+
+func TestEncoderReuse(t *testing.T) {
+	encoder, _ := EightByteEncoder()
+	defer encoder.Close()
+	decoder, _ := EightByteDecoder()
+	defer decoder.Close()
+	for i := 0; i < 64; i++ {
+		msg := dictVarLogMessage(i, i%8)
+		irMsg, err := encoder.EncodeLogMessage(msg)
+		if nil != err {
+			t.Fatalf("Encoder.EncodeLogMessage failed: %v", err)
+		}
+		if len(irMsg.DictVarEndOffsets) != i%8 {
+			t.Fatalf(
+				"Encoder.EncodeLogMessage dictionary variables: %v != %v",
+				len(irMsg.DictVarEndOffsets),
+				i%8,
+			)
+		}
+		decoded, err := decoder.DecodeLogMessage(irMsg.LogMessage)
+		if nil != err {
+			t.Fatalf("Decoder.DecodeLogMessage failed: %v", err)
+		}
+		if msg != *decoded {
+			t.Fatalf("Encoder round trip: '%v' != '%v'", *decoded, msg)
+		}
+	}
+}
+
+// Log messages with numeric variables at the limits of what each encoding
+// encodes (rather than storing as dictionary variables), which the native
+// decoder formats without going through CLP's string conversions.
+var numericLogMessages = []ffi.LogMessage{
+	"int 0 -1 9 10 99 100 -100 1234567890 -2147483648 2147483647",
+	"int -9223372036854775808 9223372036854775807 -99999999999 10000000000",
+	"float 0.0 -0.5 .5 -.5 1.25 -12.5000 0.0000001 33554431.0 -3355443.1",
+	"float 123456789012.3456 -9.999999999999999 9999999999999999.0 0.000000000000001",
+	"mixed id=42 ratio=0.75 temp=-3.2 count=2147483647 version=1.0.3 ip=10.0.0.1",
+}
+
+func testNumericRoundTrip[T EightByteEncoding | FourByteEncoding](
+	t *testing.T,
+	encoder Encoder[T],
+	decoder Decoder[T],
+) {
+	for _, msg := range numericLogMessages {
+		irMsg, err := encoder.EncodeLogMessage(msg)
+		if nil != err {
+			t.Fatalf("Encoder.EncodeLogMessage failed: %v", err)
+		}
+		decoded, err := decoder.DecodeLogMessage(irMsg.LogMessage)
+		if nil != err {
+			t.Fatalf("Decoder.DecodeLogMessage failed: %v", err)
+		}
+		if msg != *decoded {
+			t.Fatalf("Encoder round trip: '%v' != '%v'", *decoded, msg)
+		}
+	}
+}
+
+func TestEncoderNumericVars(t *testing.T) {
+	eightByteEncoder, _ := EightByteEncoder()
+	defer eightByteEncoder.Close()
+	eightByteDecoder, _ := EightByteDecoder()
+	defer eightByteDecoder.Close()
+	testNumericRoundTrip(t, eightByteEncoder, eightByteDecoder)
+
+	fourByteEncoder, _ := FourByteEncoder()
+	defer fourByteEncoder.Close()
+	fourByteDecoder, _ := FourByteDecoder()
+	defer fourByteDecoder.Close()
+	testNumericRoundTrip(t, fourByteEncoder, fourByteDecoder)
+}
+
+func BenchmarkEncodeLogMessage(b *testing.B) {
+	for _, numDictVars := range []int{1, 16, 256} {
+		msg := dictVarLogMessage(0, numDictVars)
+		b.Run(fmt.Sprintf("EightByte/DictVars=%v", numDictVars), func(b *testing.B) {
+			encoder, _ := EightByteEncoder()
+			defer encoder.Close()
+			benchmarkEncodeLogMessage(b, encoder, msg)
+		})
+		b.Run(fmt.Sprintf("FourByte/DictVars=%v", numDictVars), func(b *testing.B) {
+			encoder, _ := FourByteEncoder()
+			defer encoder.Close()
+			benchmarkEncodeLogMessage(b, encoder, msg)
+		})
+	}
+}
+
+func benchmarkEncodeLogMessage[T EightByteEncoding | FourByteEncoding](
+	b *testing.B,
+	encoder Encoder[T],
+	msg ffi.LogMessage,
+) {
+	b.ReportAllocs()
+	b.SetBytes(int64(len(msg)))
+	for i := 0; i < b.N; i++ {
+		if _, err := encoder.EncodeLogMessage(msg); nil != err {
+			b.Fatalf("Encoder.EncodeLogMessage failed: %v", err)
+		}
+	}
+	reportEventRate(b, 1)
+}
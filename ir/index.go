@@ -0,0 +1,141 @@
+package ir
+
+import (
+	"encoding/binary"
+	"errors"
+	"io"
+	"sort"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+)
+
+// indexMagic begins every serialized [Index], followed by the format version.
+var indexMagic = [4]byte{'C', 'L', 'P', 'X'}
+
+const indexVersion uint32 = 1
+
+var (
+	// ErrInvalidIndex is returned by [ReadIndex] for data that is not a
+	// serialized [Index] (of a supported version).
+	ErrInvalidIndex = errors.New("ir: invalid index")
+	// ErrUnseekable is returned by [Reader.SeekToTime] if the Reader's source
+	// cannot seek.
+	ErrUnseekable = errors.New("ir: reader source is not seekable")
+)
+
+// A Checkpoint marks the position of a log event in a CLP IR stream that a
+// [Reader] can seek to and resume deserializing from.
+type Checkpoint struct {
+	// Timestamp is the greatest timestamp of all log events before Offset, so
+	// that every log event with a greater timestamp is at or after Offset.
+	Timestamp ffi.EpochTimeMs
+	// Offset is the position of the log event from the start of the stream
+	// (the start of the preamble).
+	Offset int64
+	// ReferenceTimestamp is the timestamp of the log event before Offset (or
+	// the preamble's reference timestamp), to which the timestamp delta of the
+	// log event at Offset is relative in a four byte encoded stream.
+	ReferenceTimestamp ffi.EpochTimeMs
+}
+
+// An Index is a sparse list of checkpoints into a CLP IR stream, in stream
+// order. It is built by a [Writer] (see [Writer.EnableIndex]) and stored
+// alongside the stream, allowing a [Reader] to seek to a time without
+// deserializing every log event before it (see [Reader.SeekToTime]).
+type Index struct {
+	Checkpoints []Checkpoint
+}
+
+// ReadIndex reads an [Index] previously written by [Index.WriteTo] from r.
+// Returns:
+//   - success: valid [*Index], nil
+//   - error: nil [*Index], [ErrInvalidIndex] or error propagated from
+//     [encoding/binary.Read]
+func ReadIndex(r io.Reader) (*Index, error) {
+	var header struct {
+		Magic          [4]byte
+		Version        uint32
+		NumCheckpoints uint64
+	}
+	if err := binary.Read(r, binary.LittleEndian, &header); nil != err {
+		return nil, err
+	}
+	if indexMagic != header.Magic || indexVersion != header.Version {
+		return nil, ErrInvalidIndex
+	}
+	index := &Index{}
+	for i := uint64(0); i < header.NumCheckpoints; i++ {
+		var checkpoint Checkpoint
+		if err := binary.Read(r, binary.LittleEndian, &checkpoint); nil != err {
+			return nil, err
+		}
+		index.Checkpoints = append(index.Checkpoints, checkpoint)
+	}
+	return index, nil
+}
+
+// WriteTo writes the serialized Index to w. Returns:
+//   - success: number of bytes written, nil
+//   - error: number of bytes written, error propagated from [io.Writer.Write]
+func (index *Index) WriteTo(w io.Writer) (int64, error) {
+	buf := make([]byte, 0, 16+len(index.Checkpoints)*24)
+	buf = append(buf, indexMagic[:]...)
+	buf = binary.LittleEndian.AppendUint32(buf, indexVersion)
+	buf = binary.LittleEndian.AppendUint64(buf, uint64(len(index.Checkpoints)))
+	for _, checkpoint := range index.Checkpoints {
+		buf = binary.LittleEndian.AppendUint64(buf, uint64(checkpoint.Timestamp))
+		buf = binary.LittleEndian.AppendUint64(buf, uint64(checkpoint.Offset))
+		buf = binary.LittleEndian.AppendUint64(buf, uint64(checkpoint.ReferenceTimestamp))
+	}
+	n, err := w.Write(buf)
+	return int64(n), err
+}
+
+// Find returns the last checkpoint that all log events with a timestamp
+// greater than or equal to time are at or after, and true. If there is no such
+// checkpoint, false is returned.
+func (index *Index) Find(time ffi.EpochTimeMs) (Checkpoint, bool) {
+	// Checkpoint timestamps are non-decreasing as each is the greatest
+	// timestamp of all log events before it.
+	i := sort.Search(len(index.Checkpoints), func(i int) bool {
+		return index.Checkpoints[i].Timestamp >= time
+	})
+	if 0 == i {
+		return Checkpoint{}, false
+	}
+	return index.Checkpoints[i-1], true
+}
+
+// indexBuilder records the checkpoints of a stream as it is written.
+// lastCheckpoint is the offset of the last checkpoint (or the end of the
+// preamble), and maxTimestamp and lastTimestamp are the greatest and last
+// timestamp of the log events written so far.
+type indexBuilder struct {
+	index          Index
+	interval       int64
+	lastCheckpoint int64
+	maxTimestamp   ffi.EpochTimeMs
+	lastTimestamp  ffi.EpochTimeMs
+}
+
+// checkpoint records a checkpoint at offset if at least interval bytes have
+// been written since the last checkpoint.
+func (builder *indexBuilder) checkpoint(offset int64) {
+	if offset-builder.lastCheckpoint < builder.interval {
+		return
+	}
+	builder.index.Checkpoints = append(builder.index.Checkpoints, Checkpoint{
+		Timestamp:          builder.maxTimestamp,
+		Offset:             offset,
+		ReferenceTimestamp: builder.lastTimestamp,
+	})
+	builder.lastCheckpoint = offset
+}
+
+// add records the timestamps of log events written after the last checkpoint.
+func (builder *indexBuilder) add(events ...ffi.LogEvent) {
+	for _, event := range events {
+		builder.maxTimestamp = max(builder.maxTimestamp, event.Timestamp)
+		builder.lastTimestamp = event.Timestamp
+	}
+}
@@ -159,6 +159,33 @@ func testLogMessages(t *testing.T, messages []ffi.LogMessage) {
 			func(t *testing.T) { t.Parallel(); testWriteReadLogMessages(t, args, messages) },
 		)
 	}
+	for _, args := range generateTestArgs(t, t.Name()+"-WriteReadBatch") {
+		args := args // capture range variable for func literal
+		t.Run(
+			args.name,
+			func(t *testing.T) { t.Parallel(); testWriteReadBatchLogMessages(t, args, messages) },
+		)
+	}
+	for _, args := range generateTestArgs(t, t.Name()+"-WriteReadMmap") {
+		if noCompression != args.compression {
+			continue
+		}
+		args := args // capture range variable for func literal
+		t.Run(
+			args.name,
+			func(t *testing.T) { t.Parallel(); testWriteReadMmapLogMessages(t, args, messages) },
+		)
+	}
+	for _, args := range generateTestArgs(t, t.Name()+"-WriteReadZstd") {
+		if zstdCompression != args.compression {
+			continue
+		}
+		args := args // capture range variable for func literal
+		t.Run(
+			args.name,
+			func(t *testing.T) { t.Parallel(); testWriteReadZstdLogMessages(t, args, messages) },
+		)
+	}
 }
 
 func openIoReader(t *testing.T, args testArgs) io.ReadCloser {
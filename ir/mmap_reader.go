@@ -0,0 +1,22 @@
+package ir
+
+import (
+	"errors"
+)
+
+// ErrMmapUnsupported is returned by [NewMmapReaderPrefetch] on platforms where
+// the mmap backed Reader isn't supported (currently every platform but linux).
+var ErrMmapUnsupported = errors.New("ir: mmap backed Reader is unsupported on this platform")
+
+// mmapFile tracks the state of a [Reader] whose buffer is a memory mapped file.
+// prefetchedTo is the end of the region of the file that the kernel has been
+// advised to read ahead.
+type mmapFile struct {
+	prefetchSize int
+	prefetchedTo int
+}
+
+// NewMmapReader returns [NewMmapReaderPrefetch] without prefetching.
+func NewMmapReader(path string) (*Reader, error) {
+	return NewMmapReaderPrefetch(path, 0)
+}
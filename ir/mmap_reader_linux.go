@@ -0,0 +1,88 @@
+//go:build linux
+
+package ir
+
+import (
+	"os"
+	"syscall"
+)
+
+// NewMmapReaderPrefetch creates a new [Reader] backed by the memory mapped,
+// uncompressed CLP IR file at path, and uses [DeserializePreamble] to read its
+// preamble. Unlike [NewReaderSize], the Reader's buffer is the mapped file
+// itself, so IR is deserialized in place without being copied and the buffer
+// never grows. The kernel is advised that the file will be accessed
+// sequentially, and if prefetchSize is positive, to read ahead the next
+// prefetchSize bytes of the file as the Reader consumes it. If the file ends
+// part way through a log event, reading returns [io.ErrUnexpectedEOF]. Close
+// must be called to unmap the file. Returns:
+//   - success: valid [*Reader], nil
+//   - error: nil [*Reader], error propagated from [os.Open], [syscall.Mmap], or
+//     [DeserializePreamble]
+func NewMmapReaderPrefetch(path string, prefetchSize int) (*Reader, error) {
+	file, err := os.Open(path)
+	if nil != err {
+		return nil, err
+	}
+	// The mapping remains valid after the file is closed.
+	defer file.Close()
+	info, err := file.Stat()
+	if nil != err {
+		return nil, err
+	}
+	if 0 >= info.Size() {
+		return nil, IncompleteIr
+	}
+	buf, err := syscall.Mmap(
+		int(file.Fd()),
+		0,
+		int(info.Size()),
+		syscall.PROT_READ,
+		syscall.MAP_SHARED,
+	)
+	if nil != err {
+		return nil, err
+	}
+	// Advice is only a hint, so failing to apply it is not an error.
+	_ = syscall.Madvise(buf, syscall.MADV_SEQUENTIAL)
+
+	irr := &Reader{
+		Deserializer: nil,
+		ioReader:     nil,
+		buf:          buf,
+		end:          len(buf),
+		mmap:         &mmapFile{prefetchSize: prefetchSize},
+	}
+	irr.Deserializer, irr.start, err = DeserializePreamble(buf)
+	if nil != err {
+		_ = syscall.Munmap(buf)
+		return nil, err
+	}
+	irr.mmap.prefetch(irr.buf, irr.start)
+	return irr, nil
+}
+
+// prefetch advises the kernel to read ahead the next prefetchSize bytes of buf
+// once pos is within half of prefetchSize from the end of the region already
+// prefetched.
+func (mf *mmapFile) prefetch(buf []byte, pos int) {
+	if 0 >= mf.prefetchSize || len(buf) <= mf.prefetchedTo ||
+		pos+mf.prefetchSize/2 < mf.prefetchedTo {
+		return
+	}
+	// madvise requires a page aligned address.
+	start := max(pos, mf.prefetchedTo) &^ (syscall.Getpagesize() - 1)
+	end := min(start+mf.prefetchSize, len(buf))
+	_ = syscall.Madvise(buf[start:end], syscall.MADV_WILLNEED)
+	mf.prefetchedTo = end
+}
+
+// unmap unmaps the file of a Reader created by [NewMmapReader].
+func (reader *Reader) unmap() error {
+	err := syscall.Munmap(reader.buf)
+	reader.buf = nil
+	reader.start = 0
+	reader.end = 0
+	reader.mmap = nil
+	return err
+}
@@ -0,0 +1,17 @@
+//go:build !linux
+
+package ir
+
+// NewMmapReaderPrefetch creates a new [Reader] backed by a memory mapped CLP IR
+// file on linux (see mmap_reader_linux.go). On other platforms it always
+// returns:
+//   - nil [*Reader], [ErrMmapUnsupported]
+func NewMmapReaderPrefetch(path string, prefetchSize int) (*Reader, error) {
+	return nil, ErrMmapUnsupported
+}
+
+// prefetch is never called, as a Reader is never memory mapped.
+func (mf *mmapFile) prefetch(buf []byte, pos int) {}
+
+// unmap is never called, as a Reader is never memory mapped.
+func (reader *Reader) unmap() error { return nil }
@@ -1,39 +1,72 @@
 package ir
 
 import (
+	"errors"
 	"io"
 	"math"
+	"runtime"
+	"slices"
+	"sort"
 	"strings"
 
 	"github.com/y-scope/clp-ffi-go/ffi"
 	"github.com/y-scope/clp-ffi-go/search"
 )
 
+// ErrBufferFull is returned by a [Reader] whose buffer has grown to the
+// maximum size set by [Reader.SetMaxBufferSize] without holding a complete log
+// event.
+var ErrBufferFull = errors.New("ir: log event exceeds the Reader's maximum buffer size")
+
 // Reader abstracts maintenance of a buffer containing a [Deserializer]. It
 // keeps track of the range [start, end) in the buffer containing valid,
 // unconsumed CLP IR. [NewReader] will construct a Reader with the appropriate
 // Deserializer based on the consumed CLP IR preamble. The buffer will grow if
 // it is not large enough to service a read call (e.g. it cannot hold the next
-// log event in the IR). Close must be called to free the underlying memory and
-// failure to do so will result in a memory leak.
+// log event in the IR), up to maxSize if set, and shrinks back to its initial
+// size once the large log event is consumed. Close must be called to free the
+// underlying memory and failure to do so will result in a memory leak.
 type Reader struct {
 	Deserializer
 	ioReader io.Reader
 	buf      []byte
 	start    int
 	end      int
+	// size is the initial size of buf, and maxSize the size buf can grow to (0
+	// for no limit).
+	size    int
+	maxSize int
+	// mmap is non-nil if buf is a memory mapped file (see NewMmapReader).
+	mmap *mmapFile
+	// zstd is non-nil if ioReader decompresses a zstd compressed stream (see
+	// NewZstdReader).
+	zstd *zstdDecompressor
+	// streamStart is the position of the start of the IR stream in ioReader,
+	// if ioReader is an io.Seeker.
+	streamStart int64
+	// queries and their merged form from the last call to
+	// ReadToWildcardMatchWithTimeInterval, so that repeatedly searching with
+	// the same queries does not merge them again on every call.
+	queries     []search.WildcardQuery
+	mergedQuery search.MergedWildcardQuery
 }
 
 // NewReaderSize creates a new [Reader] and uses [DeserializePreamble] to read a
 // CLP IR preamble from the [io.Reader], r. size denotes the initial size to use
 // for the Reader's buffer that the io.Reader is read into. This buffer will
-// grow if it is too small to contain the preamble or next log event. Returns:
+// grow if it is too small to contain the preamble or next log event (see
+// [Reader.SetMaxBufferSize]). Returns:
 //   - success: valid [*Reader], nil
 //   - error: nil [*Reader], error propagated from [DeserializePreamble] or
 //     [io.Reader.Read]
 func NewReaderSize(r io.Reader, size int) (*Reader, error) {
-	irr := &Reader{nil, r, make([]byte, size), 0, 0}
+	irr := &Reader{Deserializer: nil, ioReader: r, buf: make([]byte, size), size: size}
 	var err error
+	if seeker, ok := r.(io.Seeker); ok {
+		if irr.streamStart, err = seeker.Seek(0, io.SeekCurrent); nil != err {
+			return nil, err
+		}
+	}
 	if _, err = irr.read(); nil != err {
 		return nil, err
 	}
@@ -57,10 +90,31 @@ func NewReader(r io.Reader) (*Reader, error) {
 	return NewReaderSize(r, 1024*1024)
 }
 
+// SetMaxBufferSize limits the size the Reader's buffer can grow to when a log
+// event doesn't fit in it, so that a stream with an oversized (e.g. corrupt or
+// malicious) log event can't make the Reader allocate without bound. Reading a
+// log event that doesn't fit in maxSize bytes returns [ErrBufferFull]. A
+// maxSize of 0 (the default) lets the buffer grow without limit. The buffer of
+// a Reader created by [NewMmapReader] never grows.
+func (reader *Reader) SetMaxBufferSize(maxSize int) {
+	reader.maxSize = maxSize
+}
+
 // Close will delete the underlying C++ allocated memory used by the
-// deserializer. Failure to call Close will result in a memory leak.
+// deserializer and the decompression stream of a Reader created by
+// [NewZstdReader], and unmap the file of a Reader created by [NewMmapReader].
+// Failure to call Close will result in a memory leak.
 func (reader *Reader) Close() error {
-	return reader.Deserializer.Close()
+	err := reader.Deserializer.Close()
+	if nil != reader.zstd {
+		reader.zstd.Close()
+	}
+	if nil != reader.mmap {
+		if unmapErr := reader.unmap(); nil == err {
+			err = unmapErr
+		}
+	}
+	return err
 }
 
 // Read uses [Deserializer].DeserializeLogEvent to read from the CLP IR byte stream. The
@@ -83,10 +137,112 @@ func (reader *Reader) Read() (*ffi.LogEventView, error) {
 	if nil != err {
 		return nil, err
 	}
-	reader.start += pos
+	reader.advance(pos)
 	return event, nil
 }
 
+// ReadBatch uses [Deserializer].DeserializeLogEventBatch to read up to
+// len(events) log events from the CLP IR byte stream into events, crossing
+// into C++ once for the entire batch rather than once per log event. The
+// underlying buffer will grow if it is too small to contain the next log event.
+// Every view in events remains valid only until the next read call on the
+// Reader. Returns:
+//   - success: number of log events read (at least 1 if len(events) > 0), nil
+//   - error: 0, error propagated from [Deserializer].DeserializeLogEventBatch or
+//     [io.Reader.Read]
+func (reader *Reader) ReadBatch(events []ffi.LogEventView) (int, error) {
+	var numEvents int
+	var pos int
+	var err error
+	for {
+		numEvents, pos, err = reader.DeserializeLogEventBatch(
+			reader.buf[reader.start:reader.end],
+			events,
+			0,
+		)
+		if IncompleteIr != err {
+			break
+		}
+		if _, err = reader.fillBuf(); nil != err {
+			break
+		}
+	}
+	if nil != err {
+		return 0, err
+	}
+	reader.advance(pos)
+	return numEvents, nil
+}
+
+// ReadColumns uses [Deserializer].DeserializeLogEventColumns to read up to
+// maxEvents log events from the CLP IR byte stream into [LogEventColumns],
+// crossing into C++ once for the entire batch. With a CompiledQuery in options
+// it reads until finding at least one matching log event. The underlying
+// buffer will grow if it is too small to contain the next log event. The
+// columns remain valid only until the next read call on the Reader. Returns:
+//   - success: columns (holding at least 1 log event if maxEvents > 0), nil
+//   - error: nil, error propagated from
+//     [Deserializer].DeserializeLogEventColumns or [io.Reader.Read]
+func (reader *Reader) ReadColumns(
+	maxEvents int,
+	options LogEventColumnsOptions,
+) (*LogEventColumns, error) {
+	for {
+		columns, pos, err := reader.DeserializeLogEventColumns(
+			reader.buf[reader.start:reader.end],
+			maxEvents,
+			0,
+			options,
+		)
+		if IncompleteIr == err {
+			if _, err = reader.fillBuf(); nil != err {
+				return nil, err
+			}
+			continue
+		}
+		if nil != err {
+			return nil, err
+		}
+		reader.advance(pos)
+		// Every log event consumed may have been filtered out by the query.
+		if 0 < columns.Len() || 0 == pos {
+			return columns, nil
+		}
+	}
+}
+
+// ReadMatchCounts uses [Deserializer].CountMatches to count the log events within
+// the time interval of counts that match each query in compiledQuery, adding
+// them to counts, without returning any log event to Go. Counting continues to
+// the end of the IR stream, or until the first log event after the time
+// interval, which the Reader is left at. Returns:
+//   - success: nil
+//   - error: error propagated from [Deserializer].CountMatches or
+//     [io.Reader.Read] ([CorruptedIr] if compiledQuery is nil or closed)
+func (reader *Reader) ReadMatchCounts(
+	compiledQuery *search.CompiledQuery,
+	counts *MatchCounts,
+) error {
+	for {
+		pos, err := reader.CountMatches(
+			reader.buf[reader.start:reader.end],
+			compiledQuery,
+			counts,
+		)
+		reader.advance(pos)
+		switch err {
+		case IncompleteIr:
+			if _, err = reader.fillBuf(); nil != err {
+				return err
+			}
+		case EndOfIr, QueryNotFound:
+			return nil
+		default:
+			return err
+		}
+	}
+}
+
 // ReadToWildcardMatch wraps ReadToWildcardMatchWithTimeInterval, attempting to
 // read the next log event that matches any query in queries, within the entire
 // IR. It forwards the result of ReadToWildcardMatchWithTimeInterval.
@@ -107,6 +263,9 @@ func (reader *Reader) ReadToWildcardMatch(
 //   - -1 index
 //   - [IrError] error: CLP failed to successfully deserialize
 //   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval, in which case the Reader is left at the first log event
+//     after timeInterval
 func (reader *Reader) ReadToWildcardMatchWithTimeInterval(
 	queries []search.WildcardQuery,
 	timeInterval search.TimestampInterval,
@@ -115,27 +274,155 @@ func (reader *Reader) ReadToWildcardMatchWithTimeInterval(
 	var pos int
 	var matchingQuery int
 	var err error
-	mergedQuery := search.MergeWildcardQueries(queries)
+	if nil == reader.queries || false == slices.Equal(reader.queries, queries) {
+		reader.queries = slices.Clone(queries)
+		reader.mergedQuery = search.MergeWildcardQueries(queries)
+	}
 	for {
 		event, pos, matchingQuery, err = reader.DeserializeWildcardMatchWithTimeInterval(
 			reader.buf[reader.start:reader.end],
-			mergedQuery,
+			reader.mergedQuery,
+			timeInterval,
+		)
+		if IncompleteIr != err {
+			break
+		}
+		reader.advance(pos)
+		if _, err = reader.fillBuf(); nil != err {
+			break
+		}
+	}
+	if QueryNotFound == err {
+		// The log events before pos were rejected, so a search with a later
+		// time interval doesn't need to scan them again.
+		reader.advance(pos)
+	}
+	if nil != err {
+		return nil, -1, err
+	}
+	reader.advance(pos)
+	return event, matchingQuery, nil
+}
+
+// ReadToCompiledQueryMatch wraps ReadToCompiledQueryMatchWithTimeInterval,
+// attempting to read the next log event that matches any query in
+// compiledQuery, within the entire IR. It forwards the result of
+// ReadToCompiledQueryMatchWithTimeInterval.
+func (reader *Reader) ReadToCompiledQueryMatch(
+	compiledQuery *search.CompiledQuery,
+) (*ffi.LogEventView, int, error) {
+	return reader.ReadToCompiledQueryMatchWithTimeInterval(
+		compiledQuery,
+		search.TimestampInterval{Lower: 0, Upper: math.MaxInt64},
+	)
+}
+
+// ReadToCompiledQueryMatchWithTimeInterval attempts to read the next log event
+// that matches any query in compiledQuery, within timeInterval. As the queries
+// were processed when compiledQuery was created, this avoids the per call cost
+// of ReadToWildcardMatchWithTimeInterval when searching for many matches. It
+// returns the deserialized [ffi.LogEventView], the index of the matched query
+// in compiledQuery, and an error. On error returns:
+//   - nil *ffi.LogEventView
+//   - -1 index
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval, in which case the Reader is left at the first log event
+//     after timeInterval
+//   - [CorruptedIr] error: compiledQuery is nil or closed
+func (reader *Reader) ReadToCompiledQueryMatchWithTimeInterval(
+	compiledQuery *search.CompiledQuery,
+	timeInterval search.TimestampInterval,
+) (*ffi.LogEventView, int, error) {
+	var event *ffi.LogEventView
+	var pos int
+	var matchingQuery int
+	var err error
+	for {
+		event, pos, matchingQuery, err = reader.DeserializeCompiledQueryMatchWithTimeInterval(
+			reader.buf[reader.start:reader.end],
+			compiledQuery,
 			timeInterval,
 		)
 		if IncompleteIr != err {
 			break
 		}
+		reader.advance(pos)
 		if _, err = reader.fillBuf(); nil != err {
 			break
 		}
 	}
+	if QueryNotFound == err {
+		// The log events before pos were rejected, so a search with a later
+		// time interval doesn't need to scan them again.
+		reader.advance(pos)
+	}
 	if nil != err {
 		return nil, -1, err
 	}
-	reader.start += pos
+	reader.advance(pos)
 	return event, matchingQuery, nil
 }
 
+// ReadToNumericQueryMatch wraps ReadToNumericQueryMatchWithTimeInterval,
+// attempting to read the next log event that matches numericQuery, within the
+// entire IR. It forwards the result of
+// ReadToNumericQueryMatchWithTimeInterval.
+func (reader *Reader) ReadToNumericQueryMatch(
+	numericQuery *search.NumericQuery,
+) (*ffi.LogEventView, error) {
+	return reader.ReadToNumericQueryMatchWithTimeInterval(
+		numericQuery,
+		search.TimestampInterval{Lower: 0, Upper: math.MaxInt64},
+	)
+}
+
+// ReadToNumericQueryMatchWithTimeInterval attempts to read the next log event
+// that matches numericQuery, within timeInterval. The query's predicates are
+// compared against the encoded variables of each log event, so unlike a
+// [search.CompiledQuery] matching numbers by their text, only the log messages
+// of matching log events are decoded. It returns the deserialized
+// [ffi.LogEventView] and an error. On error returns:
+//   - nil *ffi.LogEventView
+//   - [IrError] error: CLP failed to successfully deserialize
+//   - [EndOfIr] error: CLP found the IR stream EOF tag
+//   - [QueryNotFound] error: no log event matched before the end of
+//     timeInterval, in which case the Reader is left at the first log event
+//     after timeInterval
+func (reader *Reader) ReadToNumericQueryMatchWithTimeInterval(
+	numericQuery *search.NumericQuery,
+	timeInterval search.TimestampInterval,
+) (*ffi.LogEventView, error) {
+	var event *ffi.LogEventView
+	var pos int
+	var err error
+	for {
+		event, pos, err = reader.DeserializeNumericQueryMatchWithTimeInterval(
+			reader.buf[reader.start:reader.end],
+			numericQuery,
+			timeInterval,
+		)
+		if IncompleteIr != err {
+			break
+		}
+		reader.advance(pos)
+		if _, err = reader.fillBuf(); nil != err {
+			break
+		}
+	}
+	if QueryNotFound == err {
+		// The log events before pos were rejected, so a search with a later
+		// time interval doesn't need to scan them again.
+		reader.advance(pos)
+	}
+	if nil != err {
+		return nil, err
+	}
+	reader.advance(pos)
+	return event, nil
+}
+
 // Read the CLP IR byte stream until f returns true for a [ffi.LogEventView].
 // The successful LogEvent is returned. Errors are propagated from [Reader.Read].
 func (reader *Reader) ReadToFunc(
@@ -153,11 +440,17 @@ func (reader *Reader) ReadToFunc(
 }
 
 // Read the CLP IR stream until a [ffi.LogEventView] is greater than or equal to
-// the given timestamp. Errors are propagated from [Reader.ReadToFunc].
+// the given timestamp. Only the timestamps of the log events before it are
+// deserialized. Errors are propagated from
+// [Reader.ReadToWildcardMatchWithTimeInterval].
 func (reader *Reader) ReadToEpochTime(
 	time ffi.EpochTimeMs,
 ) (*ffi.LogEventView, error) {
-	return reader.ReadToFunc(func(event *ffi.LogEventView) bool { return event.Timestamp >= time })
+	event, _, err := reader.ReadToWildcardMatchWithTimeInterval(
+		nil,
+		search.TimestampInterval{Lower: time, Upper: math.MaxInt64},
+	)
+	return event, err
 }
 
 // Read the CLP IR stream until [strings/Contains] returns true for a
@@ -190,24 +483,159 @@ func (reader *Reader) ReadToSuffix(suffix string) (*ffi.LogEventView, error) {
 	return reader.ReadToFunc(fn)
 }
 
-// fillBuf shifts the remaining valid IR in [Reader.buf] to the front and then
-// calls [io.Reader.Read] to fill the remainder with more IR. Before reading into
-// the buffer, it is doubled if more than half of it is unconsumed IR.
-// Forwards the return of [io.Reader.Read].
-func (reader *Reader) fillBuf() (int, error) {
-	if (reader.end - reader.start) > len(reader.buf)/2 {
-		buf := make([]byte, len(reader.buf)*2)
-		copy(buf, reader.buf[reader.start:reader.end])
-		reader.buf = buf
+// SeekToTime uses index to move the Reader to the last [Checkpoint] (see
+// [Index.Find]) before which every log event has a timestamp less than time,
+// skipping those log events without deserializing them. Subsequent reads (e.g.
+// [Reader.ReadToEpochTime]) can then continue to the exact log event. If there
+// is no such checkpoint the Reader is not moved. The Reader must be created by
+// [NewMmapReader] or from an [io.Seeker] positioned at the start of the stream
+// that index was built for. On error returns:
+//   - [ErrUnseekable] if the Reader's source is not an [io.Seeker]
+//   - [ErrInvalidIndex] if the checkpoint is outside the memory mapped file
+//   - error propagated from [io.Seeker.Seek]
+func (reader *Reader) SeekToTime(index *Index, time ffi.EpochTimeMs) error {
+	checkpoint, ok := index.Find(time)
+	if !ok {
+		return nil
+	}
+	if nil != reader.mmap {
+		if checkpoint.Offset < 0 || int64(len(reader.buf)) < checkpoint.Offset {
+			return ErrInvalidIndex
+		}
+		reader.start = int(checkpoint.Offset)
+		reader.mmap.prefetchedTo = 0
+		reader.mmap.prefetch(reader.buf, reader.start)
 	} else {
+		seeker, ok := reader.ioReader.(io.Seeker)
+		if !ok {
+			return ErrUnseekable
+		}
+		if _, err := seeker.Seek(reader.streamStart+checkpoint.Offset, io.SeekStart); nil != err {
+			return err
+		}
+		reader.start = 0
+		reader.end = 0
+	}
+	if irs, ok := reader.Deserializer.(*fourByteDeserializer); ok {
+		irs.setPrevTimestamp(checkpoint.ReferenceTimestamp)
+	}
+	return nil
+}
+
+// ReadParallel uses the checkpoints of index as split points to deserialize
+// the log events following the Reader's position in parallel, using up to
+// numThreads threads (one per chunk between consecutive checkpoints). Each call
+// deserializes up to the numThreads-th checkpoint after the Reader's position
+// (or the end of the stream if there are too few), and returns the log events
+// in stream order. If numThreads is not positive, [runtime.NumCPU] threads are
+// used. Every view returned remains valid only until the next read call on the
+// Reader. The Reader must be created by [NewMmapReader] from the stream that
+// index was built for. Returns:
+//   - success: log events read (at least 1), nil
+//   - error: nil, [ErrUnseekable] if the Reader is not memory mapped,
+//     [ErrInvalidIndex] if a checkpoint is outside the memory mapped file,
+//     [io.ErrUnexpectedEOF] if the stream is truncated, or error propagated
+//     from [Deserializer]
+func (reader *Reader) ReadParallel(
+	index *Index,
+	numThreads int,
+) ([]ffi.LogEventView, error) {
+	if nil == reader.mmap {
+		return nil, ErrUnseekable
+	}
+	if 0 >= numThreads {
+		numThreads = runtime.NumCPU()
+	}
+	end := len(reader.buf)
+	var chunkOffsets []int
+	var chunkTimestamps []int64
+	checkpoints := index.Checkpoints
+	i := sort.Search(len(checkpoints), func(i int) bool {
+		return int64(reader.start) < checkpoints[i].Offset
+	})
+	for ; i < len(checkpoints); i++ {
+		offset := checkpoints[i].Offset
+		if int64(len(reader.buf)) < offset {
+			return nil, ErrInvalidIndex
+		}
+		if numThreads-1 == len(chunkOffsets) {
+			end = int(offset)
+			break
+		}
+		chunkOffsets = append(chunkOffsets, int(offset)-reader.start)
+		chunkTimestamps = append(chunkTimestamps, int64(checkpoints[i].ReferenceTimestamp))
+	}
+	events, pos, err := deserializeLogEventsParallel(
+		reader.Deserializer,
+		reader.buf[reader.start:end],
+		chunkOffsets,
+		chunkTimestamps,
+	)
+	if IncompleteIr == err {
+		return nil, io.ErrUnexpectedEOF
+	}
+	if nil != err {
+		return nil, err
+	}
+	reader.advance(pos)
+	return events, nil
+}
+
+// advance consumes n bytes of IR from the front of the valid range in
+// [Reader.buf].
+func (reader *Reader) advance(n int) {
+	reader.start += n
+	if nil != reader.mmap {
+		reader.mmap.prefetch(reader.buf, reader.start)
+	}
+}
+
+// fillBuf makes room in [Reader.buf] after the remaining valid IR and then
+// calls [io.Reader.Read] to fill it with more IR. The valid IR is only shifted
+// to the front of the buffer once less than half of the buffer is free after
+// it, so each byte of IR is shifted at most once per half a buffer consumed.
+// The buffer is doubled (up to [Reader.maxSize]) only once the valid IR fills
+// it, and is shrunk back to [Reader.size] once the valid IR fits in half of
+// that, so a single large log event doesn't keep the buffer large for the rest
+// of the stream. Forwards the return of [io.Reader.Read], or returns
+// [ErrBufferFull] if the buffer is full and can't grow. A memory mapped file is
+// never filled, as buf already holds the entire file, so [io.ErrUnexpectedEOF]
+// is returned.
+func (reader *Reader) fillBuf() (int, error) {
+	if nil != reader.mmap {
+		return 0, io.ErrUnexpectedEOF
+	}
+	valid := reader.end - reader.start
+	switch {
+	case len(reader.buf) > reader.size && valid <= reader.size/2:
+		reader.resizeBuf(reader.size)
+	case len(reader.buf) == valid:
+		if 0 < reader.maxSize && len(reader.buf) >= reader.maxSize {
+			return 0, ErrBufferFull
+		}
+		size := 2 * len(reader.buf)
+		if 0 < reader.maxSize {
+			size = min(size, reader.maxSize)
+		}
+		reader.resizeBuf(size)
+	case len(reader.buf)-reader.end < len(reader.buf)/2:
 		copy(reader.buf, reader.buf[reader.start:reader.end])
+		reader.start = 0
+		reader.end = valid
 	}
-	reader.end -= reader.start
-	reader.start = 0
 	n, err := reader.read()
 	return n, err
 }
 
+// resizeBuf replaces [Reader.buf] with a buffer of the given size, holding the
+// remaining valid IR at its front.
+func (reader *Reader) resizeBuf(size int) {
+	buf := make([]byte, size)
+	reader.end = copy(buf, reader.buf[reader.start:reader.end])
+	reader.start = 0
+	reader.buf = buf
+}
+
 // read is a wrapper around a io.Reader.Read call. It uses the correct range in
 // buf and adjusts the range accordingly. Always returns the number of bytes
 // read. On success nil is returned. On failure an error is forwarded from
@@ -0,0 +1,204 @@
+package ir
+
+/*
+#include <ffi_go/defs.h>
+#include <ffi_go/search/search_engine.h>
+#include <ffi_go/search/wildcard_query.h>
+*/
+import "C"
+
+import (
+	"errors"
+	"runtime"
+	"strings"
+	"unsafe"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+	"github.com/y-scope/clp-ffi-go/search"
+)
+
+const (
+	searchResultCapacity int = 4096
+	searchBatchSize      int = 256
+)
+
+// ErrSourceRead is reported by [ParallelSearch.SourceErrors] for a file that
+// could not be read.
+var ErrSourceRead = errors.New("ir: failed to read search source")
+
+// ErrSearchStart is returned by [SearchBuffers] and [SearchFiles] if the search
+// could not be started (e.g. the [search.CompiledQuery] is nil or closed, or
+// its worker threads could not be created).
+var ErrSearchStart = errors.New("ir: failed to start search")
+
+// A SearchResult is a log event found by a [ParallelSearch]. Source is the
+// index of the buffer or file containing the log event, and MatchingQuery is
+// the index of the first query in the [search.CompiledQuery] that matches it.
+type SearchResult struct {
+	ffi.LogEventView
+	Source        int
+	MatchingQuery int
+}
+
+// A ParallelSearch searches many CLP IR streams for log events matching a
+// [search.CompiledQuery] within a time interval, using a fixed pool of C++
+// worker threads. Unlike searching each stream with its own [Reader], the
+// streams are searched in parallel by a single cgo call, with idle workers
+// stealing streams from busy ones. Results are buffered in a bounded ring buffer
+// and returned in batches by Next; the results of each stream are in stream
+// order, but results of different streams interleave. The CompiledQuery must
+// not be closed before the ParallelSearch. Close must be called to stop the
+// workers and free the underlying memory, and failure to do so will result in a
+// memory leak.
+type ParallelSearch struct {
+	cptr       unsafe.Pointer
+	pinner     runtime.Pinner
+	numSources int
+	cResults   []C.SearchResult
+	results    []SearchResult
+}
+
+// SearchBuffers starts a [ParallelSearch] of bufs, which must each hold an
+// entire uncompressed CLP IR stream (starting with its preamble). The buffers
+// must not be modified until the ParallelSearch is closed. If numThreads is not
+// positive, [runtime.NumCPU] threads are used. On error returns:
+//   - nil *ParallelSearch
+//   - [ErrSearchStart] error: the search could not be started
+func SearchBuffers(
+	bufs [][]byte,
+	compiledQuery *search.CompiledQuery,
+	timeInterval search.TimestampInterval,
+	numThreads int,
+) (*ParallelSearch, error) {
+	ps := newParallelSearch(len(bufs))
+	spans := make([]C.ByteSpan, len(bufs))
+	for i, buf := range bufs {
+		// The workers read the buffers after this call returns.
+		if 0 < len(buf) {
+			ps.pinner.Pin(unsafe.SliceData(buf))
+		}
+		spans[i] = newCByteSpan(buf)
+	}
+	ps.cptr = C.search_engine_search_buffers(
+		C.ByteSpanSpan{unsafe.SliceData(spans), C.size_t(len(spans))},
+		compiledQuery.Pointer(),
+		C.TimestampInterval{C.int64_t(timeInterval.Lower), C.int64_t(timeInterval.Upper)},
+		C.size_t(numSearchThreads(numThreads)),
+		C.size_t(searchResultCapacity),
+	)
+	if nil == ps.cptr {
+		ps.pinner.Unpin()
+		return nil, ErrSearchStart
+	}
+	return ps, nil
+}
+
+// SearchFiles starts a [ParallelSearch] of the uncompressed CLP IR files at
+// paths. Each file is read into memory by the worker searching it. If
+// numThreads is not positive, [runtime.NumCPU] threads are used. On error
+// returns:
+//   - nil *ParallelSearch
+//   - [ErrSearchStart] error: the search could not be started
+func SearchFiles(
+	paths []string,
+	compiledQuery *search.CompiledQuery,
+	timeInterval search.TimestampInterval,
+	numThreads int,
+) (*ParallelSearch, error) {
+	ps := newParallelSearch(len(paths))
+	var mergedPaths strings.Builder
+	endOffsets := make([]int, len(paths))
+	for i, path := range paths {
+		mergedPaths.WriteString(path)
+		endOffsets[i] = mergedPaths.Len()
+	}
+	ps.cptr = C.search_engine_search_files(
+		newCStringView(mergedPaths.String()),
+		newCSizetSpan(endOffsets),
+		compiledQuery.Pointer(),
+		C.TimestampInterval{C.int64_t(timeInterval.Lower), C.int64_t(timeInterval.Upper)},
+		C.size_t(numSearchThreads(numThreads)),
+		C.size_t(searchResultCapacity),
+	)
+	if nil == ps.cptr {
+		ps.pinner.Unpin()
+		return nil, ErrSearchStart
+	}
+	return ps, nil
+}
+
+func newParallelSearch(numSources int) *ParallelSearch {
+	return &ParallelSearch{
+		numSources: numSources,
+		cResults:   make([]C.SearchResult, searchBatchSize),
+		results:    make([]SearchResult, 0, searchBatchSize),
+	}
+}
+
+func numSearchThreads(numThreads int) int {
+	if 0 >= numThreads {
+		return runtime.NumCPU()
+	}
+	return numThreads
+}
+
+// Next waits for the next batch of results. Every view in the returned results
+// is invalidated by the next call to Next or Close. On error returns:
+//   - nil []SearchResult
+//   - [EndOfIr] error: every stream has been searched and all results have
+//     been returned (see SourceErrors)
+func (ps *ParallelSearch) Next() ([]SearchResult, error) {
+	var numResults C.size_t
+	if 0 == C.search_engine_next_results(
+		ps.cptr,
+		C.SearchResultSpan{unsafe.SliceData(ps.cResults), C.size_t(len(ps.cResults))},
+		&numResults,
+	) {
+		return nil, EndOfIr
+	}
+	ps.results = ps.results[:0]
+	for _, result := range ps.cResults[:numResults] {
+		ps.results = append(ps.results, SearchResult{
+			LogEventView: ffi.LogEventView{
+				LogMessageView: unsafe.String(
+					(*byte)((unsafe.Pointer)(result.m_log_event.m_log_message.m_data)),
+					result.m_log_event.m_log_message.m_size,
+				),
+				Timestamp: ffi.EpochTimeMs(result.m_log_event.m_timestamp),
+			},
+			Source:        int(result.m_source),
+			MatchingQuery: int(result.m_matching_query),
+		})
+	}
+	return ps.results, nil
+}
+
+// SourceErrors returns the error that occurred while searching each stream (nil
+// if it was searched successfully), indexed the same as the buffers or paths of
+// the search. The errors are only complete once Next has returned [EndOfIr].
+// Each error is either [ErrSourceRead] or an [IrError].
+func (ps *ParallelSearch) SourceErrors() []error {
+	errs := make([]error, ps.numSources)
+	for i := range errs {
+		switch err := C.search_engine_get_source_error(ps.cptr, C.size_t(i)); err {
+		case 0:
+		case -1:
+			errs[i] = ErrSourceRead
+		default:
+			errs[i] = IrError(err)
+		}
+	}
+	return errs
+}
+
+// Close cancels the search if it is still running, waits for the workers to
+// exit, and deletes the underlying C++ allocated memory. Failure to call Close
+// will result in a memory leak.
+func (ps *ParallelSearch) Close() error {
+	if nil != ps.cptr {
+		C.search_engine_delete(ps.cptr)
+		ps.cptr = nil
+	}
+	ps.pinner.Unpin()
+	return nil
+}
@@ -0,0 +1,201 @@
+package ir
+
+import (
+	"bytes"
+	"fmt"
+	"math"
+	"os"
+	"testing"
+	"time"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+	"github.com/y-scope/clp-ffi-go/search"
+)
+
+func TestParallelSearch(t *testing.T) {
+	const numEvents int = 100
+	var args []testArgs
+	for i := 0; i < 4; i++ {
+		for _, arg := range generateTestArgs(t, fmt.Sprintf("%v-%v", t.Name(), i)) {
+			if noCompression == arg.compression {
+				args = append(args, arg)
+			}
+		}
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*id=*7*", true),
+		search.NewWildcardQuery("*ERROR*", false),
+	}
+	compiledQuery := search.CompileWildcardQueries(queries)
+	defer compiledQuery.Close()
+
+	// Expected matches of each source, in stream order.
+	expected := make([][]ffi.LogEvent, len(args))
+	var paths []string
+	var bufs [][]byte
+	start := ffi.EpochTimeMs(time.Now().UnixMilli())
+	for i, arg := range args {
+		ioWriter := openIoWriter(t, arg)
+		irWriter := openIrWriter(t, arg, ioWriter)
+		for j := 0; j < numEvents; j++ {
+			level := "INFO"
+			if 0 == j%5 {
+				level = "error"
+			}
+			event := ffi.LogEvent{
+				LogMessage: ffi.LogMessage(fmt.Sprintf("%v source %v id=%v", level, i, j)),
+				Timestamp:  start + ffi.EpochTimeMs(j),
+			}
+			if _, err := irWriter.Write(event); nil != err {
+				t.Fatalf("ir.Writer.Write failed: %v", err)
+			}
+			if _, ok := compiledQuery.Match(string(event.LogMessage)); ok {
+				expected[i] = append(expected[i], event)
+			}
+		}
+		if _, err := irWriter.CloseTo(ioWriter); nil != err {
+			t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+		}
+		ioWriter.Close()
+		buf, err := os.ReadFile(arg.filePath)
+		if nil != err {
+			t.Fatalf("os.ReadFile failed: %v", err)
+		}
+		paths = append(paths, arg.filePath)
+		bufs = append(bufs, buf)
+	}
+
+	timeInterval := search.TimestampInterval{Lower: 0, Upper: math.MaxInt64}
+	t.Run("Files", func(t *testing.T) {
+		ps, err := SearchFiles(paths, compiledQuery, timeInterval, 3)
+		if nil != err {
+			t.Fatalf("SearchFiles failed: %v", err)
+		}
+		defer ps.Close()
+		assertParallelSearch(t, ps, compiledQuery, expected)
+	})
+	t.Run("Buffers", func(t *testing.T) {
+		ps, err := SearchBuffers(bufs, compiledQuery, timeInterval, 3)
+		if nil != err {
+			t.Fatalf("SearchBuffers failed: %v", err)
+		}
+		defer ps.Close()
+		assertParallelSearch(t, ps, compiledQuery, expected)
+	})
+}
+
+func assertParallelSearch(
+	t *testing.T,
+	ps *ParallelSearch,
+	compiledQuery *search.CompiledQuery,
+	expected [][]ffi.LogEvent,
+) {
+	next := make([]int, len(expected))
+	for {
+		results, err := ps.Next()
+		if EndOfIr == err {
+			break
+		}
+		if nil != err {
+			t.Fatalf("ParallelSearch.Next failed: %v", err)
+		}
+		for _, result := range results {
+			if len(expected[result.Source]) <= next[result.Source] {
+				t.Fatalf("ParallelSearch.Next unexpected result: '%v'", result)
+			}
+			event := expected[result.Source][next[result.Source]]
+			next[result.Source]++
+			if event.Timestamp != result.Timestamp || event.LogMessage != result.LogMessageView {
+				t.Fatalf("ParallelSearch.Next wrong result: '%v' != '%v'", result, event)
+			}
+			match, _ := compiledQuery.Match(result.LogMessageView)
+			if match != result.MatchingQuery {
+				t.Fatalf("ParallelSearch.Next wrong query: %v != %v", result.MatchingQuery, match)
+			}
+		}
+	}
+	for i, err := range ps.SourceErrors() {
+		if nil != err {
+			t.Fatalf("ParallelSearch source %v failed: %v", i, err)
+		}
+		if len(expected[i]) != next[i] {
+			t.Fatalf("ParallelSearch source %v results: %v != %v", i, next[i], len(expected[i]))
+		}
+	}
+}
+
+func TestParallelSearchClosedQuery(t *testing.T) {
+	compiledQuery := search.CompileWildcardQueries(nil)
+	compiledQuery.Close()
+	timeInterval := search.TimestampInterval{Lower: 0, Upper: math.MaxInt64}
+	_, err := SearchBuffers([][]byte{{0}}, compiledQuery, timeInterval, 1)
+	if ErrSearchStart != err {
+		t.Fatalf("SearchBuffers with a closed query: %v != %v", err, ErrSearchStart)
+	}
+	_, err = SearchFiles([]string{"ir"}, compiledQuery, timeInterval, 1)
+	if ErrSearchStart != err {
+		t.Fatalf("SearchFiles with a closed query: %v != %v", err, ErrSearchStart)
+	}
+}
+
+func TestParallelSearchInvalidReferenceTimestamp(t *testing.T) {
+	var bufs [][]byte
+	for _, arg := range generateTestArgs(t, t.Name()) {
+		if noCompression != arg.compression || fourByteEncoding != arg.encoding {
+			continue
+		}
+		ioWriter := openIoWriter(t, arg)
+		irWriter := openIrWriter(t, arg, ioWriter)
+		event := ffi.LogEvent{LogMessage: "log message", Timestamp: 1}
+		if _, err := irWriter.Write(event); nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+		if _, err := irWriter.CloseTo(ioWriter); nil != err {
+			t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+		}
+		ioWriter.Close()
+		buf, err := os.ReadFile(arg.filePath)
+		if nil != err {
+			t.Fatalf("os.ReadFile failed: %v", err)
+		}
+		bufs = append(bufs, buf)
+	}
+	if 0 == len(bufs) {
+		t.Fatalf("no four byte encoded test streams")
+	}
+
+	// Corrupt the reference timestamp of the first stream without changing
+	// the metadata's size.
+	key := []byte(`"` + metadataReferenceTimestampKey + `":"`)
+	pos := bytes.Index(bufs[0], key)
+	if 0 > pos {
+		t.Fatalf("reference timestamp not found in metadata")
+	}
+	bufs[0][pos+len(key)] = 'x'
+
+	compiledQuery := search.CompileWildcardQueries(nil)
+	defer compiledQuery.Close()
+	ps, err := SearchBuffers(
+		bufs,
+		compiledQuery,
+		search.TimestampInterval{Lower: 0, Upper: math.MaxInt64},
+		2,
+	)
+	if nil != err {
+		t.Fatalf("SearchBuffers failed: %v", err)
+	}
+	defer ps.Close()
+	for {
+		if _, err := ps.Next(); EndOfIr == err {
+			break
+		}
+	}
+	for i, err := range ps.SourceErrors() {
+		if 0 == i && CorruptedIr != err {
+			t.Fatalf("ParallelSearch source %v error: %v != %v", i, err, CorruptedIr)
+		}
+		if 0 != i && nil != err {
+			t.Fatalf("ParallelSearch source %v failed: %v", i, err)
+		}
+	}
+}
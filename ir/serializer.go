@@ -17,14 +17,32 @@ import (
 // leaving their use to the user. Each Serializer owns its own unique underlying
 // memory for the views it produces/returns. This memory is reused for each
 // view, so to persist the contents the memory must be copied into another
-// object. Close must be called to free the underlying memory and failure to do
-// so will result in a memory leak.
+// object. Alternatively, the Append functions accumulate IR in a persistent
+// buffer owned by the Serializer, which is only viewed (using BufferedIr) once
+// the IR is to be consumed, avoiding a copy and an allocation per log event.
+// Close must be called to free the underlying memory and failure to do so will
+// result in a memory leak.
 type Serializer interface {
 	SerializeLogEvent(event ffi.LogEvent) (BufView, error)
+	SerializeLogEventBatch(events []ffi.LogEvent) (BufView, error)
+	AppendLogEvent(event ffi.LogEvent) (int, error)
+	AppendLogEventBatch(events []ffi.LogEvent) (int, error)
+	BufferedIr() BufView
+	ClearBufferedIr()
 	TimestampInfo() TimestampInfo
+	Counters() (SerializerCounters, bool)
 	Close() error
 }
 
+// SerializerCounters is a snapshot of the work done by a Serializer.
+// BytesSerialized counts the IR of the serialized log events (excluding the
+// preamble), and BufferGrowths the reallocations of the Serializer's IR buffer.
+type SerializerCounters struct {
+	EventsSerialized uint64
+	BytesSerialized  uint64
+	BufferGrowths    uint64
+}
+
 // EightByteSerializer creates and returns a new Serializer that writes eight
 // byte encoded CLP IR and serializes a IR preamble into a BufView using it. On
 // error returns:
@@ -38,7 +56,12 @@ func EightByteSerializer(
 ) (Serializer, BufView, error) {
 	var irView C.ByteSpan
 	irs := eightByteSerializer{
-		commonSerializer{TimestampInfo{tsPattern, tsPatternSyntax, timeZoneId}, nil},
+		commonSerializer{
+			TimestampInfo{tsPattern, tsPatternSyntax, timeZoneId},
+			nil,
+			batchScratch{},
+			0,
+		},
 	}
 	if err := IrError(C.ir_serializer_new_eight_byte_serializer_with_preamble(
 		newCStringView(tsPattern),
@@ -66,7 +89,12 @@ func FourByteSerializer(
 ) (Serializer, BufView, error) {
 	var irView C.ByteSpan
 	irs := fourByteSerializer{
-		commonSerializer{TimestampInfo{tsPattern, tsPatternSyntax, timeZoneId}, nil},
+		commonSerializer{
+			TimestampInfo{tsPattern, tsPatternSyntax, timeZoneId},
+			nil,
+			batchScratch{},
+			0,
+		},
 		referenceTs,
 	}
 	if err := IrError(C.ir_serializer_new_four_byte_serializer_with_preamble(
@@ -87,9 +115,39 @@ func FourByteSerializer(
 // cptr holds a reference to the underlying C++ objected used as backing storage
 // for the Views returned by the serializer. Close must be called to free this
 // underlying memory and failure to do so will result in a memory leak.
+// batch is reused across batch serialization calls to pack the log events.
+// bufferedSize is the size of the IR buffered by the Append functions (which
+// the SerializeLogEvent functions clear to hold their log events).
 type commonSerializer struct {
-	tsInfo TimestampInfo
-	cptr   unsafe.Pointer
+	tsInfo       TimestampInfo
+	cptr         unsafe.Pointer
+	batch        batchScratch
+	bufferedSize int
+}
+
+// batchScratch holds the packed form of a batch of log events passed down
+// through Cgo: the concatenation of all log messages, the end offset of each
+// message, and the timestamp (or timestamp delta) of each log event.
+type batchScratch struct {
+	logMessages []byte
+	endOffsets  []int
+	timestamps  []int64
+}
+
+// pack resets the scratch and fills it with events, using timestamp to
+// compute the value stored for each log event's timestamp.
+func (batch *batchScratch) pack(
+	events []ffi.LogEvent,
+	timestamp func(ffi.LogEvent) ffi.EpochTimeMs,
+) {
+	batch.logMessages = batch.logMessages[:0]
+	batch.endOffsets = batch.endOffsets[:0]
+	batch.timestamps = batch.timestamps[:0]
+	for _, event := range events {
+		batch.logMessages = append(batch.logMessages, event.LogMessage...)
+		batch.endOffsets = append(batch.endOffsets, len(batch.logMessages))
+		batch.timestamps = append(batch.timestamps, int64(timestamp(event)))
+	}
 }
 
 // Closes the serializer by releasing the underlying C++ allocated memory.
@@ -102,11 +160,41 @@ func (serializer *commonSerializer) Close() error {
 	return nil
 }
 
+// BufferedIr returns a view of the IR accumulated by the Append functions since
+// it was last cleared. The view is invalidated by the next call to the
+// Serializer.
+func (serializer *commonSerializer) BufferedIr() BufView {
+	var irView C.ByteSpan
+	C.ir_serializer_get_buffered_ir(serializer.cptr, &irView)
+	return unsafe.Slice((*byte)(irView.m_data), irView.m_size)
+}
+
+// ClearBufferedIr clears the IR accumulated by the Append functions (e.g. once
+// it has been written out), keeping the buffer's capacity for subsequent log
+// events.
+func (serializer *commonSerializer) ClearBufferedIr() {
+	C.ir_serializer_clear_buffered_ir(serializer.cptr)
+	serializer.bufferedSize = 0
+}
+
 // Returns the TimestampInfo of the Serializer.
 func (serializer commonSerializer) TimestampInfo() TimestampInfo {
 	return serializer.tsInfo
 }
 
+// Counters returns a snapshot of the Serializer's counters and whether they are
+// maintained. Unless the native library is built with CLP_FFI_GO_ENABLE_COUNTERS
+// the counters are compiled out and are all 0.
+func (serializer *commonSerializer) Counters() (SerializerCounters, bool) {
+	var counters C.SerializerCounters
+	enabled := C.ir_serializer_get_counters(serializer.cptr, &counters)
+	return SerializerCounters{
+		EventsSerialized: uint64(counters.m_events_serialized),
+		BytesSerialized:  uint64(counters.m_bytes_serialized),
+		BufferGrowths:    uint64(counters.m_buffer_growths),
+	}, 0 != enabled
+}
+
 type eightByteSerializer struct {
 	commonSerializer
 }
@@ -121,6 +209,40 @@ func (serializer *eightByteSerializer) SerializeLogEvent(
 	return serializeLogEvent(serializer, event)
 }
 
+// SerializeLogEventBatch attempts to serialize every log event in events, in
+// order, into a single eight byte encoded CLP IR byte stream using one Cgo
+// call. On error returns:
+//   - a nil BufView
+//   - [IrError] based on the failure of the Cgo call
+func (serializer *eightByteSerializer) SerializeLogEventBatch(
+	events []ffi.LogEvent,
+) (BufView, error) {
+	return serializeLogEventBatch(serializer, events)
+}
+
+// AppendLogEvent attempts to serialize the log event, event, into eight byte
+// encoded CLP IR, appending it to the Serializer's buffered IR (see
+// BufferedIr). The SerializeLogEvent functions clear the buffered IR. Returns:
+//   - success: number of bytes of IR appended, nil
+//   - error: 0, [IrError] based on the failure of the Cgo call
+func (serializer *eightByteSerializer) AppendLogEvent(
+	event ffi.LogEvent,
+) (int, error) {
+	return appendLogEvent(serializer, event)
+}
+
+// AppendLogEventBatch attempts to serialize every log event in events, in
+// order, into eight byte encoded CLP IR using one Cgo call, appending it to
+// the Serializer's buffered IR (see BufferedIr). If any log event fails to
+// serialize, none of events are appended. Returns:
+//   - success: number of bytes of IR appended, nil
+//   - error: 0, [IrError] based on the failure of the Cgo call
+func (serializer *eightByteSerializer) AppendLogEventBatch(
+	events []ffi.LogEvent,
+) (int, error) {
+	return appendLogEventBatch(serializer, events)
+}
+
 // fourByteSerializer contains both a common CLP IR serializer and stores the
 // previously seen log event's timestamp. The previous timestamp is necessary to
 // calculate the current timestamp as four byte encoding only encodes the
@@ -140,6 +262,40 @@ func (serializer *fourByteSerializer) SerializeLogEvent(
 	return serializeLogEvent(serializer, event)
 }
 
+// SerializeLogEventBatch attempts to serialize every log event in events, in
+// order, into a single four byte encoded CLP IR byte stream using one Cgo
+// call. On error returns:
+//   - nil BufView
+//   - [IrError] based on the failure of the Cgo call
+func (serializer *fourByteSerializer) SerializeLogEventBatch(
+	events []ffi.LogEvent,
+) (BufView, error) {
+	return serializeLogEventBatch(serializer, events)
+}
+
+// AppendLogEvent attempts to serialize the log event, event, into four byte
+// encoded CLP IR, appending it to the Serializer's buffered IR (see
+// BufferedIr). The SerializeLogEvent functions clear the buffered IR. Returns:
+//   - success: number of bytes of IR appended, nil
+//   - error: 0, [IrError] based on the failure of the Cgo call
+func (serializer *fourByteSerializer) AppendLogEvent(
+	event ffi.LogEvent,
+) (int, error) {
+	return appendLogEvent(serializer, event)
+}
+
+// AppendLogEventBatch attempts to serialize every log event in events, in
+// order, into four byte encoded CLP IR using one Cgo call, appending it to
+// the Serializer's buffered IR (see BufferedIr). If any log event fails to
+// serialize, none of events are appended. Returns:
+//   - success: number of bytes of IR appended, nil
+//   - error: 0, [IrError] based on the failure of the Cgo call
+func (serializer *fourByteSerializer) AppendLogEventBatch(
+	events []ffi.LogEvent,
+) (int, error) {
+	return appendLogEventBatch(serializer, events)
+}
+
 func serializeLogEvent(
 	serializer Serializer,
 	event ffi.LogEvent,
@@ -154,6 +310,7 @@ func serializeLogEvent(
 			irs.cptr,
 			&irView,
 		))
+		irs.bufferedSize = 0
 	case *fourByteSerializer:
 		err = IrError(C.ir_serializer_serialize_four_byte_log_event(
 			newCStringView(event.LogMessage),
@@ -161,6 +318,7 @@ func serializeLogEvent(
 			irs.cptr,
 			&irView,
 		))
+		irs.bufferedSize = 0
 		if Success == err {
 			irs.prevTimestamp = event.Timestamp
 		}
@@ -170,3 +328,130 @@ func serializeLogEvent(
 	}
 	return unsafe.Slice((*byte)(irView.m_data), irView.m_size), nil
 }
+
+func serializeLogEventBatch(
+	serializer Serializer,
+	events []ffi.LogEvent,
+) (BufView, error) {
+	var irView C.ByteSpan
+	var err error
+	switch irs := serializer.(type) {
+	case *eightByteSerializer:
+		batch := &irs.batch
+		batch.pack(events, func(event ffi.LogEvent) ffi.EpochTimeMs { return event.Timestamp })
+		err = IrError(C.ir_serializer_serialize_eight_byte_log_events_batch(
+			newCStringViewFromBytes(batch.logMessages),
+			newCSizetSpan(batch.endOffsets),
+			newCInt64tSpan(batch.timestamps),
+			irs.cptr,
+			&irView,
+		))
+		irs.bufferedSize = 0
+	case *fourByteSerializer:
+		batch := &irs.batch
+		prevTimestamp := irs.prevTimestamp
+		batch.pack(events, func(event ffi.LogEvent) ffi.EpochTimeMs {
+			delta := event.Timestamp - prevTimestamp
+			prevTimestamp = event.Timestamp
+			return delta
+		})
+		err = IrError(C.ir_serializer_serialize_four_byte_log_events_batch(
+			newCStringViewFromBytes(batch.logMessages),
+			newCSizetSpan(batch.endOffsets),
+			newCInt64tSpan(batch.timestamps),
+			irs.cptr,
+			&irView,
+		))
+		irs.bufferedSize = 0
+		if Success == err {
+			irs.prevTimestamp = prevTimestamp
+		}
+	}
+	if Success != err {
+		return nil, err
+	}
+	return unsafe.Slice((*byte)(irView.m_data), irView.m_size), nil
+}
+
+func appendLogEvent(
+	serializer Serializer,
+	event ffi.LogEvent,
+) (int, error) {
+	var bufferedSize C.size_t
+	var common *commonSerializer
+	var err error
+	switch irs := serializer.(type) {
+	case *eightByteSerializer:
+		common = &irs.commonSerializer
+		err = IrError(C.ir_serializer_append_eight_byte_log_event(
+			newCStringView(event.LogMessage),
+			C.int64_t(event.Timestamp),
+			irs.cptr,
+			&bufferedSize,
+		))
+	case *fourByteSerializer:
+		common = &irs.commonSerializer
+		err = IrError(C.ir_serializer_append_four_byte_log_event(
+			newCStringView(event.LogMessage),
+			C.int64_t(event.Timestamp-irs.prevTimestamp),
+			irs.cptr,
+			&bufferedSize,
+		))
+		if Success == err {
+			irs.prevTimestamp = event.Timestamp
+		}
+	}
+	if Success != err {
+		return 0, err
+	}
+	n := int(bufferedSize) - common.bufferedSize
+	common.bufferedSize = int(bufferedSize)
+	return n, nil
+}
+
+func appendLogEventBatch(
+	serializer Serializer,
+	events []ffi.LogEvent,
+) (int, error) {
+	var bufferedSize C.size_t
+	var common *commonSerializer
+	var err error
+	switch irs := serializer.(type) {
+	case *eightByteSerializer:
+		common = &irs.commonSerializer
+		batch := &irs.batch
+		batch.pack(events, func(event ffi.LogEvent) ffi.EpochTimeMs { return event.Timestamp })
+		err = IrError(C.ir_serializer_append_eight_byte_log_events_batch(
+			newCStringViewFromBytes(batch.logMessages),
+			newCSizetSpan(batch.endOffsets),
+			newCInt64tSpan(batch.timestamps),
+			irs.cptr,
+			&bufferedSize,
+		))
+	case *fourByteSerializer:
+		common = &irs.commonSerializer
+		batch := &irs.batch
+		prevTimestamp := irs.prevTimestamp
+		batch.pack(events, func(event ffi.LogEvent) ffi.EpochTimeMs {
+			delta := event.Timestamp - prevTimestamp
+			prevTimestamp = event.Timestamp
+			return delta
+		})
+		err = IrError(C.ir_serializer_append_four_byte_log_events_batch(
+			newCStringViewFromBytes(batch.logMessages),
+			newCSizetSpan(batch.endOffsets),
+			newCInt64tSpan(batch.timestamps),
+			irs.cptr,
+			&bufferedSize,
+		))
+		if Success == err {
+			irs.prevTimestamp = prevTimestamp
+		}
+	}
+	if Success != err {
+		return 0, err
+	}
+	n := int(bufferedSize) - common.bufferedSize
+	common.bufferedSize = int(bufferedSize)
+	return n, nil
+}
@@ -0,0 +1,444 @@
+package ir
+
+import (
+	"fmt"
+	"testing"
+
+	"github.com/y-scope/clp-ffi-go/ffi"
+	"github.com/y-scope/clp-ffi-go/search"
+)
+
+// The tests in this file check that searching the encoded form of log events
+// (which rejects most log events by their logtype and encoded variables before
+// decoding them) finds exactly the log events found by decoding every log
+// message and matching it with baselineWildcardMatch.
+
+func TestWildcardSearchSpanningVariables(t *testing.T) {
+	messages := []ffi.LogMessage{
+		"user=alice123 logged in",
+		"INFO request took 12 ms",
+		"disk usage at 93.5 percent",
+		"user=bob7 took 1234 ms at 0.5 load",
+	}
+	queries := []search.WildcardQuery{
+		// Static text followed by the start of a variable, and the end of a
+		// variable followed by static text.
+		search.NewWildcardQuery("*r=ali*", true),
+		search.NewWildcardQuery("*e123 lo*", true),
+		search.NewWildcardQuery("*=alice123 *", true),
+		search.NewWildcardQuery("*r=alj*", true),
+		search.NewWildcardQuery("*k 1*", true),
+		search.NewWildcardQuery("*2 m*", true),
+		search.NewWildcardQuery("*took 12 ms", true),
+		search.NewWildcardQuery("*t 93.*", true),
+		search.NewWildcardQuery("*.5 p*", true),
+		search.NewWildcardQuery("*b7 took 12*", true),
+		search.NewWildcardQuery("*34 ms at 0*", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchCaseInsensitiveVariables(t *testing.T) {
+	messages := []ffi.LogMessage{
+		"id=ABC123def state=Running",
+		"id=abc123DEF state=stopped",
+		"ID=xyz9 STATE=RUNNING",
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*abc123DEF*", false),
+		search.NewWildcardQuery("*abc123DEF*", true),
+		search.NewWildcardQuery("*Id=aBc*", false),
+		search.NewWildcardQuery("*c123d*", false),
+		search.NewWildcardQuery("*XYZ9 state=running", false),
+		search.NewWildcardQuery("*XYZ9*", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchQuestionMarkAcrossVariables(t *testing.T) {
+	messages := []ffi.LogMessage{
+		"INFO request took 12 ms",
+		"INFO request took 123 ms",
+		"id=ab1 done",
+		"ratio 0.25 now",
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*took ?? ms", true),
+		search.NewWildcardQuery("*took ? ms", true),
+		search.NewWildcardQuery("*took ??? ms", true),
+		search.NewWildcardQuery("*k?12?ms", true),
+		search.NewWildcardQuery("*=a?1 *", true),
+		search.NewWildcardQuery("id=??? done", true),
+		search.NewWildcardQuery("id=???? done", true),
+		search.NewWildcardQuery("*o 0?25*", true),
+		search.NewWildcardQuery("*o ?.?5 n*", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchEscapedPlaceholders(t *testing.T) {
+	// Each placeholder byte (and the escape character) in static text is
+	// escaped in the logtype.
+	messages := []ffi.LogMessage{
+		"raw \x11 byte 42",
+		"raw \x12 byte id=x9",
+		"raw \x13 byte 4.5",
+		`path C:\dir\x 5`,
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*raw \x11 byte*", true),
+		search.NewWildcardQuery("*\x11 byte 4?", true),
+		search.NewWildcardQuery("*raw ? byte*", true),
+		search.NewWildcardQuery("*\x12 byte id=*", true),
+		search.NewWildcardQuery("*\x13 byte 4.5", true),
+		search.NewWildcardQuery("*\x13*", true),
+		search.NewWildcardQuery(`*C:\\dir\\x*`, true),
+		search.NewWildcardQuery(`*\\x 5`, true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchSignsAndDecimalPoints(t *testing.T) {
+	messages := []ffi.LogMessage{
+		"delta -42 units",
+		"ratio -0.25 now",
+		"version 1.2.3 build",
+		"range 10-20 ok",
+		"offset -7.0 and 3",
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*-42 u*", true),
+		search.NewWildcardQuery("* -4*", true),
+		search.NewWildcardQuery("*-0.2*", true),
+		search.NewWildcardQuery("*0.25 n*", true),
+		search.NewWildcardQuery("*1.2.3*", true),
+		search.NewWildcardQuery("*.2.*", true),
+		search.NewWildcardQuery("*10-2*", true),
+		search.NewWildcardQuery("*-20 *", true),
+		search.NewWildcardQuery("*-7.0 and*", true),
+		search.NewWildcardQuery("*.0 and -*", true),
+		search.NewWildcardQuery("*-*", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchStaticLogtypes(t *testing.T) {
+	messages := []ffi.LogMessage{
+		"plain static message",
+		"Another STATIC message",
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*static*", true),
+		search.NewWildcardQuery("*STATIC*", false),
+		search.NewWildcardQuery("plain*", true),
+		search.NewWildcardQuery("*message", true),
+		search.NewWildcardQuery("*x*", true),
+		search.NewWildcardQuery("*", true),
+		search.NewWildcardQuery("plain static message", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+// testWildcardSearchBaseline searches messages with each of queries alone and
+// with all of them (so a later query is only checked for messages that no
+// earlier query matches), across every encoding and compression.
+func testWildcardSearchBaseline(
+	t *testing.T,
+	messages []ffi.LogMessage,
+	queries []search.WildcardQuery,
+) {
+	querySets := [][]search.WildcardQuery{queries}
+	for _, query := range queries {
+		querySets = append(querySets, []search.WildcardQuery{query})
+	}
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) {
+			t.Parallel()
+			writeLogMessages(t, args, messages)
+			for _, querySet := range querySets {
+				assertWildcardSearch(t, args, messages, querySet)
+			}
+		})
+	}
+}
+
+// writeLogMessages writes messages (one log event each) to args.filePath.
+func writeLogMessages(t *testing.T, args testArgs, messages []ffi.LogMessage) {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+	for i, msg := range messages {
+		event := ffi.LogEvent{
+			LogMessage: msg,
+			Timestamp:  ffi.EpochTimeMs(1_700_000_000_000 + i),
+		}
+		if _, err := irWriter.Write(event); nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+	}
+	if _, err := irWriter.CloseTo(ioWriter); nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+}
+
+// baselineMatches returns the index of the first query of queries matching
+// each of messages (-1 for none), found by baselineWildcardMatch.
+func baselineMatches(messages []ffi.LogMessage, queries []search.WildcardQuery) []int {
+	expected := make([]int, len(messages))
+	for i, msg := range messages {
+		expected[i] = -1
+		for q, query := range queries {
+			if baselineWildcardMatch(string(msg), query.Query(), query.CaseSensitive()) {
+				expected[i] = q
+				break
+			}
+		}
+	}
+	return expected
+}
+
+// assertWildcardSearch checks that searching the IR at args.filePath with
+// queries, through both Reader.ReadToWildcardMatch and
+// Reader.ReadToCompiledQueryMatch, returns the baseline matches in order.
+func assertWildcardSearch(
+	t *testing.T,
+	args testArgs,
+	messages []ffi.LogMessage,
+	queries []search.WildcardQuery,
+) {
+	expected := baselineMatches(messages, queries)
+	compiledQuery := search.CompileWildcardQueries(queries)
+	defer compiledQuery.Close()
+	for _, compiled := range []bool{false, true} {
+		ioReader := openIoReader(t, args)
+		irReader, err := NewReader(ioReader)
+		if nil != err {
+			t.Fatalf("NewReader failed: %v", err)
+		}
+		read := func() (*ffi.LogEventView, int, error) {
+			if compiled {
+				return irReader.ReadToCompiledQueryMatch(compiledQuery)
+			}
+			return irReader.ReadToWildcardMatch(queries)
+		}
+		for i, msg := range messages {
+			if -1 == expected[i] {
+				continue
+			}
+			log, queryIdx, err := read()
+			if nil != err {
+				t.Fatalf("search for '%v' in %v failed: %v", msg, queries, err)
+			}
+			if msg != log.LogMessageView || expected[i] != queryIdx {
+				t.Fatalf(
+					"search in %v found '%v' (query %v) instead of '%v' (query %v)",
+					queries,
+					log.LogMessageView,
+					queryIdx,
+					msg,
+					expected[i],
+				)
+			}
+		}
+		if log, _, err := read(); EndOfIr != err {
+			t.Fatalf("search in %v found extra match '%v': %v", queries, log, err)
+		}
+		irReader.Close()
+		ioReader.Close()
+	}
+}
+
+// baselineWildcardMatch is a straightforward implementation of CLP's wildcard
+// matching semantics: '*' matches zero or more characters, '?' matches any one
+// character, '\' escapes the next character, and case insensitive matching
+// folds ASCII letters.
+func baselineWildcardMatch(target string, query string, caseSensitive bool) bool {
+	fold := func(c byte) byte {
+		if false == caseSensitive && 'A' <= c && c <= 'Z' {
+			return c - 'A' + 'a'
+		}
+		return c
+	}
+	var matchFrom func(t int, q int) bool
+	matchFrom = func(t int, q int) bool {
+		for q < len(query) {
+			switch query[q] {
+			case '*':
+				for i := t; i <= len(target); i++ {
+					if matchFrom(i, q+1) {
+						return true
+					}
+				}
+				return false
+			case '?':
+				if len(target) <= t {
+					return false
+				}
+			default:
+				if '\\' == query[q] && q+1 < len(query) {
+					q++
+				}
+				if len(target) <= t || fold(target[t]) != fold(query[q]) {
+					return false
+				}
+			}
+			t++
+			q++
+		}
+		return len(target) == t
+	}
+	return matchFrom(0, 0)
+}
+
+func TestWildcardSearchOrderedLiterals(t *testing.T) {
+	// Queries of the form "*a*b*" are known to match every log message of a
+	// logtype whose static text contains their literals in order, without
+	// checking the variables.
+	messages := []ffi.LogMessage{
+		"INFO request took 12 ms",
+		"ms then took 3",
+		"a x9a b",
+		"took 1 took",
+		"took 1 to",
+		"Took 7 MS total",
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*took*ms*", true),
+		search.NewWildcardQuery("*ms*took*", true),
+		search.NewWildcardQuery("*TOOK*MS*", false),
+		search.NewWildcardQuery("*a*a*", true),
+		search.NewWildcardQuery("*ok*ok*", true),
+		search.NewWildcardQuery("*took*12*ms*", true),
+		search.NewWildcardQuery("*took*1*", true),
+		search.NewWildcardQuery("*request*", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchManyLogtypes(t *testing.T) {
+	// More distinct logtypes than a Deserializer caches, each appearing twice
+	// (after being evicted from the cache in between).
+	const numLogtypes int = 4500
+	var messages []ffi.LogMessage
+	for pass := 0; pass < 2; pass++ {
+		for i := 0; i < numLogtypes; i++ {
+			messages = append(
+				messages,
+				ffi.LogMessage(fmt.Sprintf("op%v took %v ms", letters(i), (i+pass)%10)),
+			)
+		}
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*took 5 ms", true),
+		search.NewWildcardQuery("opab *", true),
+		search.NewWildcardQuery("*OPZ?? *", false),
+		search.NewWildcardQuery("*took*ms*", true),
+	}
+	testWildcardSearchBaseline(t, messages, queries)
+}
+
+func TestWildcardSearchSwitchingQueries(t *testing.T) {
+	// Every message has one of two logtypes, which each query set classifies
+	// differently (e.g. "*took*ms*" matches every message of the first
+	// logtype, while "*took 5 ms" depends on its variable).
+	var messages []ffi.LogMessage
+	for i := 0; i < 3; i++ {
+		messages = append(
+			messages,
+			"user=alice1 took 5 ms",
+			"user=bob2 took 50 ms",
+			"ERROR user=carol3 failed",
+		)
+	}
+	querySets := [][]search.WildcardQuery{
+		{search.NewWildcardQuery("*took 5 ms", true)},
+		{search.NewWildcardQuery("*took*ms*", true)},
+		{search.NewWildcardQuery("*error*", false), search.NewWildcardQuery("*alice*", true)},
+		{search.NewWildcardQuery("*took 5 ms", true)},
+	}
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) {
+			t.Parallel()
+			writeLogMessages(t, args, messages)
+			assertAlternatingWildcardSearch(t, args, messages, querySets)
+		})
+	}
+}
+
+// assertAlternatingWildcardSearch checks that searching the IR at
+// args.filePath with a different query set for each successive match (cycling
+// through querySets) on a single Reader returns the baseline matches, through
+// both Reader.ReadToWildcardMatch and Reader.ReadToCompiledQueryMatch.
+func assertAlternatingWildcardSearch(
+	t *testing.T,
+	args testArgs,
+	messages []ffi.LogMessage,
+	querySets [][]search.WildcardQuery,
+) {
+	compiledQueries := make([]*search.CompiledQuery, len(querySets))
+	for i, queries := range querySets {
+		compiledQueries[i] = search.CompileWildcardQueries(queries)
+		defer compiledQueries[i].Close()
+	}
+	for _, compiled := range []bool{false, true} {
+		ioReader := openIoReader(t, args)
+		irReader, err := NewReader(ioReader)
+		if nil != err {
+			t.Fatalf("NewReader failed: %v", err)
+		}
+		next := 0
+		for step := 0; ; step++ {
+			set := step % len(querySets)
+			expectedMsg := -1
+			expectedQuery := -1
+			for i, queryIdx := range baselineMatches(messages[next:], querySets[set]) {
+				if -1 != queryIdx {
+					expectedMsg = next + i
+					expectedQuery = queryIdx
+					break
+				}
+			}
+
+			var log *ffi.LogEventView
+			var queryIdx int
+			if compiled {
+				log, queryIdx, err = irReader.ReadToCompiledQueryMatch(compiledQueries[set])
+			} else {
+				log, queryIdx, err = irReader.ReadToWildcardMatch(querySets[set])
+			}
+			if -1 == expectedMsg {
+				if EndOfIr != err {
+					t.Fatalf("search in %v found extra match '%v': %v", querySets[set], log, err)
+				}
+				break
+			}
+			if nil != err {
+				t.Fatalf("search in %v failed: %v", querySets[set], err)
+			}
+			if messages[expectedMsg] != log.LogMessageView || expectedQuery != queryIdx {
+				t.Fatalf(
+					"search in %v found '%v' (query %v) instead of '%v' (query %v)",
+					querySets[set],
+					log.LogMessageView,
+					queryIdx,
+					messages[expectedMsg],
+					expectedQuery,
+				)
+			}
+			next = expectedMsg + 1
+		}
+		irReader.Close()
+		ioReader.Close()
+	}
+}
+
+// letters returns i written in base 26 with the digits 'a' to 'z'.
+func letters(i int) string {
+	text := []byte{byte('a' + i%26)}
+	for i /= 26; 0 < i; i /= 26 {
+		text = append([]byte{byte('a' + i%26)}, text...)
+	}
+	return string(text)
+}
@@ -4,6 +4,7 @@ import (
 	"bytes"
 	"fmt"
 	"io"
+	"math"
 	"time"
 
 	"github.com/y-scope/clp-ffi-go/ffi"
@@ -13,10 +14,20 @@ import (
 // [NewWriter] will construct a Writer with the appropriate Serializer based on
 // the arguments used. Close must be called to free the underlying memory and
 // failure to do so will result in a memory leak. To write a complete IR stream
-// Close must be called before the final WriteTo call.
+// Close must be called before the final WriteTo call. offset is the number of
+// bytes of IR written into buf since the Writer was created, and index is
+// non-nil if an [Index] of the stream is being built (see EnableIndex). zstd is
+// non-nil if the IR is compressed before being stored in buf (see EnableZstd),
+// in which case offset counts uncompressed bytes. If serializerBuf is true
+// (see UseSerializerBuffer), log events are appended to the Serializer's
+// buffered IR, which logically follows the contents of buf.
 type Writer struct {
 	Serializer
-	buf bytes.Buffer
+	buf           bytes.Buffer
+	offset        int64
+	index         *indexBuilder
+	zstd          *zstdCompressor
+	serializerBuf bool
 }
 
 // Returns [NewWriterSize] with a FourByteEncoding Serializer using the local
@@ -30,13 +41,30 @@ func NewWriter() (*Writer, error) {
 // buffer to be written out later. The size parameter denotes the initial buffer
 // size to use and timeZoneId denotes the time zone of the source producing the
 // log events, so that local times (any time that is not a unix timestamp) are
-// handled correctly.
+// handled correctly. A FourByteEncoding stream uses the current time as its
+// reference timestamp (see [NewWriterSizeTimestamp]).
 //   - success: valid [*Writer], nil
 //   - error: nil [*Writer], invalid type error or an error propagated from
 //     [FourByteSerializer], [EightByteSerializer], or [bytes.Buffer.Write]
 func NewWriterSize[T EightByteEncoding | FourByteEncoding](
 	size int,
 	timeZoneId string,
+) (*Writer, error) {
+	return NewWriterSizeTimestamp[T](size, timeZoneId, ffi.EpochTimeMs(time.Now().UnixMilli()))
+}
+
+// NewWriterSizeTimestamp is [NewWriterSize] with an explicit reference
+// timestamp for a FourByteEncoding stream, which the first log event's
+// timestamp is encoded relative to (it is unused by EightByteEncoding).
+// Writing the same log events with the same arguments produces the same IR, as
+// nothing in the stream then depends on when it was written.
+//   - success: valid [*Writer], nil
+//   - error: nil [*Writer], invalid type error or an error propagated from
+//     [FourByteSerializer], [EightByteSerializer], or [bytes.Buffer.Write]
+func NewWriterSizeTimestamp[T EightByteEncoding | FourByteEncoding](
+	size int,
+	timeZoneId string,
+	referenceTimestamp ffi.EpochTimeMs,
 ) (*Writer, error) {
 	var irw Writer
 	irw.buf.Grow(size)
@@ -56,7 +84,7 @@ func NewWriterSize[T EightByteEncoding | FourByteEncoding](
 			"",
 			"",
 			timeZoneId,
-			ffi.EpochTimeMs(time.Now().UnixMilli()),
+			referenceTimestamp,
 		)
 	default:
 		err = fmt.Errorf("invalid type: %T", t)
@@ -64,18 +92,69 @@ func NewWriterSize[T EightByteEncoding | FourByteEncoding](
 	if nil != err {
 		return nil, err
 	}
-	_, err = irw.buf.Write(irView)
+	n, err := irw.buf.Write(irView)
 	if nil != err {
 		return nil, err
 	}
+	irw.offset += int64(n)
 	return &irw, nil
 }
 
+// EnableIndex starts building an [Index] of the IR stream, recording a
+// checkpoint before a log event whenever at least interval bytes of IR have
+// been written since the last checkpoint. Log events written by a single
+// WriteBatch call share a checkpoint at the start of the batch. The Index can
+// be retrieved using [Writer.Index] and should be stored alongside the stream
+// (e.g. as a sidecar file written using [Index.WriteTo]).
+func (writer *Writer) EnableIndex(interval int) {
+	builder := &indexBuilder{
+		interval:       int64(interval),
+		lastCheckpoint: writer.offset,
+		maxTimestamp:   math.MinInt64,
+	}
+	if irs, ok := writer.Serializer.(*fourByteSerializer); ok {
+		builder.lastTimestamp = irs.prevTimestamp
+	}
+	writer.index = builder
+}
+
+// Index returns the [Index] built so far, or nil if EnableIndex has not been
+// called. The Index remains owned by the Writer and is modified by subsequent
+// writes.
+func (writer *Writer) Index() *Index {
+	if nil == writer.index {
+		return nil
+	}
+	return &writer.index.index
+}
+
+// UseSerializerBuffer makes the Writer serialize log events straight into the
+// persistent buffer of its [Serializer] (see [Serializer.AppendLogEvent]),
+// rather than copying the IR of each log event into the Writer's own buffer.
+// The buffer grows as needed and keeps its capacity once written out, so a high
+// rate of log events can be written without a copy or allocation per log
+// event. The buffered IR is only viewed once it is written out (by WriteTo or
+// Bytes). It has no effect on a Writer compressing with zstd (see EnableZstd).
+func (writer *Writer) UseSerializerBuffer() {
+	writer.serializerBuf = true
+}
+
 // Close will write a null byte denoting the end of the IR stream and delete the
-// underlying C++ allocated memory used by the serializer. Failure to call Close
-// will result in a memory leak.
+// underlying C++ allocated memory used by the serializer. Any IR buffered by
+// the serializer is first moved into the Writer's buffer. If the Writer
+// compresses with zstd, the final frame is compressed into the buffer. Failure
+// to call Close will result in a memory leak.
 func (writer *Writer) Close() error {
-	writer.buf.WriteByte(0x0)
+	writer.takeSerializerBuf()
+	// The Serializer's buffer is freed below.
+	writer.serializerBuf = false
+	writer.write([]byte{0x0})
+	if nil != writer.zstd {
+		if err := writer.zstd.close(writer); nil != err {
+			writer.Serializer.Close()
+			return err
+		}
+	}
 	return writer.Serializer.Close()
 }
 
@@ -94,6 +173,10 @@ func (writer *Writer) CloseTo(w io.Writer) (int64, error) {
 // use only until the next buffer modification (that is, only until the next
 // call to Write, WriteTo, or Reset).
 func (writer *Writer) Bytes() []byte {
+	if writer.serializerBuf && 0 == writer.buf.Len() {
+		return writer.BufferedIr()
+	}
+	writer.takeSerializerBuf()
 	return writer.buf.Bytes()
 }
 
@@ -101,41 +184,138 @@ func (writer *Writer) Bytes() []byte {
 // for use by future writes.
 func (writer *Writer) Reset() {
 	writer.buf.Reset()
+	if writer.serializerBuf {
+		writer.ClearBufferedIr()
+	}
 }
 
 // Write uses [SerializeLogEvent] to serialize the provided log event to CLP IR
-// and then stores it in the internal buffer. Returns:
-//   - success: number of bytes written, nil
-//   - error: number of bytes written (can be 0), error propagated from
-//     [SerializeLogEvent] or [bytes.Buffer.Write]
+// and then stores it in the internal buffer (compressed if zstd is enabled).
+// Returns:
+//   - success: number of bytes of IR written, nil
+//   - error: number of bytes of IR written (can be 0), error propagated from
+//     [SerializeLogEvent], [bytes.Buffer.Write], or the zstd compressor
 func (writer *Writer) Write(event ffi.LogEvent) (int, error) {
+	if nil != writer.index {
+		writer.index.checkpoint(writer.offset)
+	}
+	if writer.appendsToSerializer() {
+		n, err := writer.AppendLogEvent(event)
+		if nil == err && nil != writer.index {
+			writer.index.add(event)
+		}
+		writer.offset += int64(n)
+		return n, err
+	}
 	irView, err := writer.SerializeLogEvent(event)
 	if nil != err {
 		return 0, err
 	}
+	if nil != writer.index {
+		writer.index.add(event)
+	}
 	// bytes.Buffer.Write will always return nil for err (https://pkg.go.dev/bytes#Buffer.Write)
 	// However, err is still propagated to correctly alert the user in case this ever changes. If
 	// Write can fail in the future, we should either:
 	//   1. fix the issue and retry the write
 	//   2. store irView and provide a retry API (allowing the user to fix the issue and retry)
-	n, err := writer.buf.Write(irView)
-	if nil != err {
+	return writer.write(irView)
+}
+
+// WriteBatch uses [SerializeLogEventBatch] to serialize all the provided log
+// events to CLP IR with a single call into C++ and then stores the result in
+// the internal buffer (compressed if zstd is enabled). Returns:
+//   - success: number of bytes of IR written, nil
+//   - error: number of bytes of IR written (can be 0), error propagated from
+//     [SerializeLogEventBatch], [bytes.Buffer.Write], or the zstd compressor
+func (writer *Writer) WriteBatch(events []ffi.LogEvent) (int, error) {
+	if 0 == len(events) {
+		return 0, nil
+	}
+	if nil != writer.index {
+		writer.index.checkpoint(writer.offset)
+	}
+	if writer.appendsToSerializer() {
+		n, err := writer.AppendLogEventBatch(events)
+		if nil == err && nil != writer.index {
+			writer.index.add(events...)
+		}
+		writer.offset += int64(n)
 		return n, err
 	}
-	return n, nil
+	irView, err := writer.SerializeLogEventBatch(events)
+	if nil != err {
+		return 0, err
+	}
+	if nil != writer.index {
+		writer.index.add(events...)
+	}
+	// See Write for why err is still propagated.
+	return writer.write(irView)
+}
+
+// write stores irView in the internal buffer, compressing it first if zstd is
+// enabled. Returns:
+//   - success: number of bytes of IR written, nil
+//   - error: number of bytes of IR written (can be 0), error propagated from
+//     [bytes.Buffer.Write] or the zstd compressor
+func (writer *Writer) write(irView BufView) (int, error) {
+	var n int
+	var err error
+	if nil != writer.zstd {
+		n, err = writer.zstd.write(writer, irView)
+	} else {
+		n, err = writer.buf.Write(irView)
+	}
+	writer.offset += int64(n)
+	return n, err
+}
+
+// appendsToSerializer returns whether log events are appended to the
+// Serializer's buffered IR (see UseSerializerBuffer).
+func (writer *Writer) appendsToSerializer() bool {
+	return writer.serializerBuf && nil == writer.zstd
+}
+
+// takeSerializerBuf moves any IR buffered by the Serializer to the end of the
+// Writer's buffer.
+func (writer *Writer) takeSerializerBuf() {
+	if !writer.serializerBuf {
+		return
+	}
+	if irView := writer.BufferedIr(); 0 < len(irView) {
+		writer.buf.Write(irView)
+		writer.ClearBufferedIr()
+	}
 }
 
 // WriteTo writes data to w until the buffer is drained or an error occurs. If
 // no error occurs the buffer is reset. On an error the user is expected to use
 // [writer.Bytes] and [writer.Reset] to manually handle the buffer's contents before
-// continuing. Returns:
+// continuing. IR buffered by the Serializer (see UseSerializerBuffer) is
+// written to w directly from the Serializer's buffer. Returns:
 //   - success: number of bytes written, nil
 //   - error: number of bytes written, error propagated from
-//     [bytes.Buffer.WriteTo]
+//     [bytes.Buffer.WriteTo] or [io.Writer.Write]
 func (writer *Writer) WriteTo(w io.Writer) (int64, error) {
 	n, err := writer.buf.WriteTo(w)
-	if nil == err {
-		writer.buf.Reset()
+	if nil != err {
+		return n, err
+	}
+	writer.buf.Reset()
+	if !writer.serializerBuf {
+		return n, nil
+	}
+	irView := writer.BufferedIr()
+	if 0 == len(irView) {
+		return n, nil
+	}
+	m, err := w.Write(irView)
+	n += int64(m)
+	if nil != err {
+		// Keep the unwritten IR in the Writer's buffer for the user to handle.
+		writer.buf.Write(irView[m:])
 	}
+	writer.ClearBufferedIr()
 	return n, err
 }
@@ -1,13 +1,158 @@
 package ir
 
 import (
+	"bytes"
+	"fmt"
 	"io"
+	"os"
+	"strings"
 	"testing"
 	"time"
 
 	"github.com/y-scope/clp-ffi-go/ffi"
+	"github.com/y-scope/clp-ffi-go/search"
 )
 
+func TestReadToWildcardMatch(t *testing.T) {
+	messages := []ffi.LogMessage{
+		"static text dict=var notint123 -1.234 4321.",
+		"INFO request id=abc123 took 12 ms",
+		"ERROR request id=def456 failed after 3 retries",
+		"warn: disk usage at 93.5 percent",
+		"ERROR disk usage at 99.9 percent",
+	}
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*disk usage at 9?.? percent", true),
+		search.NewWildcardQuery("*error*", false),
+		search.NewWildcardQuery("*id=*1?3*", true),
+	}
+	// Index of the first query in queries matching each message (-1 for none).
+	expected := []int{-1, 2, 1, 0, 0}
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) {
+			t.Parallel()
+			testReadToWildcardMatch(t, args, messages, queries, expected)
+		})
+	}
+}
+
+func testReadToWildcardMatch(
+	t *testing.T,
+	args testArgs,
+	messages []ffi.LogMessage,
+	queries []search.WildcardQuery,
+	expected []int,
+) {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+	for _, msg := range messages {
+		event := ffi.LogEvent{
+			LogMessage: msg,
+			Timestamp:  ffi.EpochTimeMs(time.Now().UnixMilli()),
+		}
+		if _, err := irWriter.Write(event); nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+	}
+	if counters, enabled := irWriter.Counters(); enabled &&
+		uint64(len(messages)) != counters.EventsSerialized {
+		t.Fatalf(
+			"Serializer.Counters wrong EventsSerialized: %v != %v",
+			counters.EventsSerialized,
+			len(messages),
+		)
+	}
+	if _, err := irWriter.CloseTo(ioWriter); nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	irReader, err := NewReader(ioReader)
+	if nil != err {
+		t.Fatalf("NewReader failed: %v", err)
+	}
+	defer irReader.Close()
+
+	for i, msg := range messages {
+		if -1 == expected[i] {
+			continue
+		}
+		log, queryIdx, err := irReader.ReadToWildcardMatch(queries)
+		if nil != err {
+			t.Fatalf("Reader.ReadToWildcardMatch failed: %v", err)
+		}
+		if msg != log.LogMessageView {
+			t.Fatalf(
+				"Reader.ReadToWildcardMatch wrong message: '%v' != '%v'",
+				log.LogMessageView,
+				msg,
+			)
+		}
+		if expected[i] != queryIdx {
+			t.Fatalf("Reader.ReadToWildcardMatch wrong query: %v != %v", queryIdx, expected[i])
+		}
+	}
+	if _, _, err = irReader.ReadToWildcardMatch(queries); EndOfIr != err {
+		t.Fatalf("Reader.ReadToWildcardMatch end of IR failed got: %v", err)
+	}
+	assertSearchCounters(t, irReader, messages, expected)
+
+	compiledQuery := search.CompileWildcardQueries(queries)
+	defer compiledQuery.Close()
+	for i, msg := range messages {
+		if queryIdx, _ := compiledQuery.Match(string(msg)); expected[i] != queryIdx {
+			t.Fatalf("CompiledQuery.Match wrong query: %v != %v", queryIdx, expected[i])
+		}
+	}
+
+	compiledIoReader := openIoReader(t, args)
+	defer compiledIoReader.Close()
+	compiledIrReader, err := NewReader(compiledIoReader)
+	if nil != err {
+		t.Fatalf("NewReader failed: %v", err)
+	}
+	defer compiledIrReader.Close()
+
+	// A nil CompiledQuery is rejected without consuming any log event.
+	var nilQuery *search.CompiledQuery
+	if _, ok := nilQuery.Match(string(messages[0])); ok || 0 != nilQuery.Len() {
+		t.Fatalf("nil CompiledQuery matched or has queries")
+	}
+	if _, _, err = compiledIrReader.ReadToCompiledQueryMatch(nilQuery); CorruptedIr != err {
+		t.Fatalf("Reader.ReadToCompiledQueryMatch(nil): %v != %v", err, CorruptedIr)
+	}
+
+	for i, msg := range messages {
+		if -1 == expected[i] {
+			continue
+		}
+		log, queryIdx, err := compiledIrReader.ReadToCompiledQueryMatch(compiledQuery)
+		if nil != err {
+			t.Fatalf("Reader.ReadToCompiledQueryMatch failed: %v", err)
+		}
+		if msg != log.LogMessageView {
+			t.Fatalf(
+				"Reader.ReadToCompiledQueryMatch wrong message: '%v' != '%v'",
+				log.LogMessageView,
+				msg,
+			)
+		}
+		if expected[i] != queryIdx {
+			t.Fatalf(
+				"Reader.ReadToCompiledQueryMatch wrong query: %v != %v",
+				queryIdx,
+				expected[i],
+			)
+		}
+	}
+	if _, _, err = compiledIrReader.ReadToCompiledQueryMatch(compiledQuery); EndOfIr != err {
+		t.Fatalf("Reader.ReadToCompiledQueryMatch end of IR failed got: %v", err)
+	}
+}
+
 func testWriteReadLogMessages(
 	t *testing.T,
 	args testArgs,
@@ -48,6 +193,874 @@ func testWriteReadLogMessages(
 	assertEndOfIr(t, ioReader, irReader)
 }
 
+func TestReadToEpochTime(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testReadToEpochTime(t, args) })
+	}
+}
+
+func testReadToEpochTime(t *testing.T, args testArgs) {
+	const numEvents int = 200
+	events := newTestEvents(numEvents, 1000)
+	writeTestEvents(t, args, events, 0)
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	// A small buffer forces log events to be skipped across many refills.
+	irReader, err := NewReaderSize(ioReader, 256)
+	if nil != err {
+		t.Fatalf("NewReaderSize failed: %v", err)
+	}
+	defer irReader.Close()
+
+	target := events[numEvents/2]
+	log, err := irReader.ReadToEpochTime(target.Timestamp - 500)
+	if nil != err {
+		t.Fatalf("Reader.ReadToEpochTime failed: %v", err)
+	}
+	if target.Timestamp != log.Timestamp || target.LogMessage != log.LogMessageView {
+		t.Fatalf("Reader.ReadToEpochTime wrong event: '%v' != '%v'", *log, target)
+	}
+	for _, event := range events[numEvents/2+1:] {
+		assertIrLogEvent(t, nil, irReader, event)
+	}
+	assertEndOfIr(t, nil, irReader)
+}
+
+func TestReadToWildcardMatchTimeWindows(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) {
+			t.Parallel()
+			testReadToWildcardMatchTimeWindows(t, args)
+		})
+	}
+}
+
+// Searches consecutive time windows, each containing one matching log event, to
+// check that a search ending at its time interval resumes from the first log
+// event after it (with the right timestamp) instead of from the last match.
+func testReadToWildcardMatchTimeWindows(t *testing.T, args testArgs) {
+	const numEvents int = 200
+	const windowSize int = 10
+	events := newTestEvents(numEvents, 1000)
+	writeTestEvents(t, args, events, 0)
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	// A small buffer forces rejected log events to be consumed across refills.
+	irReader, err := NewReaderSize(ioReader, 256)
+	if nil != err {
+		t.Fatalf("NewReaderSize failed: %v", err)
+	}
+	defer irReader.Close()
+
+	queries := []search.WildcardQuery{search.NewWildcardQuery("*dict=var*5 *", true)}
+	for i := 0; i < numEvents; i += windowSize {
+		interval := search.TimestampInterval{
+			Lower: events[i].Timestamp,
+			Upper: events[i].Timestamp + ffi.EpochTimeMs(windowSize*1000),
+		}
+		expected := events[i+windowSize/2]
+		log, _, err := irReader.ReadToWildcardMatchWithTimeInterval(queries, interval)
+		if nil != err {
+			t.Fatalf("Reader.ReadToWildcardMatchWithTimeInterval failed: %v", err)
+		}
+		if expected.Timestamp != log.Timestamp || expected.LogMessage != log.LogMessageView {
+			t.Fatalf(
+				"Reader.ReadToWildcardMatchWithTimeInterval wrong event: '%v' != '%v'",
+				*log,
+				expected,
+			)
+		}
+		_, _, err = irReader.ReadToWildcardMatchWithTimeInterval(queries, interval)
+		if QueryNotFound != err {
+			t.Fatalf(
+				"Reader.ReadToWildcardMatchWithTimeInterval end of interval failed got: %v",
+				err,
+			)
+		}
+	}
+	if _, _, err = irReader.ReadToWildcardMatch(queries); EndOfIr != err {
+		t.Fatalf("Reader.ReadToWildcardMatch end of IR failed got: %v", err)
+	}
+	// Each log event is only read once, whether it was rejected, matched, or
+	// ended a time interval (which leaves it unconsumed).
+	counters, enabled := irReader.Counters()
+	if enabled && uint64(numEvents) != counters.EventsDeserialized {
+		t.Fatalf(
+			"Deserializer.Counters log events read again: EventsDeserialized %v != %v",
+			counters.EventsDeserialized,
+			numEvents,
+		)
+	}
+}
+
+func TestReaderBufferSize(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testReaderBufferSize(t, args) })
+	}
+}
+
+// Reads a stream with a single log event far larger than the Reader's buffer,
+// checking that the buffer shrinks back to its initial size afterwards, and
+// that a Reader with a maximum buffer size fails to read the log event.
+func testReaderBufferSize(t *testing.T, args testArgs) {
+	const numEvents int = 10000
+	const outlierIdx int = 100
+	events := newTestEvents(numEvents, 1)
+	events[outlierIdx].LogMessage = ffi.LogMessage("outlier " + strings.Repeat("x", 64*1024))
+	writeTestEvents(t, args, events, 0)
+
+	const bufSize int = 256
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	irReader, err := NewReaderSize(ioReader, bufSize)
+	if nil != err {
+		t.Fatalf("NewReaderSize failed: %v", err)
+	}
+	defer irReader.Close()
+	for i, event := range events {
+		assertIrLogEvent(t, nil, irReader, event)
+		if outlierIdx == i && bufSize >= len(irReader.buf) {
+			t.Fatalf("Reader buffer did not grow: %v", len(irReader.buf))
+		}
+	}
+	assertEndOfIr(t, nil, irReader)
+	if bufSize != len(irReader.buf) {
+		t.Fatalf("Reader buffer did not shrink: %v != %v", len(irReader.buf), bufSize)
+	}
+
+	limitedIoReader := openIoReader(t, args)
+	defer limitedIoReader.Close()
+	limitedIrReader, err := NewReaderSize(limitedIoReader, bufSize)
+	if nil != err {
+		t.Fatalf("NewReaderSize failed: %v", err)
+	}
+	defer limitedIrReader.Close()
+	limitedIrReader.SetMaxBufferSize(16 * bufSize)
+	for _, event := range events[:outlierIdx] {
+		assertIrLogEvent(t, nil, limitedIrReader, event)
+	}
+	if _, err = limitedIrReader.Read(); ErrBufferFull != err {
+		t.Fatalf("Reader.Read with maximum buffer size got: %v", err)
+	}
+	if 16*bufSize < len(limitedIrReader.buf) {
+		t.Fatalf("Reader buffer grew past maximum: %v", len(limitedIrReader.buf))
+	}
+}
+
+func TestSeekToTime(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		if noCompression != args.compression {
+			continue
+		}
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testSeekToTime(t, args) })
+	}
+}
+
+func testSeekToTime(t *testing.T, args testArgs) {
+	const numEvents int = 100
+	events := newTestEvents(numEvents, 10)
+	writtenIndex := writeTestEvents(t, args, events, 64)
+
+	var indexBuf bytes.Buffer
+	if _, err := writtenIndex.WriteTo(&indexBuf); nil != err {
+		t.Fatalf("Index.WriteTo failed: %v", err)
+	}
+	index, err := ReadIndex(&indexBuf)
+	if nil != err {
+		t.Fatalf("ReadIndex failed: %v", err)
+	}
+	if 2 > len(index.Checkpoints) {
+		t.Fatalf("Index has too few checkpoints: %v", len(index.Checkpoints))
+	}
+
+	target := events[numEvents*3/4]
+	for _, useMmap := range []bool{false, true} {
+		var irReader *Reader
+		if useMmap {
+			irReader, err = NewMmapReader(args.filePath)
+			if ErrMmapUnsupported == err {
+				continue
+			}
+		} else {
+			ioReader := openIoReader(t, args)
+			defer ioReader.Close()
+			irReader, err = NewReader(ioReader)
+		}
+		if nil != err {
+			t.Fatalf("NewReader failed: %v", err)
+		}
+		defer irReader.Close()
+
+		if err := irReader.SeekToTime(index, target.Timestamp); nil != err {
+			t.Fatalf("Reader.SeekToTime failed: %v", err)
+		}
+		log, err := irReader.ReadToEpochTime(target.Timestamp)
+		if nil != err {
+			t.Fatalf("Reader.ReadToEpochTime failed: %v", err)
+		}
+		if target.Timestamp != log.Timestamp || target.LogMessage != log.LogMessageView {
+			t.Fatalf("Reader.ReadToEpochTime wrong event: '%v' != '%v'", *log, target)
+		}
+		for _, event := range events[numEvents*3/4+1:] {
+			assertIrLogEvent(t, nil, irReader, event)
+		}
+		assertEndOfIr(t, nil, irReader)
+	}
+}
+
+func TestReadParallel(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		if noCompression != args.compression {
+			continue
+		}
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testReadParallel(t, args) })
+	}
+}
+
+func testReadParallel(t *testing.T, args testArgs) {
+	const numEvents int = 500
+	events := newTestEvents(numEvents, 10)
+	for i := range events {
+		// Timestamps are not monotonic to check each chunk's reference timestamp.
+		events[i].Timestamp -= ffi.EpochTimeMs((i % 3) * 25)
+	}
+	index := writeTestEvents(t, args, events, 128)
+	if 8 > len(index.Checkpoints) {
+		t.Fatalf("Index has too few checkpoints: %v", len(index.Checkpoints))
+	}
+
+	for _, numThreads := range []int{1, 3, 0} {
+		irReader, err := NewMmapReader(args.filePath)
+		if ErrMmapUnsupported == err {
+			t.Skip(err)
+		}
+		if nil != err {
+			t.Fatalf("NewMmapReader failed: %v", err)
+		}
+		defer irReader.Close()
+
+		next := 0
+		for {
+			logs, err := irReader.ReadParallel(index, numThreads)
+			if EndOfIr == err {
+				break
+			}
+			if nil != err {
+				t.Fatalf("Reader.ReadParallel failed: %v", err)
+			}
+			for _, log := range logs {
+				if numEvents <= next {
+					t.Fatalf("Reader.ReadParallel unexpected event: '%v'", log)
+				}
+				event := events[next]
+				next++
+				if event.Timestamp != log.Timestamp || event.LogMessage != log.LogMessageView {
+					t.Fatalf("Reader.ReadParallel wrong event: '%v' != '%v'", log, event)
+				}
+			}
+		}
+		if numEvents != next {
+			t.Fatalf("Reader.ReadParallel events: %v != %v", next, numEvents)
+		}
+	}
+}
+
+func TestReadColumns(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testReadColumns(t, args) })
+	}
+}
+
+func testReadColumns(t *testing.T, args testArgs) {
+	const numEvents int = 100
+	events := newTestEvents(numEvents, 10)
+	for i := range events {
+		switch i % 3 {
+		case 0:
+			events[i].LogMessage = ffi.LogMessage(fmt.Sprintf("INFO request %v took %v ms", i, i*3))
+		case 1:
+			events[i].LogMessage = ffi.LogMessage(fmt.Sprintf("ERROR request %v failed", i))
+		default:
+			events[i].LogMessage = ""
+		}
+	}
+	writeTestEvents(t, args, events, 0)
+
+	compiledQuery := search.CompileWildcardQueries([]search.WildcardQuery{
+		search.NewWildcardQuery("*failed*", true),
+		search.NewWildcardQuery("*took ?? ms*", true),
+	})
+	defer compiledQuery.Close()
+	for _, options := range []LogEventColumnsOptions{
+		{},
+		{CompiledQuery: compiledQuery, LogtypeIds: true},
+	} {
+		ioReader := openIoReader(t, args)
+		defer ioReader.Close()
+		irReader, err := NewReader(ioReader)
+		if nil != err {
+			t.Fatalf("NewReader failed: %v", err)
+		}
+		defer irReader.Close()
+
+		next := 0
+		logtypeIds := map[int64]int{}
+		for {
+			columns, err := irReader.ReadColumns(7, options)
+			if EndOfIr == err {
+				break
+			}
+			if nil != err {
+				t.Fatalf("Reader.ReadColumns failed: %v", err)
+			}
+			if 0 == columns.Len() || 7 < columns.Len() ||
+				columns.Len()+1 != len(columns.MessageOffsets) ||
+				0 != columns.MessageOffsets[0] ||
+				int64(len(columns.MessageData)) != columns.MessageOffsets[columns.Len()] {
+				t.Fatalf("Reader.ReadColumns malformed columns: %+v", columns)
+			}
+			for i := 0; i < columns.Len(); i++ {
+				queryIdx := 0
+				if nil != options.CompiledQuery {
+					for ; numEvents > next; next++ {
+						idx, ok := compiledQuery.Match(string(events[next].LogMessage))
+						if ok {
+							queryIdx = idx
+							break
+						}
+					}
+				}
+				if numEvents <= next {
+					t.Fatalf("Reader.ReadColumns unexpected event: %v", columns.LogMessage(i))
+				}
+				event := events[next]
+				next++
+				if event.Timestamp != columns.Timestamps[i] ||
+					string(event.LogMessage) != columns.LogMessage(i) {
+					t.Fatalf(
+						"Reader.ReadColumns wrong event: '%v' '%v' != '%v'",
+						columns.Timestamps[i],
+						columns.LogMessage(i),
+						event,
+					)
+				}
+				if nil == options.CompiledQuery {
+					if 0 != len(columns.MatchingQueries) || 0 != len(columns.LogtypeIds) {
+						t.Fatalf("Reader.ReadColumns unrequested columns: %+v", columns)
+					}
+					continue
+				}
+				if int64(queryIdx) != columns.MatchingQueries[i] {
+					t.Fatalf(
+						"Reader.ReadColumns wrong query: %v != %v",
+						columns.MatchingQueries[i],
+						queryIdx,
+					)
+				}
+				// Messages only share a logtype if they are the same kind.
+				kind := (next - 1) % 3
+				if prevKind, ok := logtypeIds[columns.LogtypeIds[i]]; ok && kind != prevKind {
+					t.Fatalf("Reader.ReadColumns shared logtype id: %v", columns.LogtypeIds[i])
+				}
+				logtypeIds[columns.LogtypeIds[i]] = kind
+			}
+		}
+		if nil != options.CompiledQuery {
+			for ; numEvents > next; next++ {
+				if _, ok := compiledQuery.Match(string(events[next].LogMessage)); ok {
+					break
+				}
+			}
+		}
+		if numEvents != next {
+			t.Fatalf("Reader.ReadColumns events: %v != %v", next, numEvents)
+		}
+	}
+}
+
+func TestReadMatchCounts(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testReadMatchCounts(t, args) })
+	}
+}
+
+func testReadMatchCounts(t *testing.T, args testArgs) {
+	const numEvents int = 200
+	events := newTestEvents(numEvents, 1000)
+	start := events[0].Timestamp
+	for i := range events {
+		var msg string
+		switch i % 3 {
+		case 0:
+			msg = fmt.Sprintf("INFO request %v took %v ms", i, i*3)
+		case 1:
+			msg = fmt.Sprintf("ERROR request %v failed", i)
+		default:
+			msg = fmt.Sprintf("error: request %v took %v.5 ms", i, i)
+		}
+		events[i].LogMessage = ffi.LogMessage(msg)
+	}
+	writeTestEvents(t, args, events, 0)
+
+	queries := []search.WildcardQuery{
+		search.NewWildcardQuery("*ERROR*", false),
+		search.NewWildcardQuery("*request 1?? *", true),
+		search.NewWildcardQuery("*took*ms", true),
+	}
+	compiledQuery := search.CompileWildcardQueries(queries)
+	defer compiledQuery.Close()
+
+	// The buckets cover [20s, 140s) of the stream, so counting skips the
+	// log events before them and stops at the first log event after them.
+	counts := NewMatchCounts(len(queries), start+20000, 60000, 2)
+	expected := make([]int64, len(counts.Counts))
+	for q, query := range queries {
+		singleQuery := search.CompileWildcardQueries([]search.WildcardQuery{query})
+		defer singleQuery.Close()
+		for _, event := range events {
+			interval := counts.TimeInterval()
+			if event.Timestamp < interval.Lower || event.Timestamp >= interval.Upper {
+				continue
+			}
+			if _, ok := singleQuery.Match(string(event.LogMessage)); ok {
+				bucket := int((event.Timestamp - counts.Start) / counts.BucketWidth)
+				expected[q*counts.NumBuckets+bucket]++
+			}
+		}
+	}
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	irReader, err := NewReader(ioReader)
+	if nil != err {
+		t.Fatalf("NewReader failed: %v", err)
+	}
+	defer irReader.Close()
+
+	if err := irReader.ReadMatchCounts(compiledQuery, counts); nil != err {
+		t.Fatalf("Reader.ReadMatchCounts failed: %v", err)
+	}
+	for i, count := range counts.Counts {
+		if expected[i] != count {
+			t.Fatalf("Reader.ReadMatchCounts wrong counts: %v != %v", counts.Counts, expected)
+		}
+	}
+	log, err := irReader.Read()
+	if nil != err {
+		t.Fatalf("Reader.Read failed: %v", err)
+	}
+	if events[140].Timestamp != log.Timestamp ||
+		events[140].LogMessage != log.LogMessageView {
+		t.Fatalf("Reader.Read wrong event after counting: '%v' != '%v'", log, events[140])
+	}
+}
+
+func TestReadToNumericQueryMatch(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testReadToNumericQueryMatch(t, args) })
+	}
+}
+
+func testReadToNumericQueryMatch(t *testing.T, args testArgs) {
+	const numEvents int = 200
+	// Latencies CLP can't encode are stored as dictionary variables, which are
+	// only numbers if they're decimal (so not "1e3").
+	dictLatencies := []string{"12345678901234567890", "1e3"}
+	events := newTestEvents(numEvents+len(dictLatencies), 1)
+	var expected []ffi.LogEvent
+	for i := range events {
+		var msg string
+		var latency float64
+		switch {
+		case numEvents <= i:
+			msg = fmt.Sprintf("INFO request 1 took %v ms", dictLatencies[i-numEvents])
+			if numEvents == i {
+				latency = 12345678901234567890
+			}
+		case 0 == i%3:
+			msg = fmt.Sprintf("INFO request %v took %v ms", i, i*3)
+			latency = float64(i * 3)
+		case 1 == i%3:
+			msg = fmt.Sprintf("ERROR request %v failed after %v ms", i, i*5)
+			latency = -1
+		default:
+			msg = fmt.Sprintf("error: request %v took %v.5 ms", i, i)
+			latency = float64(i) + 0.5
+		}
+		events[i].LogMessage = ffi.LogMessage(msg)
+		if 150 <= latency && (i < 190 || numEvents <= i) {
+			expected = append(expected, events[i])
+		}
+	}
+	writeTestEvents(t, args, events, 0)
+
+	if _, err := search.NewNumericQuery(
+		search.NewWildcardQuery("*", true),
+		[]search.NumericPredicate{{VarIndex: 0, Comparison: search.GreaterThan + 1}},
+	); search.ErrInvalidNumericPredicate != err {
+		t.Fatalf("NewNumericQuery accepted an invalid predicate: %v", err)
+	}
+	// The logtype query only matches the "took" messages (with a variable
+	// before " ms"), and the predicates compare their request number (an
+	// integer) and latency (an integer or a float).
+	numericQuery, err := search.NewNumericQuery(
+		search.NewWildcardQuery("*took * ms", true),
+		[]search.NumericPredicate{
+			{VarIndex: 1, Comparison: search.GreaterOrEqual, Value: 150},
+			{VarIndex: 0, Comparison: search.LessThan, Value: 190},
+		},
+	)
+	if nil != err {
+		t.Fatalf("NewNumericQuery failed: %v", err)
+	}
+	defer numericQuery.Close()
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	irReader, err := NewReader(ioReader)
+	if nil != err {
+		t.Fatalf("NewReader failed: %v", err)
+	}
+	defer irReader.Close()
+
+	for _, event := range expected {
+		log, err := irReader.ReadToNumericQueryMatch(numericQuery)
+		if nil != err {
+			t.Fatalf("Reader.ReadToNumericQueryMatch failed: %v", err)
+		}
+		if event.Timestamp != log.Timestamp || event.LogMessage != log.LogMessageView {
+			t.Fatalf("Reader.ReadToNumericQueryMatch wrong event: '%v' != '%v'", log, event)
+		}
+	}
+	if _, err := irReader.ReadToNumericQueryMatch(numericQuery); EndOfIr != err {
+		t.Fatalf("Reader.ReadToNumericQueryMatch found an extra match: %v", err)
+	}
+}
+
+func TestWriteSerializerBuffer(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testWriteSerializerBuffer(t, args) })
+	}
+}
+
+func testWriteSerializerBuffer(t *testing.T, args testArgs) {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+	irWriter.UseSerializerBuffer()
+
+	const numEvents int = 1000
+	start := ffi.EpochTimeMs(time.Now().UnixMilli())
+	var events []ffi.LogEvent
+	for i := 0; i < numEvents; i++ {
+		events = append(events, ffi.LogEvent{
+			LogMessage: ffi.LogMessage(fmt.Sprintf("event %v id=%v value %v.5", i, i*7, i)),
+			Timestamp:  start + ffi.EpochTimeMs(i),
+		})
+	}
+	for i := 0; i < numEvents; {
+		// Alternate between single log events and batches, writing out the
+		// buffered IR every so often.
+		var err error
+		if 0 == i%2 {
+			_, err = irWriter.Write(events[i])
+			i++
+		} else {
+			end := min(i+7, numEvents)
+			_, err = irWriter.WriteBatch(events[i:end])
+			i = end
+		}
+		if nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+		if 0 == i%50 {
+			if _, err := irWriter.WriteTo(ioWriter); nil != err {
+				t.Fatalf("ir.Writer.WriteTo failed: %v", err)
+			}
+		}
+	}
+	if _, err := irWriter.CloseTo(ioWriter); nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	irReader, err := NewReader(ioReader)
+	if nil != err {
+		t.Fatalf("NewReader failed: %v", err)
+	}
+	defer irReader.Close()
+	for _, event := range events {
+		assertIrLogEvent(t, ioReader, irReader, event)
+	}
+	assertEndOfIr(t, ioReader, irReader)
+}
+
+func TestWriteZstd(t *testing.T) {
+	for _, args := range generateTestArgs(t, t.Name()) {
+		if zstdCompression != args.compression {
+			continue
+		}
+		args := args // capture range variable for func literal
+		t.Run(args.name, func(t *testing.T) { t.Parallel(); testWriteZstd(t, args) })
+	}
+}
+
+func testWriteZstd(t *testing.T, args testArgs) {
+	// The file is written uncompressed as the Writer compresses the IR itself.
+	file, err := os.Create(args.filePath)
+	if nil != err {
+		t.Fatalf("os.Create failed: %v", err)
+	}
+	irWriter := openIrWriter(t, args, file)
+	if err := irWriter.EnableZstd(3, 1024); nil != err {
+		t.Fatalf("Writer.EnableZstd failed: %v", err)
+	}
+
+	const numEvents int = 1000
+	start := ffi.EpochTimeMs(time.Now().UnixMilli())
+	var events []ffi.LogEvent
+	for i := 0; i < numEvents; i++ {
+		event := ffi.LogEvent{
+			LogMessage: ffi.LogMessage(fmt.Sprintf("event %v id=%v value %v.5", i, i*7, i)),
+			Timestamp:  start + ffi.EpochTimeMs(i),
+		}
+		if _, err := irWriter.Write(event); nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+		events = append(events, event)
+		// Write out the completed frames as they become available.
+		if 0 == i%100 {
+			if _, err := irWriter.WriteTo(file); nil != err {
+				t.Fatalf("ir.Writer.WriteTo failed: %v", err)
+			}
+		}
+	}
+	if _, err := irWriter.CloseTo(file); nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	file.Close()
+
+	compressed, err := os.ReadFile(args.filePath)
+	if nil != err {
+		t.Fatalf("os.ReadFile failed: %v", err)
+	}
+	frames := irWriter.ZstdFrames()
+	if 2 > len(frames) {
+		t.Fatalf("Writer.ZstdFrames too few frames: %v", len(frames))
+	}
+	last := frames[len(frames)-1]
+	if int64(len(compressed)) != last.CompressedOffset+last.CompressedSize {
+		t.Fatalf("Writer.ZstdFrames wrong compressed size: %v", last)
+	}
+
+	// Every frame must decompress on its own into its part of the stream.
+	decoder, err := newZstdReader(bytes.NewReader(compressed))
+	if nil != err {
+		t.Fatalf("zstd.NewReader failed: %v", err)
+	}
+	uncompressed, err := io.ReadAll(decoder)
+	decoder.Close()
+	if nil != err {
+		t.Fatalf("zstd.Decoder.Read failed: %v", err)
+	}
+	for _, frame := range frames {
+		frameBuf := compressed[frame.CompressedOffset : frame.CompressedOffset+frame.CompressedSize]
+		decoder, err := newZstdReader(bytes.NewReader(frameBuf))
+		if nil != err {
+			t.Fatalf("zstd.NewReader failed: %v", err)
+		}
+		ir, err := io.ReadAll(decoder)
+		decoder.Close()
+		if nil != err {
+			t.Fatalf("zstd.Decoder.Read failed: %v", err)
+		}
+		if !bytes.Equal(uncompressed[frame.Offset:frame.Offset+frame.Size], ir) {
+			t.Fatalf("ZstdFrame decompressed wrong IR: %v", frame)
+		}
+	}
+
+	irReader, err := NewZstdReader(bytes.NewReader(compressed))
+	if nil != err {
+		t.Fatalf("NewZstdReader failed: %v", err)
+	}
+	defer irReader.Close()
+	for _, event := range events {
+		assertIrLogEvent(t, nil, irReader, event)
+	}
+	assertEndOfIr(t, nil, irReader)
+}
+
+func testWriteReadMmapLogMessages(
+	t *testing.T,
+	args testArgs,
+	messages []ffi.LogMessage,
+) {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+
+	var events []ffi.LogEvent
+	for _, msg := range messages {
+		event := ffi.LogEvent{
+			LogMessage: msg,
+			Timestamp:  ffi.EpochTimeMs(time.Now().UnixMilli()),
+		}
+		_, err := irWriter.Write(event)
+		if nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+		events = append(events, event)
+	}
+	_, err := irWriter.CloseTo(ioWriter)
+	if nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+
+	irReader, err := NewMmapReaderPrefetch(args.filePath, 4096)
+	if ErrMmapUnsupported == err {
+		t.Skip(err)
+	}
+	if nil != err {
+		t.Fatalf("NewMmapReaderPrefetch failed: %v", err)
+	}
+	defer irReader.Close()
+
+	for _, event := range events {
+		assertIrLogEvent(t, nil, irReader, event)
+	}
+	assertEndOfIr(t, nil, irReader)
+}
+
+func testWriteReadZstdLogMessages(
+	t *testing.T,
+	args testArgs,
+	messages []ffi.LogMessage,
+) {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+
+	var events []ffi.LogEvent
+	for _, msg := range messages {
+		event := ffi.LogEvent{
+			LogMessage: msg,
+			Timestamp:  ffi.EpochTimeMs(time.Now().UnixMilli()),
+		}
+		_, err := irWriter.Write(event)
+		if nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+		events = append(events, event)
+	}
+	_, err := irWriter.CloseTo(ioWriter)
+	if nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+
+	file, err := os.Open(args.filePath)
+	if nil != err {
+		t.Fatalf("os.Open failed: %v", err)
+	}
+	defer file.Close()
+	// A small buffer forces the decompressed stream to be read in many parts.
+	irReader, err := NewZstdReaderSize(file, 256)
+	if nil != err {
+		t.Fatalf("NewZstdReaderSize failed: %v", err)
+	}
+	defer irReader.Close()
+
+	for _, event := range events {
+		assertIrLogEvent(t, nil, irReader, event)
+	}
+	assertEndOfIr(t, nil, irReader)
+}
+
+func testWriteReadBatchLogMessages(
+	t *testing.T,
+	args testArgs,
+	messages []ffi.LogMessage,
+) {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+
+	var events []ffi.LogEvent
+	for _, msg := range messages {
+		event := ffi.LogEvent{
+			LogMessage: msg,
+			Timestamp:  ffi.EpochTimeMs(time.Now().UnixMilli()),
+		}
+		events = append(events, event)
+	}
+	// Write in two batches to exercise the timestamp state between calls.
+	half := len(events) / 2
+	for _, batch := range [][]ffi.LogEvent{events[:half], events[half:]} {
+		_, err := irWriter.WriteBatch(batch)
+		if nil != err {
+			t.Fatalf("ir.Writer.WriteBatch failed: %v", err)
+		}
+	}
+	_, err := irWriter.CloseTo(ioWriter)
+	if nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+
+	ioReader := openIoReader(t, args)
+	defer ioReader.Close()
+	irReader, err := NewReader(ioReader)
+	if nil != err {
+		t.Fatalf("NewReader failed: %v", err)
+	}
+	defer irReader.Close()
+
+	// Use a batch smaller than the number of events to exercise multiple calls.
+	batch := make([]ffi.LogEventView, 1+len(events)/2)
+	var numRead int
+	for numRead < len(events) {
+		n, err := irReader.ReadBatch(batch)
+		if nil != err {
+			t.Fatalf("Reader.ReadBatch failed: %v", err)
+		}
+		if 0 == n || numRead+n > len(events) {
+			t.Fatalf("Reader.ReadBatch wrong number of events: %v", n)
+		}
+		for i, log := range batch[:n] {
+			event := events[numRead+i]
+			if event.Timestamp != log.Timestamp {
+				t.Fatalf(
+					"Reader.ReadBatch wrong timestamp: '%v' != '%v'",
+					log.Timestamp,
+					event.Timestamp,
+				)
+			}
+			if event.LogMessage != log.LogMessageView {
+				t.Fatalf(
+					"Reader.ReadBatch wrong message: '%v' != '%v'",
+					log.LogMessageView,
+					event.LogMessage,
+				)
+			}
+		}
+		numRead += n
+	}
+	_, err = irReader.ReadBatch(batch)
+	if EndOfIr != err {
+		t.Fatalf("Reader.ReadBatch end of IR failed got: %v", err)
+	}
+}
+
 func openIrWriter(
 	t *testing.T,
 	args testArgs,
@@ -68,3 +1081,81 @@ func openIrWriter(
 	}
 	return irWriter
 }
+
+// newTestEvents returns numEvents log events with an integer, a dictionary, and
+// a float variable each ("event <i> dict=var<i> <i>.25"), with timestamps step
+// milliseconds apart starting from now.
+func newTestEvents(numEvents int, step int) []ffi.LogEvent {
+	start := ffi.EpochTimeMs(time.Now().UnixMilli())
+	events := make([]ffi.LogEvent, numEvents)
+	for i := range events {
+		events[i] = ffi.LogEvent{
+			LogMessage: ffi.LogMessage(fmt.Sprintf("event %v dict=var%v %v.25", i, i, i)),
+			Timestamp:  start + ffi.EpochTimeMs(i*step),
+		}
+	}
+	return events
+}
+
+// writeTestEvents writes events as an entire IR stream to the file of args. If
+// indexInterval is positive the stream is indexed (see [Writer.EnableIndex])
+// and the Index is returned, otherwise nil is returned.
+func writeTestEvents(
+	t *testing.T,
+	args testArgs,
+	events []ffi.LogEvent,
+	indexInterval int,
+) *Index {
+	ioWriter := openIoWriter(t, args)
+	irWriter := openIrWriter(t, args, ioWriter)
+	if 0 < indexInterval {
+		irWriter.EnableIndex(indexInterval)
+	}
+	for _, event := range events {
+		if _, err := irWriter.Write(event); nil != err {
+			t.Fatalf("ir.Writer.Write failed: %v", err)
+		}
+	}
+	if _, err := irWriter.CloseTo(ioWriter); nil != err {
+		t.Fatalf("ir.Writer.CloseTo failed: %v", err)
+	}
+	ioWriter.Close()
+	return irWriter.Index()
+}
+
+// assertSearchCounters checks the counters of a Reader that has searched every
+// log message in messages, with expected[i] != -1 for each match.
+func assertSearchCounters(
+	t *testing.T,
+	irReader *Reader,
+	messages []ffi.LogMessage,
+	expected []int,
+) {
+	counters, enabled := irReader.Counters()
+	if false == enabled {
+		if (DeserializerCounters{}) != counters {
+			t.Fatalf("Deserializer.Counters disabled but not 0: %+v", counters)
+		}
+		return
+	}
+	numMatches := 0
+	for _, queryIdx := range expected {
+		if -1 != queryIdx {
+			numMatches++
+		}
+	}
+	if uint64(len(messages)) != counters.EventsDeserialized {
+		t.Fatalf(
+			"Deserializer.Counters wrong EventsDeserialized: %v != %v",
+			counters.EventsDeserialized,
+			len(messages),
+		)
+	}
+	if uint64(len(messages)) != counters.MessagesDecoded+counters.EventsRejectedByLogtype {
+		t.Fatalf("Deserializer.Counters every event not decoded or rejected: %+v", counters)
+	}
+	if uint64(numMatches) > counters.MatcherInvocations ||
+		counters.MatcherInvocations > counters.MessagesDecoded {
+		t.Fatalf("Deserializer.Counters wrong MatcherInvocations: %+v", counters)
+	}
+}
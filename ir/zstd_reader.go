@@ -0,0 +1,132 @@
+package ir
+
+/*
+#include <ffi_go/defs.h>
+#include <ffi_go/ir/zstd_decompressor.h>
+*/
+import "C"
+
+import (
+	"errors"
+	"io"
+	"unsafe"
+)
+
+// zstdInputSize is the size of the buffer that compressed data is read into,
+// matching the input size recommended by zstd (ZSTD_DStreamInSize).
+const zstdInputSize int = 128 * 1024
+
+// zstdDecompressor is the [io.Reader] of a [Reader] created by
+// [NewZstdReader]. It reads zstd compressed data from r and decompresses it in
+// C++ directly into the slice passed to Read (the Reader's buffer). cptr holds
+// the underlying zstd decompression stream. srcBuf[srcStart:srcEnd] is the
+// compressed data read from r but not yet decompressed, and srcErr is the
+// error returned by the last read of r. pending is true if the last call to
+// Read filled its slice, in which case the stream may hold decompressed data
+// that has not yet been returned. frameDone is true if the last zstd frame
+// started has been completely decompressed.
+type zstdDecompressor struct {
+	r         io.Reader
+	cptr      unsafe.Pointer
+	srcBuf    []byte
+	srcStart  int
+	srcEnd    int
+	srcErr    error
+	pending   bool
+	frameDone bool
+}
+
+// NewZstdReader returns [NewZstdReaderSize] with a default buffer size of 1MB.
+func NewZstdReader(r io.Reader) (*Reader, error) {
+	return NewZstdReaderSize(r, 1024*1024)
+}
+
+// NewZstdReaderSize creates a new [Reader] for a zstd compressed CLP IR stream
+// read from r (e.g. a .clp.zst file), and reads its preamble like
+// [NewReaderSize]. The stream is decompressed by a native zstd decompression
+// stream straight into the Reader's buffer, which the [Deserializer] then reads
+// in place, rather than being decompressed in Go and then copied into the
+// buffer through an [io.Reader]. size denotes the initial size of the Reader's
+// buffer. If r ends part way through a zstd frame, reading returns
+// [io.ErrUnexpectedEOF]. Close must be called to free the decompression stream.
+// Returns:
+//   - success: valid [*Reader], nil
+//   - error: nil [*Reader], error propagated from [NewReaderSize], or
+//     [DecodeError] if the data read from r is not zstd compressed
+func NewZstdReaderSize(r io.Reader, size int) (*Reader, error) {
+	zd := &zstdDecompressor{
+		r:         r,
+		cptr:      C.ir_zstd_decompressor_new(),
+		srcBuf:    make([]byte, zstdInputSize),
+		frameDone: true,
+	}
+	if nil == zd.cptr {
+		return nil, errors.New("ir: failed to allocate zstd decompression stream")
+	}
+	irr, err := NewReaderSize(zd, size)
+	if nil != err {
+		zd.Close()
+		return nil, err
+	}
+	irr.zstd = zd
+	return irr, nil
+}
+
+// Read decompresses the next data of the zstd stream into p, reading more
+// compressed data from the underlying [io.Reader] as needed. Returns:
+//   - success: number of bytes decompressed into p (at least 1), nil
+//   - error: 0, [io.EOF] at the end of the last zstd frame,
+//     [io.ErrUnexpectedEOF] if the stream ends part way through a frame,
+//     [DecodeError] if the data is not zstd compressed, or error propagated
+//     from [io.Reader.Read]
+func (zd *zstdDecompressor) Read(p []byte) (int, error) {
+	if 0 == len(p) {
+		return 0, nil
+	}
+	for {
+		if zd.srcStart < zd.srcEnd || zd.pending {
+			var srcPos, dstPos C.size_t
+			var frameDone C.bool
+			err := IrError(C.ir_zstd_decompressor_decompress(
+				zd.cptr,
+				newCByteSpan(zd.srcBuf[zd.srcStart:zd.srcEnd]),
+				newCByteSpan(p),
+				&srcPos,
+				&dstPos,
+				&frameDone,
+			))
+			if Success != err {
+				return 0, err
+			}
+			zd.srcStart += int(srcPos)
+			zd.pending = len(p) == int(dstPos)
+			zd.frameDone = bool(frameDone)
+			if 0 < dstPos {
+				return int(dstPos), nil
+			}
+			if zd.srcStart < zd.srcEnd {
+				continue
+			}
+		}
+		if nil != zd.srcErr {
+			if io.EOF == zd.srcErr && !zd.frameDone {
+				return 0, io.ErrUnexpectedEOF
+			}
+			return 0, zd.srcErr
+		}
+		n, err := zd.r.Read(zd.srcBuf)
+		zd.srcStart = 0
+		zd.srcEnd = n
+		zd.srcErr = err
+	}
+}
+
+// Close deletes the underlying zstd decompression stream. Failure to call
+// Close will result in a memory leak.
+func (zd *zstdDecompressor) Close() error {
+	if nil != zd.cptr {
+		C.ir_zstd_decompressor_close(zd.cptr)
+		zd.cptr = nil
+	}
+	return nil
+}
@@ -0,0 +1,137 @@
+package ir
+
+/*
+#include <ffi_go/defs.h>
+#include <ffi_go/ir/zstd_compressor.h>
+*/
+import "C"
+
+import (
+	"errors"
+	"unsafe"
+)
+
+// DefaultZstdFrameSize is a frame size for [Writer.EnableZstd] that keeps
+// frames large enough to compress well while remaining small enough to seek
+// within and decompress in parallel.
+const DefaultZstdFrameSize int = 4 * 1024 * 1024
+
+// ErrZstdEnabledLate is returned by [Writer.EnableZstd] once IR has been
+// written out of the Writer.
+var ErrZstdEnabledLate = errors.New("ir: zstd must be enabled before IR is written out")
+
+// A ZstdFrame describes an independent zstd frame of a stream compressed by a
+// [Writer] (see [Writer.EnableZstd]). Each frame can be decompressed on its own,
+// so a stream can be decompressed in parallel or from the frame containing a
+// [Checkpoint] (whose Offset is in the uncompressed stream).
+type ZstdFrame struct {
+	// Offset and Size are the position and size of the frame's IR in the
+	// uncompressed stream.
+	Offset int64
+	Size   int64
+	// CompressedOffset and CompressedSize are the position and size of the
+	// frame in the compressed stream.
+	CompressedOffset int64
+	CompressedSize   int64
+}
+
+// zstdCompressor holds the underlying C++ compressor of a [Writer] compressing
+// with zstd. frames is only set once the Writer is closed.
+type zstdCompressor struct {
+	cptr   unsafe.Pointer
+	frames []ZstdFrame
+}
+
+// EnableZstd makes the Writer compress the IR stream with zstd in C++, so the
+// Writer's buffer (see [Writer.WriteTo] and [Writer.Bytes]) holds compressed
+// data. Compression happens on a background thread, overlapping with the
+// serialization of subsequent log events. A new, independent zstd frame is
+// started after every frameSize bytes of IR (rounded up to the end of a
+// write), so frames can later be decompressed in parallel and seeked to (see
+// [Writer.ZstdFrames]). If frameSize is not positive, [DefaultZstdFrameSize] is
+// used. Compressed data only becomes available in the Writer's buffer once a
+// frame is complete, and the final frame once the Writer is closed. EnableZstd
+// must be called before any IR is written out of the Writer. Returns:
+//   - success: nil
+//   - error: [ErrZstdEnabledLate]
+func (writer *Writer) EnableZstd(level int, frameSize int) error {
+	writer.takeSerializerBuf()
+	if nil != writer.zstd || int64(writer.buf.Len()) != writer.offset {
+		return ErrZstdEnabledLate
+	}
+	if 0 >= frameSize {
+		frameSize = DefaultZstdFrameSize
+	}
+	writer.zstd = &zstdCompressor{
+		cptr: C.ir_zstd_compressor_new(C.int(level), C.size_t(frameSize)),
+	}
+	// Move the IR already in the buffer (the preamble and any log events) into
+	// the first frame.
+	irView := writer.buf.Bytes()
+	var compressed C.ByteSpan
+	err := IrError(C.ir_zstd_compressor_write(
+		writer.zstd.cptr,
+		newCByteSpan(irView),
+		&compressed,
+	))
+	writer.buf.Reset()
+	if Success != err {
+		return err
+	}
+	writer.buf.Write(unsafe.Slice((*byte)(compressed.m_data), compressed.m_size))
+	return nil
+}
+
+// ZstdFrames returns the frames of the stream compressed by the Writer, or nil
+// if EnableZstd has not been called or the Writer has not been closed.
+func (writer *Writer) ZstdFrames() []ZstdFrame {
+	if nil == writer.zstd {
+		return nil
+	}
+	return writer.zstd.frames
+}
+
+// write passes irView to the compressor, appending any frames it finished
+// compressing to the Writer's buffer. Returns:
+//   - success: len(irView), nil
+//   - error: 0, [IrError] based on the failure of the Cgo call
+func (zc *zstdCompressor) write(writer *Writer, irView BufView) (int, error) {
+	var compressed C.ByteSpan
+	err := IrError(C.ir_zstd_compressor_write(zc.cptr, newCByteSpan(irView), &compressed))
+	if Success != err {
+		return 0, err
+	}
+	writer.buf.Write(unsafe.Slice((*byte)(compressed.m_data), compressed.m_size))
+	return len(irView), nil
+}
+
+// close compresses the remaining IR, appending the last frames to the Writer's
+// buffer, records the frames, and deletes the underlying C++ compressor. It
+// returns an [IrError] based on the failure of the Cgo call.
+func (zc *zstdCompressor) close(writer *Writer) error {
+	if nil == zc.cptr {
+		return nil
+	}
+	var compressed C.ByteSpan
+	err := IrError(C.ir_zstd_compressor_finish(zc.cptr, &compressed))
+	if Success == err {
+		writer.buf.Write(unsafe.Slice((*byte)(compressed.m_data), compressed.m_size))
+		var uncompressedEnds, compressedEnds C.SizetSpan
+		C.ir_zstd_compressor_get_frames(zc.cptr, &uncompressedEnds, &compressedEnds)
+		var frame ZstdFrame
+		for i, end := range unsafe.Slice(uncompressedEnds.m_data, uncompressedEnds.m_size) {
+			compressedEnd := unsafe.Slice(compressedEnds.m_data, compressedEnds.m_size)[i]
+			frame.Size = int64(end) - frame.Offset
+			frame.CompressedSize = int64(compressedEnd) - frame.CompressedOffset
+			zc.frames = append(zc.frames, frame)
+			frame.Offset = int64(end)
+			frame.CompressedOffset = int64(compressedEnd)
+		}
+	}
+	C.ir_zstd_compressor_close(zc.cptr)
+	zc.cptr = nil
+	if Success != err {
+		return err
+	}
+	return nil
+}
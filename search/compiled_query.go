@@ -0,0 +1,91 @@
+package search
+
+/*
+#include <ffi_go/defs.h>
+#include <ffi_go/search/wildcard_query.h>
+*/
+import "C"
+
+import (
+	"unsafe"
+)
+
+// A CompiledQuery holds a set of wildcard queries that have been processed
+// once, up front, into an underlying C++ search::CompiledQuery. It can then be
+// used to match any number of targets (e.g. by
+// [ir.Reader.ReadToCompiledQueryMatch]) without the queries being merged,
+// parsed, or copied on each call. Close must be called to free the underlying
+// memory and failure to do so will result in a memory leak.
+type CompiledQuery struct {
+	cptr       unsafe.Pointer
+	numQueries int
+}
+
+// CompileWildcardQueries compiles queries into a new [CompiledQuery]. Matching
+// with the returned CompiledQuery reports the index of the first matching query
+// in queries.
+func CompileWildcardQueries(queries []WildcardQuery) *CompiledQuery {
+	mergedQuery := MergeWildcardQueries(queries)
+	cptr := C.wildcard_query_compile(C.MergedWildcardQueryView{
+		C.StringView{
+			(*C.char)(unsafe.Pointer(unsafe.StringData(mergedQuery.queries))),
+			C.size_t(len(mergedQuery.queries)),
+		},
+		C.SizetSpan{
+			(*C.size_t)(unsafe.Pointer(unsafe.SliceData(mergedQuery.endOffsets))),
+			C.size_t(len(mergedQuery.endOffsets)),
+		},
+		C.BoolSpan{
+			(*C.bool)(unsafe.Pointer(unsafe.SliceData(mergedQuery.caseSensitivity))),
+			C.size_t(len(mergedQuery.caseSensitivity)),
+		},
+	})
+	return &CompiledQuery{cptr, len(queries)}
+}
+
+// Close will delete the underlying C++ allocated memory used by the
+// CompiledQuery. Failure to call Close will result in a memory leak.
+func (cq *CompiledQuery) Close() error {
+	if nil != cq.cptr {
+		C.wildcard_query_compiled_delete(cq.cptr)
+		cq.cptr = nil
+	}
+	return nil
+}
+
+// Len returns the number of queries compiled into the CompiledQuery (0 for a nil
+// CompiledQuery).
+func (cq *CompiledQuery) Len() int {
+	if nil == cq {
+		return 0
+	}
+	return cq.numQueries
+}
+
+// Match returns the index of the first query matching target and true, or -1
+// and false if no query matches (including if cq is nil or closed).
+func (cq *CompiledQuery) Match(target string) (int, bool) {
+	var match C.size_t
+	if 0 == C.wildcard_query_compiled_match(
+		C.StringView{
+			(*C.char)(unsafe.Pointer(unsafe.StringData(target))),
+			C.size_t(len(target)),
+		},
+		cq.Pointer(),
+		&match,
+	) {
+		return -1, false
+	}
+	return int(match), true
+}
+
+// Pointer returns the address of the underlying C++ search::CompiledQuery, to
+// be passed into the C API of other clp-ffi-go packages (e.g. ir). The address
+// is only valid until Close is called. It is nil if cq is nil or closed, which
+// the C API rejects rather than dereferences.
+func (cq *CompiledQuery) Pointer() unsafe.Pointer {
+	if nil == cq {
+		return nil
+	}
+	return cq.cptr
+}
@@ -0,0 +1,109 @@
+package search
+
+/*
+#include <ffi_go/defs.h>
+#include <ffi_go/search/numeric_query.h>
+#include <ffi_go/search/wildcard_query.h>
+*/
+import "C"
+
+import (
+	"errors"
+	"unsafe"
+)
+
+// A NumericComparison is the comparison made by a [NumericPredicate], with the
+// log event's variable on the left hand side.
+type NumericComparison int8
+
+const (
+	LessThan NumericComparison = iota
+	LessOrEqual
+	Equal
+	NotEqual
+	GreaterOrEqual
+	GreaterThan
+)
+
+// ErrInvalidNumericPredicate is returned by NewNumericQuery if a predicate's
+// comparison is not one of the NumericComparison constants, or its VarIndex is
+// negative.
+var ErrInvalidNumericPredicate = errors.New("search: invalid numeric predicate")
+
+// A NumericPredicate compares a variable of a log event against Value. VarIndex
+// is the index of the variable among all variables of the log message (in
+// order), whether CLP encoded it as an integer, a float, or a dictionary
+// variable.
+type NumericPredicate struct {
+	VarIndex   int
+	Comparison NumericComparison
+	Value      float64
+}
+
+// A NumericQuery combines a wildcard query over the logtype of a log event
+// with [NumericPredicate] comparisons on its variables, held by an underlying
+// C++ search::NumericQuery. The logtype query is matched against the log
+// message with each variable replaced by a single placeholder character, so
+// variables must be matched by '?' or '*' (e.g. "*latency=* ms*"). A log event
+// matches if its logtype matches and every predicate holds. The predicates are
+// evaluated directly on CLP's encoding of integer and float variables (e.g. by
+// [ir.Reader.ReadToNumericQueryMatch]), so only matching log messages are
+// decoded. A predicate only holds for a variable that is a number: dictionary
+// variables are parsed if they are decimal numbers (e.g. "-12.5" but not
+// "1e3"), as CLP stores numbers it cannot encode as dictionary variables. Close
+// must be called to free the underlying memory and failure to do so will result
+// in a memory leak.
+type NumericQuery struct {
+	cptr unsafe.Pointer
+}
+
+// NewNumericQuery creates a new [NumericQuery] from a wildcard query over
+// logtypes and predicates on variables. On error returns:
+//   - nil *NumericQuery
+//   - [ErrInvalidNumericPredicate] error: a predicate is invalid
+func NewNumericQuery(
+	logtypeQuery WildcardQuery,
+	predicates []NumericPredicate,
+) (*NumericQuery, error) {
+	views := make([]C.NumericPredicateView, len(predicates))
+	for i, predicate := range predicates {
+		if LessThan > predicate.Comparison || GreaterThan < predicate.Comparison ||
+			0 > predicate.VarIndex {
+			return nil, ErrInvalidNumericPredicate
+		}
+		views[i] = C.NumericPredicateView{
+			m_var_index:  C.size_t(predicate.VarIndex),
+			m_value:      C.double(predicate.Value),
+			m_comparison: C.int8_t(predicate.Comparison),
+		}
+	}
+	cptr := C.numeric_query_new(
+		C.WildcardQueryView{
+			m_query: C.StringView{
+				(*C.char)(unsafe.Pointer(unsafe.StringData(logtypeQuery.query))),
+				C.size_t(len(logtypeQuery.query)),
+			},
+			m_case_sensitive: C.bool(logtypeQuery.caseSensitive),
+		},
+		C.NumericPredicateSpan{unsafe.SliceData(views), C.size_t(len(views))},
+	)
+	if nil == cptr {
+		return nil, ErrInvalidNumericPredicate
+	}
+	return &NumericQuery{cptr}, nil
+}
+
+// Close will delete the underlying C++ allocated memory used by the
+// NumericQuery. Failure to call Close will result in a memory leak.
+func (nq *NumericQuery) Close() error {
+	if nil != nq.cptr {
+		C.numeric_query_delete(nq.cptr)
+		nq.cptr = nil
+	}
+	return nil
+}
+
+// Pointer returns the address of the underlying C++ search::NumericQuery, to
+// be passed into the C API of other clp-ffi-go packages (e.g. ir). The address
+// is only valid until Close is called.
+func (nq *NumericQuery) Pointer() unsafe.Pointer { return nq.cptr }